@@ -0,0 +1,556 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "tt.hpp"
+
+// conformance and throughput of every kernel_cache backend
+//
+// each backend runs the same checks against an empty cache
+// home, then the same timed operations over kernel_count
+// generated kernels. exits non-zero when a check fails
+//
+
+using kernel_count = std::integral_constant<std::size_t, 2000UL>;
+using compact_records = std::integral_constant<std::size_t, 64UL>;
+
+template<typename Backend>
+std::size_t record_count(Backend & backend) {
+   std::vector<cache_item> items;
+   std::optional<content_hash> cursor;
+   std::size_t count = 0;
+   bool finished = false;
+
+   while(!finished) {
+      items.clear();
+      if(!backend.scan(cursor, 256UL, items, finished) || items.empty()) { break; }
+      count += items.size();
+      cursor = items.back().key;
+   }
+
+   return count;
+}
+
+template<typename Backend>
+bool find_record(Backend & backend, content_hash const& key, cache_record & rec) {
+   std::vector<cache_item> items;
+   std::optional<content_hash> cursor;
+   bool finished = false;
+
+   while(!finished) {
+      items.clear();
+      if(!backend.scan(cursor, 256UL, items, finished) || items.empty()) { break; }
+      for(auto const& item : items) {
+         if(item.key == key) { rec = item.rec; return true; }
+      }
+      cursor = items.back().key;
+   }
+
+   return false;
+}
+
+// statement trees of the kernels main() builds, for get_or_emit
+//
+std::vector< std::vector<statement> > statement_trees(kernel_context<crisc> & ctx, std::size_t const count) {
+   expression_data & a = ctx.instance<scalar<i32>>("a");
+
+   std::vector< std::vector<statement> > trees;
+   trees.reserve(count);
+
+   for(std::size_t i = 0; i < count; ++i) {
+      trees.push_back(std::vector<statement>{
+         kernel_main[{ decl(a), a = static_cast<std::int32_t>(i) }]
+      });
+   }
+
+   return trees;
+}
+
+template<typename F>
+double ops_per_sec(std::size_t const ops, F && f) {
+   const auto start = std::chrono::steady_clock::now();
+   f();
+   const auto end = std::chrono::steady_clock::now();
+
+   return static_cast<double>(ops) / std::chrono::duration<double>(end - start).count();
+}
+
+template<typename Backend>
+bool conformance(char const* name, std::vector< kernel<crisc> > const& kernels) {
+   using cache_type = basic_kernel_cache<Backend>;
+
+   bool ok = true;
+   auto check = [&ok, name](bool const cond, char const* what) {
+      if(!cond) {
+         std::cerr << name << "\tFAIL\t" << what << std::endl;
+         ok = false;
+      }
+   };
+
+   fs::remove_all(cache_type::home);
+
+   const std::size_t n = kernels.size();
+   kernel<crisc> const& k0 = kernels[0];
+   kernel<crisc> const& k1 = kernels[1];
+
+   {
+      cache_type cache;
+      check(cache.open(), "open");
+
+      check(!cache.contains(k0), "contains before put");
+      check(cache.put(k0), "put");
+      check(cache.put(k0), "put of a stored kernel");
+      check(cache.contains(k0), "contains after put");
+      check(record_count(cache.backend) == 1UL, "one record per key");
+
+      const cache_stats counted = cache.stats();
+      check(counted.contains.calls == 2UL && counted.contains.hits == 1UL && counted.contains.misses == 1UL, "contains stats");
+      check(counted.put.hits == 1UL && counted.put.misses == 1UL, "put stats");
+      check(counted.put.bytes_written == k0.kernel_impl_src.size(), "put bytes");
+
+      typename cache_type::entry e;
+      check(cache.get(cache_type::compute_hash(k0), e) && e.source == k0.kernel_impl_src, "get");
+
+      fs::path pth;
+      check(cache.get(k0, pth) && pth == cache_type::object_path(cache_type::compute_hash(k0)), "get path");
+
+      mapped_file src;
+      check(cache.get_view(k0, src) && src.view() == k0.kernel_impl_src, "get_view");
+
+      kernel_context<crisc> ctx{host_location()};
+      const std::vector< std::vector<statement> > trees = statement_trees(ctx, 2UL);
+      check(fingerprint<crisc>(trees[0]) != fingerprint<crisc>(trees[1]), "fingerprint covers literals");
+      check(fingerprint<crisc>(trees[0]) == fingerprint<crisc, sha256>(trees[0]), "fingerprints are sha256 by default");
+
+      kernel<crisc> emitted, found;
+      check(cache.get_or_emit(ctx, trees[0], emitted) && emitted.kernel_impl_src == k0.kernel_impl_src, "get_or_emit miss");
+
+      cache_record fp_rec{};
+      check(find_record(cache.backend, fingerprint<crisc, sha256>(trees[0]), fp_rec) &&
+         std::string_view{fp_rec.core} == cache_type::fingerprint_core && record_count(cache.backend) == 2UL,
+         "get_or_emit records the fingerprint");
+
+      const std::uint64_t get_hits = cache.stats().get.hits;
+      check(cache.get_or_emit(ctx, trees[0], found) && found.kernel_impl_src == k0.kernel_impl_src &&
+         cache.stats().get.hits == get_hits + 1UL, "get_or_emit hit");
+
+      // records already stored keep their accesses
+      //
+      const content_hash h0 = cache_type::compute_hash(k0);
+      check(cache.backend.touch({ cache_access{h0, 5UL, 7UL} }), "touch");
+
+      cache_record before{}, after{};
+      check(find_record(cache.backend, h0, before), "find a stored record");
+
+      check(cache.put_many(kernels), "put_many");
+      check(record_count(cache.backend) == n + 1UL, "put_many records");
+
+      cache_record fresh = before;
+      fresh.hits = 0;
+      check(cache.backend.insert_many({ cache_item{h0, fresh} }), "insert_many of a stored key");
+      check(find_record(cache.backend, h0, after) && after.hits == before.hits && after.atime == before.atime,
+         "insert_many keeps stored records");
+
+      check(cache.manifest().size() == n, "manifest");
+      check(cache.save_manifest("cache_bench"), "save_manifest");
+
+      cache.close();
+   }
+
+   {
+      cache_type cache{4UL * n};
+      check(cache.open(), "open for prefetch");
+
+      std::vector<content_hash> keys;
+      check(cache_type::load_manifest("cache_bench", keys) && keys.size() == n, "load_manifest");
+
+      check(cache.prefetch("cache_bench"), "prefetch");
+      cache.wait_prefetch();
+      check(cache.memory.size() == n, "prefetch fills the memory tier");
+
+      cache.close();
+   }
+
+   {
+      // putting a kernel stored by an earlier run fills the
+      // memory tier, so the next get reads nothing
+      //
+      cache_type cache;
+      check(cache.open(), "reopen for put");
+
+      check(cache.put(k1) && cache.memory.size() == 1UL, "put of a stored kernel fills the memory tier");
+
+      typename cache_type::entry e;
+      check(cache.get(cache_type::compute_hash(k1), e) && e.source == k1.kernel_impl_src &&
+         cache.stats().get.bytes_read == 0UL, "get after put reads nothing");
+
+      std::vector<typename cache_type::entry> entries;
+      check(cache.get_many(std::vector<content_hash>{cache_type::compute_hash(k1), content_hash{}}, entries) == 1UL &&
+         entries[0].source == k1.kernel_impl_src && entries[1].path.empty() && cache.stats().get.bytes_read == 0UL,
+         "get_many answers from the memory tier");
+
+      cache.close();
+   }
+
+   {
+      // a cold memory tier reads every lookup from disk
+      //
+      cache_type cache{0UL};
+      check(cache.open(), "reopen");
+
+      std::vector<content_hash> keys{cache_type::compute_hash(k1), content_hash{}};
+      std::vector<typename cache_type::entry> entries;
+      check(cache.get_many(keys, entries) == 1UL, "get_many found");
+      check(entries[0].source == k1.kernel_impl_src && entries[1].path.empty(), "get_many entries");
+
+      typename cache_type::build_config config;
+      typename cache_type::artifact art, cached;
+      check(cache.get_or_compile(k0, config, art) && art.binary == k0.kernel_impl_src, "get_or_compile");
+      check(cache.get_artifact(cache_type::compute_hash(k0), config, cached) && cached.binary == art.binary, "get_artifact");
+      check(record_count(cache.backend) == n + 2UL, "artifact record");
+
+      cache_io::write_file(cache_type::object_path(cache_type::compute_hash(k1)), "corrupt");
+
+      // a temporary left by a writer that died before its rename
+      // is removed once it is older than stale_temp_age, in every
+      // directory the cache writes to
+      //
+      std::vector<fs::path> stale_tmps;
+      for(auto const& dir : { cache_type::objects, cache_type::artifacts, cache_type::fingerprints, cache_type::manifests }) {
+         const fs::path tmp = dir / fs::path{"00"} / fs::path{std::string{cache_io::temp_prefix} + "stale"};
+
+         std::error_code ec;
+         cache_io::write_file(tmp, "partial", false);
+         fs::last_write_time(tmp, fs::file_time_type::clock::now() -
+            std::chrono::seconds{2L * cache_io::stale_temp_age::value}, ec);
+         stale_tmps.push_back(tmp);
+      }
+
+      fs::path stale_tmp, fresh_tmp;
+      if constexpr(std::is_same<Backend, flat_file_backend>::value) {
+         const fs::path shard = cache.backend.records / fs::path{"00"};
+         stale_tmp = shard / fs::path{std::string{cache_io::temp_prefix} + "stale"};
+         fresh_tmp = shard / fs::path{std::string{cache_io::temp_prefix} + "fresh"};
+
+         std::error_code ec;
+         fs::create_directories(shard, ec);
+         cache_io::write_file(stale_tmp, "partial", false);
+         cache_io::write_file(fresh_tmp, "partial", false);
+         fs::last_write_time(stale_tmp, fs::file_time_type::clock::now() -
+            std::chrono::seconds{2L * Backend::stale_temp_age::value}, ec);
+      }
+
+      check(cache.purge(), "purge");
+
+      bool stale_left = false;
+      for(auto const& tmp : stale_tmps) {
+         stale_left = stale_left || fs::exists(tmp);
+      }
+      check(!stale_left, "purge removes stale temporaries everywhere");
+
+      if constexpr(std::is_same<Backend, flat_file_backend>::value) {
+         check(!fs::exists(stale_tmp) && fs::exists(fresh_tmp), "purge removes only stale temporaries");
+
+         std::error_code ec;
+         fs::remove(fresh_tmp, ec);
+      }
+      check(!cache.contains(k1), "purge removes a corrupt kernel");
+      check(cache.contains(k0), "purge keeps a valid kernel");
+      check(record_count(cache.backend) == n + 1UL, "purge records");
+
+      // a file whose record was lost (its put died between the
+      // rename and the insert) is recorded again by the next put
+      // or purge; an orphan that does not match its key is removed
+      //
+      const content_hash h0 = cache_type::compute_hash(k0);
+      cache_record rec0{};
+      check(cache.backend.erase({ h0 }), "erase a record");
+      cache.memory.erase(h0);
+      check(cache.put(k0) && record_count(cache.backend) == n + 1UL, "put restores a lost record");
+
+      content_hash bogus{};
+      bogus.bytes.fill(0xabU);
+      cache_io::write_file(cache_type::object_path(bogus), "orphan");
+      check(cache.backend.erase({ h0 }), "erase a record again");
+      check(cache.purge() && record_count(cache.backend) == n + 1UL && find_record(cache.backend, h0, rec0) &&
+         !fs::exists(cache_type::object_path(bogus)), "purge records orphans and removes mismatched ones");
+
+      // fingerprints are records too; purge records an orphaned
+      // one whose source is stored and drops, with its file, one
+      // whose source is not
+      //
+      kernel_context<crisc> ctx{host_location()};
+      const content_hash fp0 = fingerprint<crisc, sha256>(statement_trees(ctx, 1UL)[0]);
+      cache_record fp_rec{};
+      check(cache.backend.erase({ fp0 }) && cache.purge() && find_record(cache.backend, fp0, fp_rec),
+         "purge records an orphaned fingerprint");
+
+      const fs::path dangling = cache_type::fingerprint_path(bogus);
+      cache_io::write_file(dangling, bogus.hex(), false);
+      check(cache.backend.insert(bogus, cache_type::make_record(cache_type::fingerprint_core, bogus.hex().size())) &&
+         cache.purge() && !find_record(cache.backend, bogus, fp_rec) && !fs::exists(dangling),
+         "purge drops a fingerprint whose source is not stored");
+
+      cache_io::write_file(dangling, bogus.hex(), false);
+      check(cache.purge() && !fs::exists(dangling) && record_count(cache.backend) == n + 1UL,
+         "purge removes an orphaned fingerprint whose source is not stored");
+
+      typename cache_type::cache_budget budget;
+      budget.max_entries = n / 2UL;
+      cache.set_budget(budget);
+
+      for(std::size_t step = 0; step < 1000UL && budget.max_entries < record_count(cache.backend); ++step) {
+         check(cache.compact_step(compact_records::value), "compact_step");
+         check(cache.compaction.coldest.size() <= compact_records::value &&
+            cache.compaction.evict.size() <= compact_records::value, "compact_step holds at most max_records candidates");
+      }
+
+      check(record_count(cache.backend) <= budget.max_entries, "compaction meets the budget");
+      check(find_record(cache.backend, fp0, fp_rec) || !fs::exists(cache_type::fingerprint_path(fp0)),
+         "eviction removes fingerprint files");
+
+      cache.close();
+   }
+
+   {
+      // kernels are stored oldest first, then the oldest is used
+      // while the pass runs, so the next two oldest are the
+      // victims, coldest first; the last step evicts one
+      //
+      fs::remove_all(cache_type::home);
+
+      cache_type cache;
+      check(cache.open(), "open for eviction order");
+      check(cache.purge(), "purge records left by earlier checks");
+
+      for(auto const& k : kernels) {
+         check(cache.put(k), "put for eviction order");
+      }
+
+      typename cache_type::cache_budget budget;
+      budget.max_entries = n - 2UL;
+      cache.set_budget(budget);
+
+      check(cache.compact_step(1UL), "compact_step starts a pass");
+
+      typename cache_type::entry used;
+      check(cache.get(cache_type::compute_hash(k0), used), "get during the pass");
+
+      for(std::size_t step = 0; step < 1000UL && cache.compaction.evict.empty(); ++step) {
+         check(cache.compact_step(compact_records::value), "compact_step ranks");
+      }
+
+      check(cache.compaction.evict.size() == 2UL && cache.compaction.evict.front() == cache_type::compute_hash(k1),
+         "victims are ranked coldest first");
+
+      check(cache.compact_step(1UL), "compact_step evicts");
+      check(!cache.contains(k1) && cache.contains(kernels[2]) && cache.contains(k0), "evicts the coldest victim first");
+
+      // k0 is in the memory tier; another process evicts it.
+      // memory tier hits make no system call until a read
+      // through the entry fails, put finds the file gone, or
+      // compact_step or purge checks it
+      //
+      const content_hash h0 = cache_type::compute_hash(k0);
+      std::error_code ec;
+      fs::remove(cache_type::object_path(h0), ec);
+
+      fs::path evicted_path;
+      const std::uint64_t fs_ns = cache.stats().filesystem_ns;
+      check(cache.contains(k0) && cache.get(k0, evicted_path) && cache.get(h0, used) &&
+         cache.stats().filesystem_ns == fs_ns, "memory tier hits skip the disk");
+
+      mapped_file evicted;
+      check(!cache.get_view(k0, evicted) && !cache.memory.contains(h0) && !cache.contains(k0),
+         "a failed read drops the memory tier entry");
+      check(cache.put(k0) && fs::exists(cache_type::object_path(h0)), "put restores an entry evicted elsewhere");
+
+      fs::remove(cache_type::object_path(h0), ec);
+      check(cache.put(k0) && fs::exists(cache_type::object_path(h0)), "put rewrites a file evicted elsewhere");
+
+      fs::remove(cache_type::object_path(h0), ec);
+      check(cache.purge() && !cache.memory.contains(h0) && !cache.contains(k0), "purge drops entries evicted elsewhere");
+      check(cache.put(k0) && fs::exists(cache_type::object_path(h0)), "put restores an entry purged");
+
+      fs::remove(cache_type::object_path(h0), ec);
+      for(std::size_t step = 0; step < 1000UL && cache.memory.contains(h0); ++step) {
+         check(cache.compact_step(compact_records::value), "compact_step audits");
+      }
+      check(!cache.contains(k0), "compact_step drops entries evicted elsewhere");
+
+      // braces other than the placeholders reach the shell as written
+      //
+      typename cache_type::build_config braces;
+      braces.command = "cp {src} {out} && test -n \"${HOME}\" && echo | awk '{ exit 0 }'";
+
+      typename cache_type::artifact built;
+      check(cache.get_or_compile(k0, braces, built) && built.binary == k0.kernel_impl_src, "get_or_compile keeps other braces");
+
+      cache.close();
+   }
+
+   std::cout << name << "\tconformance\t" << (ok ? "pass" : "FAIL") << std::endl;
+   return ok;
+}
+
+template<typename Backend>
+void throughput(char const* name, std::vector< kernel<crisc> > const& kernels) {
+   using cache_type = basic_kernel_cache<Backend>;
+
+   const std::size_t n = kernels.size();
+
+   fs::remove_all(cache_type::home);
+
+   {
+      cache_type cache;
+      cache.open();
+
+      const double put = ops_per_sec(n, [&]() {
+         for(auto const& k : kernels) { cache.put(k); }
+      });
+
+      const double contains = ops_per_sec(n, [&]() {
+         for(auto const& k : kernels) { cache.contains(k); }
+      });
+
+      const double compact = ops_per_sec(n, [&]() {
+         cache.compact_step(n);
+         while(cache.compaction.cursor) { cache.compact_step(n); }
+      });
+
+      cache.save_manifest("cache_bench");
+      cache.close();
+
+      std::cout << name << "\tput\t\t" << put << " ops/s" << std::endl;
+      std::cout << name << "\tcontains\t" << contains << " ops/s" << std::endl;
+      std::cout << name << "\tcompact\t\t" << compact << " records/s" << std::endl;
+   }
+
+   {
+      cache_type cache{4UL * n};
+      cache.open();
+
+      const double prefetch = ops_per_sec(n, [&]() {
+         cache.prefetch("cache_bench");
+         cache.wait_prefetch();
+      });
+
+      cache.close();
+
+      std::cout << name << "\tprefetch\t" << prefetch << " ops/s" << std::endl;
+   }
+
+   {
+      cache_type cache{0UL};
+      cache.open();
+
+      const double get = ops_per_sec(n, [&]() {
+         typename cache_type::entry e;
+         for(auto const& k : kernels) { cache.get(cache_type::compute_hash(k), e); }
+      });
+
+      const double get_view = ops_per_sec(n, [&]() {
+         mapped_file src;
+         for(auto const& k : kernels) { cache.get_view(k, src); }
+      });
+
+      const double purge = ops_per_sec(n, [&]() { cache.purge(); });
+
+      const cache_stats s = cache.stats();
+      cache.close();
+
+      std::cout << name << "\tget p50/p99\t" << s.get.percentile_ns(0.5) << "/" << s.get.percentile_ns(0.99) << " ns" << std::endl;
+      std::cout << name << "\tbackend/fs\t" << s.backend_ns << "/" << s.filesystem_ns << " ns" << std::endl;
+
+      std::cout << name << "\tget (cold)\t" << get << " ops/s" << std::endl;
+      std::cout << name << "\tget_view\t" << get_view << " ops/s" << std::endl;
+      std::cout << name << "\tpurge\t\t" << purge << " records/s" << std::endl;
+   }
+
+   {
+      kernel_context<crisc> ctx{host_location()};
+      const std::vector< std::vector<statement> > trees = statement_trees(ctx, n);
+
+      cache_type cache;
+      cache.open();
+
+      const double emit = ops_per_sec(n, [&]() {
+         for(auto const& tree : trees) { kernel<crisc> kern{ctx, tree}; }
+      });
+
+      for(auto const& tree : trees) {
+         kernel<crisc> kern;
+         cache.get_or_emit(ctx, tree, kern);
+      }
+
+      const double get_or_emit = ops_per_sec(n, [&]() {
+         for(auto const& tree : trees) {
+            kernel<crisc> kern;
+            cache.get_or_emit(ctx, tree, kern);
+         }
+      });
+
+      cache.close();
+
+      std::cout << name << "\temit\t\t" << emit << " ops/s" << std::endl;
+      std::cout << name << "\tget_or_emit\t" << get_or_emit << " ops/s" << std::endl;
+   }
+
+   fs::remove_all(cache_type::home);
+
+   {
+      cache_type cache;
+      cache.open();
+
+      const double put_many = ops_per_sec(n, [&]() { cache.put_many(kernels); });
+
+      cache.close();
+
+      std::cout << name << "\tput_many\t" << put_many << " ops/s" << std::endl;
+   }
+
+   fs::remove_all(cache_type::home);
+}
+
+template<typename Backend>
+bool run(char const* name, std::vector< kernel<crisc> > const& kernels) {
+   const bool ok = conformance<Backend>(name, kernels);
+   throughput<Backend>(name, kernels);
+   return ok;
+}
+
+int main() {
+
+   kernel_context<crisc> ctx{host_location()};
+   expression_data & a = ctx.instance<scalar<i32>>("a");
+
+   std::vector< kernel<crisc> > kernels;
+   kernels.reserve(kernel_count::value);
+
+   for(std::size_t i = 0; i < kernel_count::value; ++i) {
+      kernels.emplace_back(ctx, std::initializer_list<statement>{
+         kernel_main[{ decl(a), a = static_cast<std::int32_t>(i) }]
+      });
+   }
+
+   bool ok = run<flat_file_backend>("flat_file", kernels);
+
+#if defined(ENABLE_BERKELEY_DB_SUPPORT)
+   ok = run<berkeleydb_backend>("berkeleydb", kernels) && ok;
+#endif
+
+   return ok ? 0 : 1;
+}
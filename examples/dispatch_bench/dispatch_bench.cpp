@@ -0,0 +1,125 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tt.hpp"
+
+// per-node dispatch cost over every dtype
+//
+// argument_str  - every scalar/array/matrix placeholder
+// return_type   - a function_decl returning every scalar/array/matrix type
+// copy          - expression_data::copy of every scalar/array/matrix variable
+// kernel        - a kernel declaring every variable and taking every placeholder
+//
+
+using iterations = std::integral_constant<std::size_t, 2000UL>;
+
+template<typename F>
+double time_ns(std::size_t const nodes, F && f) {
+   const auto start = std::chrono::steady_clock::now();
+
+   for(std::size_t i = 0; i < iterations::value; ++i) {
+      f();
+   }
+
+   const auto end = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::nano>(end - start).count() /
+      static_cast<double>(iterations::value * nodes);
+}
+
+template<typename... Ts>
+struct dtypes {};
+
+using all_dtypes = dtypes<i8, i16, i32, i64, u8, u16, u32, u64, fp16a, fp16b, fp32, fp64, boolean>;
+
+template<typename... Ts>
+void instance_all(kernel_context<crisc> & ctx, std::vector<expression_data> & vars, dtypes<Ts...>) {
+   (vars.push_back(ctx.instance<scalar<Ts>>(std::string{"s_"} + Ts::value)), ...);
+   (vars.push_back(ctx.instance<array<Ts>>(std::string{"a_"} + Ts::value, 4UL)), ...);
+   (vars.push_back(ctx.instance<matrix<Ts>>(std::string{"m_"} + Ts::value, {4UL, 4UL})), ...);
+}
+
+template<typename... Ts>
+void return_types_all(std::vector<function_decl> & decls, dtypes<Ts...>) {
+   (decls.push_back(function_decl{"f", {}, variable_type{scalar<Ts>{}}}), ...);
+   (decls.push_back(function_decl{"f", {}, variable_type{array<Ts>{}}}), ...);
+   (decls.push_back(function_decl{"f", {}, variable_type{matrix<Ts>{}}}), ...);
+}
+
+int main() {
+
+   kernel_context<crisc> ctx{host_location()};
+
+   std::vector<expression_data> vars;
+   instance_all(ctx, vars, all_dtypes{});
+
+   std::vector<function_decl> decls;
+   return_types_all(decls, all_dtypes{});
+
+   const std::vector<placeholder> plhs{
+      s_i8_1, s_i16_1, s_i32_1, s_i64_1, s_u8_1, s_u16_1, s_u32_1, s_u64_1,
+      s_fp16a_1, s_fp16b_1, s_fp32_1, s_fp64_1, s_bool_1,
+      a_i8_1, a_i16_1, a_i32_1, a_i64_1, a_u8_1, a_u16_1, a_u32_1, a_u64_1,
+      a_fp16a_1, a_fp16b_1, a_fp32_1, a_fp64_1, a_bool_1,
+      m_i8_1, m_i16_1, m_i32_1, m_i64_1, m_u8_1, m_u16_1, m_u32_1, m_u64_1,
+      m_fp16a_1, m_fp16b_1, m_fp32_1, m_fp64_1, m_bool_1
+   };
+
+   std::string src;
+   src.reserve(1UL << 20UL);
+
+   const double argument_ns = time_ns(plhs.size(), [&]() {
+      src.clear();
+      emitter out{src};
+      for(auto const& plh : plhs) {
+         visit(PlaceholderVisitor{out}, plh);
+      }
+   });
+
+   const double return_type_ns = time_ns(decls.size(), [&]() {
+      src.clear();
+      emitter out{src};
+      for(auto const& fdecl : decls) {
+         fdecl.return_type_str(out);
+      }
+   });
+
+   const double copy_ns = time_ns(vars.size(), [&]() {
+      for(auto & var : vars) {
+         expression_data ret;
+         expression_data::copy(ret, var);
+      }
+   });
+
+   function_decl const body_decl{"kernel_main", {}, {}};
+   function_def body{body_decl, {}, {}};
+   body.placeholders.reserve(plhs.size());
+   for(auto const& plh : plhs) {
+      body.placeholders.push_back(plh);
+   }
+   for(auto & var : vars) {
+      body.statements.push_back(decl(var));
+   }
+
+   const double kernel_ns = time_ns(plhs.size() + vars.size(), [&]() {
+      kernel<crisc> k(ctx, { body });
+   });
+
+   std::cout << "argument_str\t" << argument_ns << " ns/node" << std::endl;
+   std::cout << "return_type\t" << return_type_ns << " ns/node" << std::endl;
+   std::cout << "copy\t\t" << copy_ns << " ns/node" << std::endl;
+   std::cout << "kernel\t\t" << kernel_ns << " ns/node" << std::endl;
+
+   return 0;
+}
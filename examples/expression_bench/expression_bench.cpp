@@ -0,0 +1,62 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include "tt.hpp"
+
+// builds the left leaning chain `a + 1 + 2 + ... + n`
+//
+// move: each partial sum is a temporary, operator+ && steals it
+// copy: each partial sum is an lvalue, operator+ & deep copies it
+//
+template<bool Move>
+double build_chain(expression_data & a, const std::int32_t nterms) {
+   const auto start = std::chrono::steady_clock::now();
+
+   // expression_data::operator= builds an assign_op, the
+   // partial sum is rebound through std::optional instead
+   //
+   std::optional<expression_data> expr{a + 0};
+
+   for(std::int32_t i = 1; i < nterms; ++i) {
+      if constexpr(Move) {
+         expr.emplace(std::move(*expr) + i);
+      }
+      else {
+         expr.emplace(*expr + i);
+      }
+   }
+
+   const auto end = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+
+   kernel_context<crisc> ctx{host_location()};
+
+   expression_data a =
+      ctx.instance<scalar<i32>>("a");
+
+   std::cout << "terms\tmove (ms)\tcopy (ms)" << std::endl;
+
+   for(std::int32_t nterms = 1250; nterms <= 10000; nterms *= 2) {
+      const double move_ms = build_chain<true>(a, nterms);
+      const double copy_ms = build_chain<false>(a, nterms);
+
+      std::cout << nterms << '\t' << move_ms << "\t\t" << copy_ms << std::endl;
+   }
+
+   return 0;
+}
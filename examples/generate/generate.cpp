@@ -0,0 +1,176 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tt.hpp"
+
+// generates kernels through generate_all on pools of several
+// sizes and compares each one to the same kernel emitted
+// serially; checks a throwing task is rethrown by run() and
+// leaves the pool usable, and that identifiers interned by
+// the tasks are freed once their contexts are gone. exits
+// non-zero when any check fails
+//
+
+using contexts = std::vector< std::unique_ptr< kernel_context<crisc> > >;
+
+// a loopback kernel whose transfer size and loop bound depend
+// on i, so every kernel's source is distinct
+//
+std::vector<statement> build(kernel_context<crisc> & ctx, const std::int32_t i) {
+   expression_data & l1_buffer_addr = ctx.instance<scalar<i32>>("l1_buffer_addr");
+   expression_data & dram_buffer_src_addr = ctx.instance<scalar<i32>>("dram_buffer_src_addr");
+   expression_data & dram_buffer_src_bank = ctx.instance<scalar<i32>>("dram_buffer_src_bank");
+   expression_data & dram_buffer_src_noc_addr = ctx.instance<scalar<i64>>("dram_buffer_src_noc_addr");
+   expression_data & k = ctx.instance<scalar<i32>>("k");
+
+   return std::vector<statement>{
+      include(cstdint),
+      kernel_main[{
+         decl(l1_buffer_addr) = get_arg_val(0),
+         decl(dram_buffer_src_addr) = get_arg_val(1),
+         decl(dram_buffer_src_bank) = get_arg_val(2),
+         decl(dram_buffer_src_noc_addr) = get_noc_addr_from_bank_id_dram(dram_buffer_src_bank, dram_buffer_src_addr),
+         decl(k),
+         for_(k = 0, k < i + 1, k = k + 1, {
+            noc_async_read(dram_buffer_src_noc_addr, l1_buffer_addr + k * 32, 32 * (i + 1)),
+            noc_async_read_barrier()
+         })
+      }]
+   };
+}
+
+contexts make_contexts(const std::size_t n) {
+   contexts ctxs;
+   for(std::size_t i = 0; i < n; ++i) {
+      ctxs.emplace_back(new kernel_context<crisc>{host_location()});
+   }
+   return ctxs;
+}
+
+std::size_t failures = 0;
+
+void check(char const* name, const bool ok) {
+   std::cout << (ok ? "pass " : "FAIL ") << name << std::endl;
+   failures += ok ? 0 : 1;
+}
+
+bool same_as_serial(const std::size_t n, work_stealing_pool & pool) {
+   contexts serial_ctxs = make_contexts(n);
+   contexts ctxs = make_contexts(n);
+
+   std::vector< kernel_job<crisc> > jobs;
+   for(std::size_t i = 0; i < n; ++i) {
+      jobs.push_back(kernel_job<crisc>{*ctxs[i], build(*ctxs[i], static_cast<std::int32_t>(i))});
+   }
+
+   const std::vector< kernel<crisc> > kernels = generate_all(std::move(jobs), pool);
+   if(kernels.size() != n) { return false; }
+
+   for(std::size_t i = 0; i < n; ++i) {
+      const kernel<crisc> expected{*serial_ctxs[i], build(*serial_ctxs[i], static_cast<std::int32_t>(i))};
+      if(kernels[i].kernel_impl_src != expected.kernel_impl_src ||
+         kernels[i].host_program_location != expected.host_program_location) {
+         std::cout << "kernel " << i << " differs\nexpected:\n" << expected.kernel_impl_src
+            << "actual:\n" << kernels[i].kernel_impl_src << std::endl;
+         return false;
+      }
+   }
+
+   return true;
+}
+
+bool rethrows(work_stealing_pool & pool, const std::size_t n) {
+   std::atomic<std::size_t> ran{0};
+   bool thrown = false;
+
+   try {
+      pool.run(n, [&ran, n](std::size_t const i) {
+         ran.fetch_add(1, std::memory_order_relaxed);
+         if(i == n / 2) { throw std::runtime_error{"task " + std::to_string(i)}; }
+      });
+   }
+   catch(std::runtime_error const& e) {
+      thrown = (std::string{e.what()} == "task " + std::to_string(n / 2));
+   }
+
+   // every task still runs, and the failure is not carried
+   // into the next run
+   //
+   std::atomic<std::size_t> next{0};
+   pool.run(n, [&next](std::size_t const) { next.fetch_add(1, std::memory_order_relaxed); });
+
+   return thrown && ran.load() == n && next.load() == n;
+}
+
+// identifiers declared by contexts on the pool's workers are
+// shared while any context holds them and freed by collect()
+// once every context is gone
+//
+bool reclaims(work_stealing_pool & pool, const std::size_t n) {
+   symbol_pool & symbols = global_symbol_pool();
+   symbols.collect();
+   const std::size_t before = symbols.size();
+
+   {
+      contexts ctxs = make_contexts(n);
+      std::atomic<std::size_t> reused{0};
+      pool.run(n, [&ctxs, &reused](std::size_t const i) {
+         expression_data & shared = ctxs[i]->instance<scalar<i32>>("reclaimed_shared");
+         ctxs[i]->instance<scalar<i32>>("reclaimed_" + std::to_string(i));
+
+         // the context's own table answers an identifier it has seen
+         //
+         const bool same = (&ctxs[i]->instance<scalar<i32>>("reclaimed_shared") == &shared);
+         reused.fetch_add((same && ctxs[i]->symbols.size() == 2UL) ? 1UL : 0UL, std::memory_order_relaxed);
+      });
+
+      if(reused.load() != n || symbols.size() != before + n + 1UL || symbols.collect() != 0UL) { return false; }
+   }
+
+   return symbols.collect() == n + 1UL && symbols.size() == before;
+}
+
+int main() {
+
+   // rounds reuse each pool back to back, so workers still
+   // leaving one run overlap the start of the next
+   //
+   const std::size_t rounds = 25;
+   const std::size_t nkernels = 64;
+
+   for(std::size_t const nworkers : { std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{7} }) {
+      work_stealing_pool pool{nworkers};
+
+      bool identical = true;
+      bool rethrown = true;
+      bool reclaimed = true;
+      for(std::size_t r = 0; r < rounds; ++r) {
+         identical = identical && same_as_serial(nkernels, pool);
+         rethrown = rethrown && rethrows(pool, nkernels);
+         reclaimed = reclaimed && reclaims(pool, nkernels);
+      }
+
+      const std::string workers = std::to_string(nworkers) + " workers";
+      check(("generate_all matches serial, " + workers).c_str(), identical);
+      check(("run rethrows a task's exception, " + workers).c_str(), rethrown);
+      check(("identifiers are freed with their contexts, " + workers).c_str(), reclaimed);
+   }
+
+   check("generate_all on the default pool matches serial", same_as_serial(nkernels, default_pool()));
+
+   std::cout << (failures == 0 ? "all checks passed" : "checks failed") << std::endl;
+   return (failures == 0) ? 0 : 1;
+}
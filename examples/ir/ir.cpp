@@ -0,0 +1,284 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "tt.hpp"
+
+// lowers the test and loopback kernels into an ir_module and
+// checks kernel<T>, emit(ctx, lower(...)) and emit_tree, the
+// statement tree walk, all match the source the original
+// StatementVisitor emitted for the same kernels; then reports
+// the bytes each representation holds and the time to walk
+// each one into source. exits non-zero when a check fails
+//
+// tree bytes are the recursive_wrapper nodes and the top
+// level statements; ir bytes are ir_module::bytes()
+//
+
+using iterations = std::integral_constant<std::size_t, 2000UL>;
+
+// tallies the recursive_wrapper nodes built while installed
+// that are still alive; temporaries destroyed while the tree
+// is built are not counted
+//
+struct counting_resource : public mpark::util::node_resource {
+   std::size_t bytes = 0;
+   std::size_t nodes = 0;
+
+   void* allocate(std::size_t size, std::size_t align) override {
+      bytes += size;
+      ++nodes;
+      return ::operator new(size, std::align_val_t{align});
+   }
+
+   void deallocate(void* p, std::size_t size, std::size_t align) override {
+      bytes -= size;
+      --nodes;
+      ::operator delete(p, std::align_val_t{align});
+   }
+};
+
+// source the original StatementVisitor emitted for test_tree
+//
+std::string const test_source =
+   "    #include<cstdint>\n"
+   "    void kernel_main (  ) {\n"
+   "        std::int32_t a;\n"
+   "        std::int32_t b [10];\n"
+   "        std::int32_t c [10][10];\n"
+   "        a = 0;\n"
+   "        a = b [ 0 ]  + c [ 0 ]  [ 0 ]  - a * 1;\n"
+   "        a = b [ 0 ]  * c [ 0 ]  [ 0 ]  / c [ 0 ]  [ 0 ] ;\n"
+   "        a = ( a + a ) % b [ 0 ] ;\n"
+   "        a = a + ( a + a ) + a;\n"
+   "        // a = get_arg_addr(0)\n"
+   "        for ( a = 0 ; a < 10 ; a = a + 1 ) {\n"
+   "            b [ 0 ]  = b [ 0 ]  + a;\n"
+   "        }\n"
+   "        if ( a == 0 )  {\n"
+   "            a = 0;\n"
+   "        }\n"
+   "        else if ( a == 1 )  {\n"
+   "            a = 1;\n"
+   "        }\n"
+   "        else {\n"
+   "            a = 2;\n"
+   "        }\n"
+   "        while ( a == 0 ) {\n"
+   "            a = a + 1;\n"
+   "        }\n"
+   "        switch ( a ) {\n"
+   "            case 1 :\n"
+   "            {\n"
+   "                a = a + 1;\n"
+   "            }\n"
+   "            break;\n"
+   "            case 2 :\n"
+   "            {\n"
+   "                a = a + 2;\n"
+   "            }\n"
+   "            break;\n"
+   "            default:\n"
+   "            {\n"
+   "                a = a + 3;\n"
+   "            }\n"
+   "            break;\n"
+   "        }\n"
+   "    }\n";
+
+std::vector<statement> test_tree(kernel_context<crisc> & ctx) {
+   expression_data & a = ctx.instance<scalar<i32>>("a");
+   expression_data & b = ctx.instance<array<i32>>("b", 10UL);
+   expression_data & c = ctx.instance<matrix<i32>>("c", {10UL, 10UL});
+
+   return std::vector<statement>{
+      include(cstdint),
+      kernel_main[{
+         decl(a),
+         decl(b),
+         decl(c),
+         a = 0,
+         a = b[0] + c[0][0] - a * 1,
+         a = b[0] * c[0][0] / c[0][0],
+         a = _( a + a ) % b[0],
+         a = a + _( a + a ) + a,
+         comment{"a = get_arg_addr(0)"},
+         for_(a = 0, a < 10, a = a + 1, {
+            b[0] = b[0] + a
+         }),
+         if_(a == 0, {
+            a = 0
+         })
+         .else_if_(a == 1, {
+            a = 1
+         })
+         .else_({
+            a = 2
+         }),
+         while_(a == 0, {
+            a = a + 1
+         }),
+         switch_(a)
+         .case_(1, {
+            a = a + 1
+         })
+         .case_(2, {
+            a = a + 2
+         })
+         .default_({
+            a = a + 3
+         })
+      }]
+   };
+}
+
+// source the original StatementVisitor emitted for loopback_tree
+//
+std::string const loopback_source =
+   "    #include<cstdint>\n"
+   "    // \n"
+   "    void kernel_main (  ) {\n"
+   "        std::int32_t l1_buffer_addr = get_arg_val( 0 );\n"
+   "        std::int32_t dram_buffer_src_addr = get_arg_val( 1 );\n"
+   "        std::int32_t dram_buffer_src_bank = get_arg_val( 2 );\n"
+   "        std::int32_t dram_buffer_dst_addr = get_arg_val( 3 );\n"
+   "        std::int32_t dram_buffer_dst_bank = get_arg_val( 4 );\n"
+   "        std::int32_t dram_buffer_size = get_arg_val( 5 );\n"
+   "        // \n"
+   "        std::int64_t dram_buffer_src_noc_addr = get_noc_addr_from_bank_id<true>( dram_buffer_src_bank, dram_buffer_src_addr );\n"
+   "        // \n"
+   "        noc_async_read( dram_buffer_src_noc_addr, l1_buffer_addr, dram_buffer_size );\n"
+   "        noc_async_read_barrier(  );\n"
+   "        // \n"
+   "        std::int64_t dram_buffer_dst_noc_addr = get_noc_addr_from_bank_id<true>( dram_buffer_dst_bank, dram_buffer_dst_addr );\n"
+   "        // \n"
+   "        noc_async_write( dram_buffer_dst_noc_addr, l1_buffer_addr, dram_buffer_size );\n"
+   "        noc_async_write_barrier(  );\n"
+   "    }\n";
+
+std::vector<statement> loopback_tree(kernel_context<crisc> & ctx) {
+   expression_data & l1_buffer_addr = ctx.instance<scalar<i32>>("l1_buffer_addr");
+   expression_data & dram_buffer_src_addr = ctx.instance<scalar<i32>>("dram_buffer_src_addr");
+   expression_data & dram_buffer_src_bank = ctx.instance<scalar<i32>>("dram_buffer_src_bank");
+   expression_data & dram_buffer_dst_addr = ctx.instance<scalar<i32>>("dram_buffer_dst_addr");
+   expression_data & dram_buffer_dst_bank = ctx.instance<scalar<i32>>("dram_buffer_dst_bank");
+   expression_data & dram_buffer_size = ctx.instance<scalar<i32>>("dram_buffer_size");
+   expression_data & dram_buffer_src_noc_addr = ctx.instance<scalar<i64>>("dram_buffer_src_noc_addr");
+   expression_data & dram_buffer_dst_noc_addr = ctx.instance<scalar<i64>>("dram_buffer_dst_noc_addr");
+
+   comment empty_comment{};
+
+   return std::vector<statement>{
+      include(cstdint),
+      empty_comment,
+      kernel_main[{
+         decl(l1_buffer_addr) = get_arg_val(0),
+         decl(dram_buffer_src_addr) = get_arg_val(1),
+         decl(dram_buffer_src_bank) = get_arg_val(2),
+         decl(dram_buffer_dst_addr) = get_arg_val(3),
+         decl(dram_buffer_dst_bank) = get_arg_val(4),
+         decl(dram_buffer_size) = get_arg_val(5),
+         empty_comment,
+         decl(dram_buffer_src_noc_addr) = get_noc_addr_from_bank_id_dram(dram_buffer_src_bank, dram_buffer_src_addr),
+         empty_comment,
+         noc_async_read(dram_buffer_src_noc_addr, l1_buffer_addr, dram_buffer_size),
+         noc_async_read_barrier(),
+         empty_comment,
+         decl(dram_buffer_dst_noc_addr) = get_noc_addr_from_bank_id_dram(dram_buffer_dst_bank, dram_buffer_dst_addr),
+         empty_comment,
+         noc_async_write(dram_buffer_dst_noc_addr, l1_buffer_addr, dram_buffer_size),
+         noc_async_write_barrier()
+      }]
+   };
+}
+
+template<typename F>
+double time_us(F && f) {
+   const auto start = std::chrono::steady_clock::now();
+
+   for(std::size_t i = 0; i < iterations::value; ++i) {
+      f();
+   }
+
+   const auto end = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::micro>(end - start).count() /
+      static_cast<double>(iterations::value);
+}
+
+std::size_t failures = 0;
+
+void run(char const* name, std::vector<statement> (*build)(kernel_context<crisc> &), std::string const& expected) {
+   kernel_context<crisc> ctx{host_location()};
+
+   counting_resource counted{};
+   mpark::util::node_resource * const previous = mpark::util::current_node_resource();
+   mpark::util::current_node_resource() = &counted;
+   const std::vector<statement> stmts = build(ctx);
+   mpark::util::current_node_resource() = previous;
+
+   const std::size_t tree_nodes = counted.nodes;
+   const std::size_t tree_bytes = counted.bytes + stmts.size() * sizeof(statement);
+
+   const ir_module mod = lower(stmts);
+
+   const kernel<crisc> walked = [&]() {
+      kernel<crisc> k{ctx.host_program_location};
+      {
+         emitter out{k.kernel_impl_src};
+         emit_tree(stmts.data(), stmts.data() + stmts.size(), out);
+      }
+      return k;
+   }();
+
+   const kernel<crisc> lowered = emit(ctx, mod);
+   const kernel<crisc> kern{ctx, stmts};
+
+   for(kernel<crisc> const* k : { &walked, &lowered, &kern }) {
+      if(k->kernel_impl_src != expected || k->host_program_location != ctx.host_program_location) {
+         ++failures;
+         std::cout << "FAIL " << name << "\nexpected:\n" << expected
+            << "actual:\n" << k->kernel_impl_src << std::endl;
+         return;
+      }
+   }
+
+   std::string src;
+   src.reserve(expected.size());
+
+   const double tree_us = time_us([&]() {
+      src.clear();
+      emitter out{src};
+      emit_tree(stmts.data(), stmts.data() + stmts.size(), out);
+   });
+
+   const double ir_us = time_us([&]() {
+      src.clear();
+      emitter out{src};
+      emit(mod, out);
+   });
+
+   std::cout << name << "\tpass\t" << tree_nodes << " nodes\t" << tree_bytes << " bytes\t" << tree_us << " us\t"
+      << mod.nodes.size() << " nodes\t" << mod.bytes() << " bytes\t" << ir_us << " us" << std::endl;
+}
+
+int main() {
+
+   std::cout << "kernel\t\tcheck\ttree\t\t\t\t\tir" << std::endl;
+
+   run("test\t", test_tree, test_source);
+   run("loopback", loopback_tree, loopback_source);
+
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,609 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tt.hpp"
+
+// builds small statement trees, runs one pass over each and
+// compares the emitted source to the expected text; exits
+// non-zero when any check fails
+//
+
+template<typename T, typename V>
+expression_data lit(V v) {
+   return expression_data{expression_type{variable_type{literal<T>{v}}}};
+}
+
+std::string source(std::vector<statement> const& stmts) {
+   std::string src{};
+   {
+      emitter out{src};
+      emit(stmts.data(), stmts.data() + stmts.size(), out);
+   }
+   return src;
+}
+
+std::size_t failures = 0;
+
+void check(char const* name, std::vector<statement> const& stmts, std::string const& expected) {
+   const std::string actual = source(stmts);
+   if(actual == expected) {
+      std::cout << "pass " << name << std::endl;
+      return;
+   }
+
+   ++failures;
+   std::cout << "FAIL " << name << "\nexpected:\n" << expected << "actual:\n" << actual << std::endl;
+}
+
+void check_simplify(kernel_context<crisc> & ctx) {
+   expression_data & x = ctx.instance<scalar<i32>>("x");
+   expression_data & y = ctx.instance<scalar<fp32>>("y");
+   expression_data & b = ctx.instance<array<i32>>("b", 10UL);
+
+   {
+      std::vector<statement> stmts{
+         x = x * 1,
+         x = _( x + 0 ) * 2,
+         x = _( lit<i32>(2) + lit<i32>(3) ) * x,
+         x = b[ _( lit<i32>(1) + lit<i32>(2) ) ],
+         x = _( _( x ) ),
+         y = _( lit<fp32>(0.5f) + lit<fp32>(0.25f) ),
+         x = _( lit<i32>(2) < lit<i32>(3) )
+      };
+      simplify(stmts);
+      check("simplify identities and folds", stmts,
+         "    x = x * 2 ;\n"
+         "    x = 5 * x ;\n"
+         "    x = b [ 3 ] ;\n"
+         "    y = 0.750000f ;\n"
+         "    x = true ;\n"
+      );
+   }
+
+   // the literal is wider than x; dropping it would turn a
+   // float expression into an int one
+   //
+   {
+      std::vector<statement> stmts{
+         y = x * lit<fp32>(1.0f) / 2,
+         y = x + lit<fp32>(0.0f),
+         y = x / lit<fp64>(1.0),
+         y = y * 0
+      };
+      simplify(stmts);
+      check("simplify mixed int and float operands", stmts,
+         "    y = x * 1.000000f / 2 ;\n"
+         "    y = x + 0.000000f ;\n"
+         "    y = x / 1.000000 ;\n"
+         "    y = y * 0 ;\n"
+      );
+   }
+
+   // x is no wider than the literal, the identities apply
+   //
+   {
+      std::vector<statement> stmts{
+         x = y * lit<fp32>(1.0f),
+         y = x * 0,
+         x = x * lit<fp32>(0.0f)
+      };
+      simplify(stmts);
+      check("simplify literal no narrower than operand", stmts,
+         "    x = y ;\n"
+         "    y = 0 ;\n"
+         "    x = 0.000000f ;\n"
+      );
+   }
+
+   // fp32 literals are emitted as floats, so a float operand
+   // keeps its type when an fp32 literal is dropped or folded,
+   // and an int compared with one converts to float
+   //
+   {
+      std::vector<statement> stmts{
+         y = y * lit<fp32>(1.0f) / 3,
+         y = _( lit<fp32>(0.1f) + lit<fp32>(0.2f) ),
+         y = _( lit<fp32>(0.1f) + lit<fp64>(0.2) ),
+         x = _( lit<i32>(16777217) == lit<fp32>(16777216.0f) ),
+         x = _( lit<i32>(16777217) > lit<fp32>(16777216.0f) ),
+         x = _( lit<i32>(16777217) > lit<fp64>(16777216.0) )
+      };
+      simplify(stmts);
+      check("simplify fp32 literals stay float", stmts,
+         "    y = y / 3 ;\n"
+         "    y = 0.300000f ;\n"
+         "    y = 0.100000f + 0.200000 ;\n"
+         "    x = true ;\n"
+         "    x = false ;\n"
+         "    x = true ;\n"
+      );
+   }
+
+   // division by zero and int overflow are left for the
+   // compiler to see
+   //
+   {
+      std::vector<statement> stmts{
+         x = _( lit<i32>(7) / lit<i32>(0) ),
+         x = _( lit<i32>(7) % lit<i32>(0) ),
+         x = _( lit<i32>(2147483647) + lit<i32>(1) )
+      };
+      simplify(stmts);
+      check("simplify leaves division by zero", stmts,
+         "    x = 7 / 0 ;\n"
+         "    x = 7 % 0 ;\n"
+         "    x = 2147483647 + 1 ;\n"
+      );
+   }
+
+   // long operands compute in long; a long result in int range
+   // would be emitted as an int literal, so it is not folded
+   //
+   {
+      std::vector<statement> stmts{
+         x = _( lit<i64>(3000000000) - lit<i64>(2000000000) ) * 3,
+         x = _( lit<i64>(3000000000) + lit<i32>(1) ),
+         x = _( lit<i64>(3000000000) - lit<i32>(1000000000) )
+      };
+      simplify(stmts);
+      check("simplify keeps long results long", stmts,
+         "    x = ( 3000000000 - 2000000000 ) * 3 ;\n"
+         "    x = 3000000001 ;\n"
+         "    x = 3000000000 - 1000000000 ;\n"
+      );
+   }
+}
+
+namespace cb = tt::api::kernel::circular_buffer;
+
+// a helper kernel_main may call any number of times
+//
+static function_decl const read_tiles_decl{"read_tiles", {}, {}};
+static function_def const read_tiles{read_tiles_decl, {}, {}};
+
+void check_coalesce(kernel_context<brisc> & ctx) {
+   expression_data & src = ctx.instance<scalar<u32>>("src_addr");
+   expression_data & dst = ctx.instance<scalar<u32>>("dst_addr");
+   expression_data & tiles = ctx.instance<scalar<u32>>("num_tiles");
+   expression_data & cb_id = ctx.instance<scalar<u32>>("cb_id");
+   expression_data & ublock = ctx.instance<scalar<u32>>("ublock_size_tiles");
+   expression_data & bytes = ctx.instance<scalar<u32>>("ublock_size_bytes");
+   expression_data & i = ctx.instance<scalar<u32>>("i");
+   expression_data & l1 = ctx.instance<scalar<u32>>("l1_write_addr");
+
+   auto const reader = [&](expression_data const& size) {
+      return for_(i = 0, i < tiles, i = i + 1, {
+         cb::cb_reserve_back(cb_id, ublock),
+         l1 = cb::get_write_ptr(cb_id),
+         noc_async_read(src, l1, size),
+         noc_async_read_barrier(),
+         cb::cb_push_back(cb_id, ublock),
+         src = src + size
+      });
+   };
+
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(ublock) = 1,
+            decl(bytes) = cb::get_tile_size(cb_id) * ublock,
+            reader(bytes),
+            for_(i = 0, i < tiles, i = i + 1, {
+               cb::cb_wait_front(cb_id, 1),
+               noc_async_write(cb::get_read_ptr(cb_id), dst, cb::get_tile_size(cb_id)),
+               noc_async_write_barrier(),
+               cb::cb_pop_front(cb_id, 1),
+               dst = dst + 1
+            })
+         }]
+      };
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers tile sized blocks", stmts,
+         "    void kernel_main (  ) {\n"
+         "        std::uint32_t ublock_size_tiles = 1;\n"
+         "        std::uint32_t ublock_size_bytes = get_tile_size( cb_id ) * ublock_size_tiles;\n"
+         "        std::uint32_t noc_batch0 = 0;\n"
+         "        for ( i = 0 ; i < num_tiles ; i = i + 1 ) {\n"
+         "            cb_reserve_back( cb_id, ( noc_batch0 + 1 ) * ublock_size_tiles );\n"
+         "            l1_write_addr = get_write_ptr( cb_id );\n"
+         "            noc_async_read( src_addr, ( l1_write_addr + noc_batch0 * ublock_size_bytes ), ublock_size_bytes );\n"
+         "            noc_batch0 = noc_batch0 + 1;\n"
+         "            if ( noc_batch0 == 4 )  {\n"
+         "                noc_async_read_barrier(  );\n"
+         "                cb_push_back( cb_id, ublock_size_tiles * 4 );\n"
+         "                noc_batch0 = 0;\n"
+         "            };\n"
+         "            src_addr = src_addr + ublock_size_bytes;\n"
+         "        }\n"
+         "        if ( noc_batch0 > 0 )  {\n"
+         "            noc_async_read_barrier(  );\n"
+         "            cb_push_back( cb_id, ublock_size_tiles * noc_batch0 );\n"
+         "        }\n"
+         "        std::uint32_t noc_batch1 = 0;\n"
+         "        for ( i = 0 ; i < num_tiles ; i = i + 1 ) {\n"
+         "            cb_wait_front( cb_id, ( noc_batch1 + 1 ) * 1 );\n"
+         "            noc_async_write( ( get_read_ptr( cb_id ) + noc_batch1 * get_tile_size( cb_id ) ), dst_addr, get_tile_size( cb_id ) );\n"
+         "            noc_batch1 = noc_batch1 + 1;\n"
+         "            if ( noc_batch1 == 4 )  {\n"
+         "                noc_async_write_barrier(  );\n"
+         "                cb_pop_front( cb_id, 1 * 4 );\n"
+         "                noc_batch1 = 0;\n"
+         "            };\n"
+         "            dst_addr = dst_addr + 1;\n"
+         "        }\n"
+         "        if ( noc_batch1 > 0 )  {\n"
+         "            noc_async_write_barrier(  );\n"
+         "            cb_pop_front( cb_id, 1 * noc_batch1 );\n"
+         "        }\n"
+         "    }\n"
+      );
+   }
+
+   // the issue's size is not the n pages reserved
+   //
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(ublock) = 1,
+            decl(bytes) = 2048,
+            reader(bytes),
+            reader(cb::get_tile_size(cb_id) * 2)
+         }]
+      };
+      const std::string expected = source(stmts);
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers bytes not derived from the tile size", stmts, expected);
+   }
+
+   // the body writes the size
+   //
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(ublock) = 1,
+            decl(bytes) = cb::get_tile_size(cb_id) * ublock,
+            for_(i = 0, i < tiles, i = i + 1, {
+               cb::cb_reserve_back(cb_id, ublock),
+               l1 = cb::get_write_ptr(cb_id),
+               noc_async_read(src, l1, bytes),
+               noc_async_read_barrier(),
+               cb::cb_push_back(cb_id, ublock),
+               bytes = bytes + 1
+            })
+         }]
+      };
+      const std::string expected = source(stmts);
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers body writes bytes", stmts, expected);
+   }
+
+   // a loop nested in a loop runs again from wherever the last
+   // partial batch left the pointer
+   //
+   {
+      expression_data & j = ctx.instance<scalar<u32>>("j");
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(ublock) = 1,
+            decl(bytes) = cb::get_tile_size(cb_id) * ublock,
+            for_(j = 0, j < 3, j = j + 1, {
+               reader(bytes)
+            })
+         }]
+      };
+      const std::string expected = source(stmts);
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers nested loop", stmts, expected);
+   }
+
+   // an earlier push moved the write pointer
+   //
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(ublock) = 1,
+            decl(bytes) = cb::get_tile_size(cb_id) * ublock,
+            cb::cb_reserve_back(cb_id, ublock),
+            cb::cb_push_back(cb_id, ublock),
+            reader(bytes)
+         }]
+      };
+      const std::string expected = source(stmts);
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers write pointer moved", stmts, expected);
+   }
+
+   // a helper's pointer is wherever its last call left it
+   //
+   {
+      std::vector<statement> stmts{
+         read_tiles[{
+            decl(ublock) = 1,
+            decl(bytes) = cb::get_tile_size(cb_id) * ublock,
+            reader(bytes)
+         }]
+      };
+      const std::string expected = source(stmts);
+      coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+      check("coalesce_barriers helper function", stmts, expected);
+   }
+}
+
+// pipeline_loops only rewrites the body of kernel_main
+//
+void check_pipeline(kernel_context<brisc> & ctx) {
+   expression_data & src = ctx.instance<scalar<u32>>("src_addr");
+   expression_data & tiles = ctx.instance<scalar<u32>>("num_tiles");
+   expression_data & cb_id = ctx.instance<scalar<u32>>("cb_id");
+   expression_data & bytes = ctx.instance<scalar<u32>>("tile_bytes");
+   expression_data & i = ctx.instance<scalar<u32>>("i");
+   expression_data & l1 = ctx.instance<scalar<u32>>("l1_write_addr");
+
+   auto const reader = [&](expression_data const& size) {
+      return for_(i = 0, i < tiles, i = i + 1, {
+         cb::cb_reserve_back(cb_id, 1),
+         l1 = cb::get_write_ptr(cb_id),
+         noc_async_read(src, l1, size),
+         noc_async_read_barrier(),
+         cb::cb_push_back(cb_id, 1),
+         src = src + size
+      });
+   };
+
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(bytes) = cb::get_tile_size(cb_id),
+            reader(bytes)
+         }]
+      };
+      pipeline_loops(ctx, stmts, 4UL);
+      check("pipeline_loops tile sized blocks", stmts,
+         "    void kernel_main (  ) {\n"
+         "        std::uint32_t tile_bytes = get_tile_size( cb_id );\n"
+         "        std::uint32_t cb_base0 = get_write_ptr( cb_id );\n"
+         "        std::uint32_t cb_slot0 = 0;\n"
+         "        i = 0;\n"
+         "        if ( i < num_tiles )  {\n"
+         "            cb_reserve_back( cb_id, 1 );\n"
+         "            l1_write_addr = get_write_ptr( cb_id );\n"
+         "            noc_async_read( src_addr, l1_write_addr, tile_bytes );\n"
+         "            src_addr = src_addr + tile_bytes;\n"
+         "            i = i + 1;\n"
+         "            while ( i < num_tiles ) {\n"
+         "                cb_slot0 = cb_slot0 + 1;\n"
+         "                if ( cb_slot0 == 4 )  {\n"
+         "                    cb_slot0 = 0;\n"
+         "                };\n"
+         "                cb_reserve_back( cb_id, 1 * 2 );\n"
+         "                noc_async_read_barrier(  );\n"
+         "                l1_write_addr = cb_base0 + cb_slot0 * tile_bytes;\n"
+         "                noc_async_read( src_addr, l1_write_addr, tile_bytes );\n"
+         "                cb_push_back( cb_id, 1 );\n"
+         "                src_addr = src_addr + tile_bytes;\n"
+         "                i = i + 1;\n"
+         "            };\n"
+         "            noc_async_read_barrier(  );\n"
+         "            cb_push_back( cb_id, 1 );\n"
+         "        }\n"
+         "    }\n"
+      );
+   }
+
+   // the issue's size is not the page reserved
+   //
+   {
+      std::vector<statement> stmts{
+         kernel_main[{
+            decl(bytes) = 2048,
+            reader(bytes)
+         }]
+      };
+      const std::string expected = source(stmts);
+      pipeline_loops(ctx, stmts, 4UL);
+      check("pipeline_loops bytes not derived from the tile size", stmts, expected);
+   }
+
+   // a helper may be called from a loop, with the pointer
+   // anywhere
+   //
+   {
+      std::vector<statement> stmts{
+         read_tiles[{
+            decl(bytes) = cb::get_tile_size(cb_id),
+            reader(bytes)
+         }]
+      };
+      const std::string expected = source(stmts);
+      pipeline_loops(ctx, stmts, 4UL);
+      check("pipeline_loops helper function", stmts, expected);
+   }
+}
+
+// hoist_inits only rewrites loops, nested loops first
+//
+void check_hoist(kernel_context<crisc> & ctx) {
+   expression_data & a = ctx.instance<scalar<u32>>("a");
+   expression_data & k = ctx.instance<scalar<u32>>("k");
+   expression_data & c = ctx.instance<scalar<u32>>("c");
+
+   {
+      std::vector<statement> stmts{
+         for_(k = 0, k < 4, k = k + 1, {
+            for_(a = 0, a < 8, a = a + 1, {
+               exp_tile_init(),
+               exp_tile(a),
+               exp_tile_init(),
+               exp_tile(a)
+            })
+         }),
+         exp_tile_init(),
+         exp_tile_init(),
+         while_(a < 8, {
+            add_tiles_init(k, c, false),
+            add_tiles(a, c, 0, 0, 0),
+            a = a + 1
+         }),
+         for_(a = 0, a < 8, a = a + 1, {
+            exp_tile_init(),
+            exp_tile(a),
+            isfinite_tile(a)
+         })
+      };
+      hoist_inits(stmts);
+      check("hoist_inits invariant inits", stmts,
+         "    exp_tile_init(  ) ;\n"
+         "    for ( k = 0 ; k < 4 ; k = k + 1 ) {\n"
+         "        for ( a = 0 ; a < 8 ; a = a + 1 ) {\n"
+         "            exp_tile( a );\n"
+         "            exp_tile( a );\n"
+         "        };\n"
+         "    }\n"
+         "    while ( a < 8 ) {\n"
+         "        add_tiles_init( k, c, false );\n"
+         "        add_tiles( a, c, 0, 0, 0 );\n"
+         "        a = a + 1;\n"
+         "    }\n"
+         "    exp_tile_init(  ) ;\n"
+         "    for ( a = 0 ; a < 8 ; a = a + 1 ) {\n"
+         "        exp_tile( a );\n"
+         "        isfinite_tile( a );\n"
+         "    }\n"
+      );
+   }
+
+   // the init reads the loop index, a second init follows a
+   // different one, a call comes before the init, or the
+   // loop may run zero times
+   //
+   {
+      std::vector<statement> stmts{
+         for_(a = 0, a < 8, a = a + 1, {
+            add_tiles_init(a, c, false),
+            add_tiles(a, c, 0, 0, 0)
+         }),
+         for_(a = 0, a < 8, a = a + 1, {
+            exp_tile_init(),
+            exp_tile(a),
+            copy_tile_init(),
+            copy_tile(a, 0, 0)
+         }),
+         for_(a = 0, a < 8, a = a + 1, {
+            copy_tile(a, 0, 0),
+            exp_tile_init(),
+            exp_tile(a)
+         }),
+         for_(a = 0, a < k, a = a + 1, {
+            exp_tile_init(),
+            exp_tile(a)
+         }),
+         for_(a = 8, a < 8, a = a + 1, {
+            exp_tile_init(),
+            exp_tile(a)
+         })
+      };
+      const std::string expected = source(stmts);
+      hoist_inits(stmts);
+      check("hoist_inits variant or ordered inits", stmts, expected);
+   }
+
+   // a repeated init whose argument was written in between
+   // configures a different circular buffer
+   //
+   {
+      std::vector<statement> stmts{
+         c = 0,
+         copy_tile_to_dst_init_short(c, 0),
+         copy_tile(c, 0, 0),
+         c = 1,
+         copy_tile_to_dst_init_short(c, 0),
+         copy_tile(c, 0, 0)
+      };
+      const std::string expected = source(stmts);
+      hoist_inits(stmts);
+      check("hoist_inits repeat after its argument is written", stmts, expected);
+   }
+}
+
+void check_unroll(kernel_context<crisc> & ctx) {
+   expression_data & i = ctx.instance<scalar<u32>>("i");
+   expression_data & j = ctx.instance<scalar<i32>>("j");
+   expression_data & a = ctx.instance<scalar<i32>>("a");
+   expression_data & n = ctx.instance<scalar<u32>>("n");
+   expression_data & s = ctx.instance<scalar<u8>>("s");
+
+   {
+      std::vector<statement> stmts{
+         for_(i = 0, i < 4, i = i + 1, { exp_tile(i) }).unroll_full(),
+         for_(i = 0, i < 10, i = i + 1, { exp_tile(i), a = a + i }).unroll(4),
+         for_(decl(j) = 10, j > 0, j = j - 3, { a = a + j * 2 }).unroll(2)
+      };
+      unroll_loops(stmts);
+      check("unroll_loops literal headers", stmts,
+         "    exp_tile( 0 ) ;\n"
+         "    exp_tile( 1 ) ;\n"
+         "    exp_tile( 2 ) ;\n"
+         "    exp_tile( 3 ) ;\n"
+         "    i = 4 ;\n"
+         "    for ( i = 0 ; i < 8 ; i = i + 4 ) {\n"
+         "        exp_tile( i );\n"
+         "        a = a + i;\n"
+         "        exp_tile( ( i + 1 ) );\n"
+         "        a = a + ( i + 1 );\n"
+         "        exp_tile( ( i + 2 ) );\n"
+         "        a = a + ( i + 2 );\n"
+         "        exp_tile( ( i + 3 ) );\n"
+         "        a = a + ( i + 3 );\n"
+         "    }\n"
+         "    for ( i = 8 ; i < 10 ; i = i + 1 ) {\n"
+         "        exp_tile( i );\n"
+         "        a = a + i;\n"
+         "    }\n"
+         "    for ( std::int32_t j = 10 ; j > -2 ; j = j - 6 ) {\n"
+         "        a = a + j * 2;\n"
+         "        a = a + ( j - 3 ) * 2;\n"
+         "    }\n"
+      );
+   }
+
+   // a runtime bound, a body that writes i, more than
+   // max_unrolled_trips iterations, an exit value below the
+   // range of u32, and a bound outside the range of u8
+   //
+   {
+      std::vector<statement> stmts{
+         for_(i = 0, i < n, i = i + 1, { exp_tile(i) }).unroll(4),
+         for_(i = 0, i < 8, i = i + 1, { i = i + 1 }).unroll(4),
+         for_(i = 0, i < 65, i = i + 1, { exp_tile(i) }).unroll_full(),
+         for_(i = 0, i < 1000, i = i + 1, { exp_tile(i) }).unroll(1000),
+         for_(i = 3, i >= 0, i = i - 1, { exp_tile(i) }).unroll(4),
+         for_(s = 250, s < 300, s = s + 1, { exp_tile(s) }).unroll(4)
+      };
+      const std::string expected = source(stmts);
+      unroll_loops(stmts);
+      check("unroll_loops loops left alone", stmts, expected);
+   }
+}
+
+int main() {
+   kernel_context<crisc> ctx{host_location()};
+   kernel_context<brisc> movement{host_location()};
+
+   check_simplify(ctx);
+   check_coalesce(movement);
+   check_pipeline(movement);
+   check_hoist(ctx);
+   check_unroll(ctx);
+
+   return failures == 0 ? 0 : 1;
+}
@@ -16,1238 +16,1256 @@ using namespace tt::dsl;
 
 namespace tt { namespace api { namespace kernel {
 
-static inline function_decl DPRINT_decl =
+static inline function_decl const DPRINT_decl =
    function_decl{"DPRINT", std::vector<variable_type>{}};
 
-static inline function_call DPRINT =
+static inline function_call const DPRINT =
    function_call{DPRINT_decl, {}};
 
 namespace kernel_argument {
 
-static inline function_decl get_arg_addr_decl =
+static inline function_decl const get_arg_addr_decl =
    function_decl{"get_arg_addr", std::vector<variable_type>{scalar<i32>{}} };
 
-static inline function_call get_arg_addr =
+static inline function_call const get_arg_addr =
    function_call{get_arg_addr_decl, {}};
 
-static inline function_decl get_arg_val_decl =
+static inline function_decl const get_arg_val_decl =
    function_decl{"get_arg_val", std::vector<variable_type>{scalar<i32>{}} };
 
-static inline function_call get_arg_val =
+static inline function_call const get_arg_val =
    function_call{get_arg_val_decl, {}};
 
-static inline function_decl get_common_arg_addr_decl =
+static inline function_decl const get_common_arg_addr_decl =
    function_decl{"get_common_arg_addr", std::vector<variable_type>{scalar<i32>{}} };
 
-static inline function_call get_common_arg_addr =
+static inline function_call const get_common_arg_addr =
    function_call{get_common_arg_addr_decl, {}};
 
-static inline function_decl get_common_arg_val_decl =
+static inline function_decl const get_common_arg_val_decl =
    function_decl{"get_common_arg_val", std::vector<variable_type>{scalar<i32>{}} };
 
-static inline function_call get_common_arg_val =
+static inline function_call const get_common_arg_val =
    function_call{get_common_arg_val_decl, {}};
 
-static inline function_decl get_compile_time_arg_val_decl =
+static inline function_decl const get_compile_time_arg_val_decl =
    function_decl{"get_compile_time_arg_val", std::vector<variable_type>{scalar<i32>{}} };
 
-static inline function_call get_compile_time_arg_val =
+static inline function_call const get_compile_time_arg_val =
    function_call{get_compile_time_arg_val_decl, {}};
 
 } /* namespace kernel_argument */
 
 namespace circular_buffer {
 
-static inline function_decl cb_pages_reservable_at_back_decl =
+static inline function_decl const cb_pages_reservable_at_back_decl =
    function_decl{"cb_pages_reservable_at_back", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_pages_reservable_at_back =
+static inline function_call const cb_pages_reservable_at_back =
    function_call{cb_pages_reservable_at_back_decl, {}};
 
-static inline function_decl cb_pages_available_at_front_decl =
+static inline function_decl const cb_pages_available_at_front_decl =
    function_decl{"cb_pages_available_at_front", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_pages_available_at_front =
+static inline function_call const cb_pages_available_at_front =
    function_call{cb_pages_available_at_front_decl, {}};
 
-static inline function_decl cb_pop_front_decl =
+static inline function_decl const cb_pop_front_decl =
    function_decl{"cb_pop_front", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_pop_front =
+static inline function_call const cb_pop_front =
    function_call{cb_pop_front_decl, {}};
 
-static inline function_decl cb_push_back_decl =
+static inline function_decl const cb_push_back_decl =
    function_decl{"cb_push_back", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_push_back =
+static inline function_call const cb_push_back =
    function_call{cb_push_back_decl, {}};
 
-static inline function_decl cb_reserve_back_decl =
+static inline function_decl const cb_reserve_back_decl =
    function_decl{"cb_reserve_back", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_reserve_back =
+static inline function_call const cb_reserve_back =
    function_call{cb_reserve_back_decl, {}};
 
-static inline function_decl cb_wait_front_decl =
+static inline function_decl const cb_wait_front_decl =
    function_decl{"cb_wait_front", std::vector<variable_type>{scalar<i32>{}, scalar<i32>{}} };
 
-static inline function_call cb_wait_front =
+static inline function_call const cb_wait_front =
    function_call{cb_wait_front_decl, {}};
 
+static inline function_decl const get_write_ptr_decl =
+   function_decl{"get_write_ptr", std::vector<variable_type>{scalar<u32>{}} };
+
+static inline function_call const get_write_ptr =
+   function_call{get_write_ptr_decl, {}};
+
+static inline function_decl const get_read_ptr_decl =
+   function_decl{"get_read_ptr", std::vector<variable_type>{scalar<u32>{}} };
+
+static inline function_call const get_read_ptr =
+   function_call{get_read_ptr_decl, {}};
+
+static inline function_decl const get_tile_size_decl =
+   function_decl{"get_tile_size", std::vector<variable_type>{scalar<u32>{}} };
+
+static inline function_call const get_tile_size =
+   function_call{get_tile_size_decl, {}};
+
 } /* namespace circular buffer */
 
 namespace data_movement {
 
-static inline scalar<u32> NOC0{"NOC0"};
-static inline scalar<u32> NOC1{"NOC1"};
-static inline scalar<u32> RD_CMD_BUF{"RD_CMD_BUF"};
-static inline scalar<u32> WR_CMD_BUF{"WR_CMD_BUF"};
-static inline scalar<u32> WR_REG_CMD_BUF{"WR_REG_CMD_BUF"};
-static inline scalar<u32> AT_CMD_BUF{"AT_CMD_BUF"};
-static inline scalar<u32> VC1{"VC1"};
-static inline scalar<u32> VC2{"VC2"};
-static inline scalar<u32> VC3{"VC3"};
-static inline scalar<u32> VC4{"VC4"};
-static inline scalar<u32> VC5{"VC5"};
-static inline scalar<u32> VC6{"VC6"};
-
-static inline function_decl noc_semaphore_inc_decl =
+static inline scalar<u32> const NOC0{"NOC0"};
+static inline scalar<u32> const NOC1{"NOC1"};
+static inline scalar<u32> const RD_CMD_BUF{"RD_CMD_BUF"};
+static inline scalar<u32> const WR_CMD_BUF{"WR_CMD_BUF"};
+static inline scalar<u32> const WR_REG_CMD_BUF{"WR_REG_CMD_BUF"};
+static inline scalar<u32> const AT_CMD_BUF{"AT_CMD_BUF"};
+static inline scalar<u32> const VC1{"VC1"};
+static inline scalar<u32> const VC2{"VC2"};
+static inline scalar<u32> const VC3{"VC3"};
+static inline scalar<u32> const VC4{"VC4"};
+static inline scalar<u32> const VC5{"VC5"};
+static inline scalar<u32> const VC6{"VC6"};
+
+static inline function_decl const noc_semaphore_inc_decl =
    function_decl{"noc_semaphore_inc", std::vector<variable_type>{scalar<u64>{}, scalar<u32>{}, scalar<u8>{}} };
 
-static inline function_call noc_semaphore_inc =
+static inline function_call const noc_semaphore_inc =
    function_call{noc_semaphore_inc_decl, {}};
 
-static inline function_decl noc_semaphore_wait_decl =
+static inline function_decl const noc_semaphore_wait_decl =
    function_decl{"noc_semaphore_wait", std::vector<variable_type>{pointer<scalar<u32>>{}, scalar<u32>{}} };
 
-static inline function_call noc_semaphore_wait =
+static inline function_call const noc_semaphore_wait =
    function_call{noc_semaphore_wait_decl, {}};
 
-static inline function_decl noc_semaphore_set_decl =
+static inline function_decl const noc_semaphore_set_decl =
    function_decl{"noc_semaphore_set", std::vector<variable_type>{pointer<scalar<u32>>{}, scalar<u32>{}} };
 
-static inline function_call noc_semaphore_set =
+static inline function_call const noc_semaphore_set =
    function_call{noc_semaphore_set_decl, {}};
 
-static inline function_decl noc_semaphore_set_multicast_decl =
+static inline function_decl const noc_semaphore_set_multicast_decl =
    function_decl{"noc_semaphore_set_multicast", std::vector<variable_type>{scalar<u32>{}, scalar<u64>{}, scalar<u32>{}, scalar<boolean>{}, scalar<boolean>{}, scalar<u8>{}} };
 
-static inline function_call noc_semaphore_set_multicast =
+static inline function_call const noc_semaphore_set_multicast =
    function_call{noc_semaphore_set_multicast_decl, {}};
 
-static inline function_decl noc_async_write_multicast_decl =
+static inline function_decl const noc_async_write_multicast_decl =
    function_decl{"noc_async_write_multicast", std::vector<variable_type>{scalar<u32>{}, scalar<u64>{}, scalar<u32>{}, scalar<u32>{}, scalar<boolean>{}, scalar<boolean>{}, scalar<u8>{}} };
 
-static inline function_call noc_async_write_multicast =
+static inline function_call const noc_async_write_multicast =
    function_call{noc_async_write_multicast_decl, {}};
 
-static inline function_decl noc_async_write_barrier_decl =
+static inline function_decl const noc_async_write_barrier_decl =
    function_decl{"noc_async_write_barrier", std::vector<variable_type>{scalar<u8>{}} };
 
-static inline function_call noc_async_write_barrier =
+static inline function_call const noc_async_write_barrier =
    function_call{noc_async_write_barrier_decl, {}};
 
-static inline function_decl noc_async_read_barrier_decl =
+static inline function_decl const noc_async_read_barrier_decl =
    function_decl{"noc_async_read_barrier", std::vector<variable_type>{scalar<u8>{}} };
 
-static inline function_call noc_async_read_barrier =
+static inline function_call const noc_async_read_barrier =
    function_call{noc_async_read_barrier_decl, {}};
 
-static inline function_decl noc_async_write_decl =
+static inline function_decl const noc_async_write_decl =
    function_decl{"noc_async_write", std::vector<variable_type>{scalar<u32>{}, scalar<u64>{}, scalar<u32>{}, scalar<u8>{}} };
 
-static inline function_call noc_async_write =
+static inline function_call const noc_async_write =
    function_call{noc_async_write_decl, {}};
 
-static inline function_decl noc_async_read_decl =
+static inline function_decl const noc_async_read_decl =
    function_decl{"noc_async_read", std::vector<variable_type>{scalar<u64>{}, scalar<u32>{}, scalar<u32>{}, scalar<u8>{}} };
 
-static inline function_call noc_async_read =
+static inline function_call const noc_async_read =
    function_call{noc_async_read_decl, {}};
 
 } /* namespace data movement */
 
 namespace dataflow {
 
-static inline function_decl get_noc_addr_from_bank_id_decl =
+static inline function_decl const get_noc_addr_from_bank_id_decl =
    function_decl{"get_noc_addr_from_bank_id<false>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u8>{}} };
 
-static inline function_call get_noc_addr_from_bank_id =
+static inline function_call const get_noc_addr_from_bank_id =
    function_call{get_noc_addr_from_bank_id_decl, {}};
 
-static inline function_decl get_noc_addr_from_bank_id_dram_decl =
+static inline function_decl const get_noc_addr_from_bank_id_dram_decl =
    function_decl{"get_noc_addr_from_bank_id<true>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u8>{}} };
 
-static inline function_call get_noc_addr_from_bank_id_dram =
+static inline function_call const get_noc_addr_from_bank_id_dram =
    function_call{get_noc_addr_from_bank_id_dram_decl, {}};
 
 } /* namespace dataflow */
 
 namespace compute {
 
-static inline function_decl copy_tile_decl =
+static inline function_decl const copy_tile_decl =
    function_decl{"copy_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}} };
 
-static inline function_call copy_tile =
+static inline function_call const copy_tile =
    function_call{copy_tile_decl, {}};
 
-static inline function_decl copy_tile_to_dst_init_short_with_dt_decl =
+static inline function_decl const copy_tile_to_dst_init_short_with_dt_decl =
    function_decl{"copy_tile_to_dst_init_short_with_dt", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}} };
 
-static inline function_call copy_tile_to_dst_init_short_with_dt =
+static inline function_call const copy_tile_to_dst_init_short_with_dt =
    function_call{copy_tile_to_dst_init_short_with_dt_decl, {}};
 
-static inline function_decl copy_tile_to_dst_init_short_decl =
+static inline function_decl const copy_tile_to_dst_init_short_decl =
    function_decl{"copy_tile_to_dst_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}} };
 
-static inline function_call copy_tile_to_dst_init_short =
+static inline function_call const copy_tile_to_dst_init_short =
    function_call{copy_tile_to_dst_init_short_decl, {}};
 
-static inline function_decl copy_tile_init_decl =
+static inline function_decl const copy_tile_init_decl =
    function_decl{"copy_tile_init", std::vector<variable_type>{} };
 
-static inline function_call copy_tile_init =
+static inline function_call const copy_tile_init =
    function_call{copy_tile_init_decl, {}};
 
-static inline function_decl acquire_dst_decl =
+static inline function_decl const acquire_dst_decl =
    function_decl{"acquire_dst", std::vector<variable_type>{} };
 
-static inline function_call acquire_dst =
+static inline function_call const acquire_dst =
    function_call{acquire_dst_decl, {}};
 
-static inline function_decl release_dst_decl =
+static inline function_decl const release_dst_decl =
    function_decl{"release_dst", std::vector<variable_type>{} };
 
-static inline function_call release_dst =
+static inline function_call const release_dst =
    function_call{release_dst_decl, {}};
 
-static inline function_decl tile_regs_acquire_decl =
+static inline function_decl const tile_regs_acquire_decl =
    function_decl{"tile_regs_acquire", std::vector<variable_type>{}};
 
-static inline function_call tile_regs_acquire =
+static inline function_call const tile_regs_acquire =
    function_call{tile_regs_acquire_decl, {}};
 
-static inline function_decl tile_regs_wait_decl =
+static inline function_decl const tile_regs_wait_decl =
    function_decl{"tile_regs_wait", std::vector<variable_type>{}};
 
-static inline function_call tile_regs_wait =
+static inline function_call const tile_regs_wait =
    function_call{tile_regs_wait_decl, {}};
 
-static inline function_decl tile_regs_commit_decl =
+static inline function_decl const tile_regs_commit_decl =
    function_decl{"tile_regs_commit", std::vector<variable_type>{}};
 
-static inline function_call tile_regs_commit =
+static inline function_call const tile_regs_commit =
    function_call{tile_regs_commit_decl, {}};
 
-static inline function_decl tile_regs_release_decl =
+static inline function_decl const tile_regs_release_decl =
    function_decl{"tile_regs_release", std::vector<variable_type>{}};
 
-static inline function_call tile_regs_release =
+static inline function_call const tile_regs_release =
    function_call{tile_regs_release_decl, {}};
 
-static inline function_decl abs_tile_decl =
+static inline function_decl const abs_tile_decl =
    function_decl{"abs_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call abs_tile =
+static inline function_call const abs_tile =
    function_call{abs_tile_decl, {}};
 
-static inline function_decl add_tiles_init_nof_decl =
+static inline function_decl const add_tiles_init_nof_decl =
    function_decl{"add_tiles_init_nof", std::vector<variable_type>{}};
 
-static inline function_call add_tiles_init_nof =
+static inline function_call const add_tiles_init_nof =
    function_call{add_tiles_init_nof_decl, {}};
 
-static inline function_decl add_tiles_init_decl =
+static inline function_decl const add_tiles_init_decl =
    function_decl{"add_tiles_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<boolean>{}}};
 
-static inline function_call add_tiles_init =
+static inline function_call const add_tiles_init =
    function_call{add_tiles_init_decl, {}};
 
-static inline function_decl add_tiles_decl =
+static inline function_decl const add_tiles_decl =
    function_decl{"add_tiles", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call add_tiles =
+static inline function_call const add_tiles =
    function_call{add_tiles_decl, {}};
 
-static inline function_decl sub_tiles_init_nof_decl =
+static inline function_decl const sub_tiles_init_nof_decl =
    function_decl{"sub_tiles_init_nof", std::vector<variable_type>{}};
 
-static inline function_call sub_tiles_init_nof =
+static inline function_call const sub_tiles_init_nof =
    function_call{sub_tiles_init_nof_decl, {}};
 
-static inline function_decl sub_tiles_init_decl =
+static inline function_decl const sub_tiles_init_decl =
    function_decl{"sub_tiles_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<boolean>{}}};
 
-static inline function_call sub_tiles_init =
+static inline function_call const sub_tiles_init =
    function_call{sub_tiles_init_decl, {}};
 
-static inline function_decl sub_tiles_decl =
+static inline function_decl const sub_tiles_decl =
    function_decl{"sub_tiles", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call sub_tiles =
+static inline function_call const sub_tiles =
    function_call{sub_tiles_decl, {}};
 
-static inline function_decl mul_tiles_init_f_decl =
+static inline function_decl const mul_tiles_init_f_decl =
    function_decl{"mul_tiles_init_f", std::vector<variable_type>{}};
 
-static inline function_call mul_tiles_init_f =
+static inline function_call const mul_tiles_init_f =
    function_call{mul_tiles_init_f_decl, {}};
 
-static inline function_decl mul_tiles_init_decl =
+static inline function_decl const mul_tiles_init_decl =
    function_decl{"mul_tiles_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_tiles_init =
+static inline function_call const mul_tiles_init =
    function_call{mul_tiles_init_decl, {}};
 
-static inline function_decl mul_tiles_decl =
+static inline function_decl const mul_tiles_decl =
    function_decl{"mul_tiles", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_tiles =
+static inline function_call const mul_tiles =
    function_call{mul_tiles_decl, {}};
 
-static inline function_decl add_bcast_cols_init_short_decl =
+static inline function_decl const add_bcast_cols_init_short_decl =
    function_decl{"add_bcast_cols_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call add_bcast_cols_init_short =
+static inline function_call const add_bcast_cols_init_short =
    function_call{add_bcast_cols_init_short_decl, {}};
 
-static inline function_decl add_bcast_rows_init_short_decl =
+static inline function_decl const add_bcast_rows_init_short_decl =
    function_decl{"add_bcast_rows_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call add_bcast_rows_init_short =
+static inline function_call const add_bcast_rows_init_short =
    function_call{add_bcast_rows_init_short_decl, {}};
 
 // last argument is tBcastDim
 //
-static inline scalar<u32> BroadCastType_Col{"BroadcastType::COL"};
-static inline scalar<u32> BroadCastType_Row{"BroadcastType::ROW"};
+static inline scalar<u32> const BroadCastType_Col{"BroadcastType::COL"};
+static inline scalar<u32> const BroadCastType_Row{"BroadcastType::ROW"};
 
-static inline function_decl add_tiles_bcast_r_decl =
+static inline function_decl const add_tiles_bcast_r_decl =
    function_decl{"add_tiles_bcast<BroadcastType::ROW>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call add_tiles_bcast_r =
+static inline function_call const add_tiles_bcast_r =
    function_call{add_tiles_bcast_r_decl, {}};
 
-static inline function_decl add_tiles_bcast_c_decl =
+static inline function_decl const add_tiles_bcast_c_decl =
    function_decl{"add_tiles_bcast<BroadcastType::COL>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call add_tiles_bcast_c =
+static inline function_call const add_tiles_bcast_c =
    function_call{add_tiles_bcast_c_decl, {}};
 
-static inline function_decl sub_bcast_cols_init_short_decl =
+static inline function_decl const sub_bcast_cols_init_short_decl =
    function_decl{"sub_bcast_colss_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call sub_bcast_cols_init_short =
+static inline function_call const sub_bcast_cols_init_short =
    function_call{sub_bcast_cols_init_short_decl, {}};
 
-static inline function_decl sub_bcast_rows_init_short_decl =
+static inline function_decl const sub_bcast_rows_init_short_decl =
    function_decl{"sub_bcast_rows_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call sub_bcast_rows_init_short =
+static inline function_call const sub_bcast_rows_init_short =
    function_call{sub_bcast_rows_init_short_decl, {}};
 
-static inline function_decl sub_tiles_bcast_r_decl =
+static inline function_decl const sub_tiles_bcast_r_decl =
    function_decl{"sub_tiles_bcast<BroadcastType::ROW>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call sub_tiles_bcast_r =
+static inline function_call const sub_tiles_bcast_r =
    function_call{sub_tiles_bcast_r_decl, {}};
 
-static inline function_decl sub_tiles_bcast_c_decl =
+static inline function_decl const sub_tiles_bcast_c_decl =
    function_decl{"sub_tiles_bcast<BroadcastType::COL>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call sub_tiles_bcast_c =
+static inline function_call const sub_tiles_bcast_c =
    function_call{sub_tiles_bcast_c_decl, {}};
 
-static inline function_decl mul_bcast_cols_init_short_decl =
+static inline function_decl const mul_bcast_cols_init_short_decl =
    function_decl{"mul_bcast_cols_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_bcast_cols_init_short =
+static inline function_call const mul_bcast_cols_init_short =
    function_call{mul_bcast_cols_init_short_decl, {}};
 
-static inline function_decl mul_bcast_rows_init_short_decl =
+static inline function_decl const mul_bcast_rows_init_short_decl =
    function_decl{"mul_bcast_rows_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_bcast_rows_init_short =
+static inline function_call const mul_bcast_rows_init_short =
    function_call{mul_bcast_rows_init_short_decl, {}};
 
-static inline function_decl mul_tiles_bcast_r_decl =
+static inline function_decl const mul_tiles_bcast_r_decl =
    function_decl{"mul_tiles_bcast<BroadcastType::ROW>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_tiles_bcast_r =
+static inline function_call const mul_tiles_bcast_r =
    function_call{mul_tiles_bcast_r_decl, {}};
 
-static inline function_decl mul_tiles_bcast_c_decl =
+static inline function_decl const mul_tiles_bcast_c_decl =
    function_decl{"mul_tiles_bcast<BroadcastType::COL>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_tiles_bcast_c =
+static inline function_call const mul_tiles_bcast_c =
    function_call{mul_tiles_bcast_c_decl, {}};
 
-static inline function_decl mul_tiles_bcast_scalar_init_short_decl =
+static inline function_decl const mul_tiles_bcast_scalar_init_short_decl =
    function_decl{"mul_tiles_bcast_scalar_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mul_tiles_bcast_scalar =
+static inline function_call const mul_tiles_bcast_scalar =
    function_call{mul_tiles_bcast_scalar_init_short_decl, {}};
 
-static inline function_decl mm_init_decl =
+static inline function_decl const mm_init_decl =
    function_decl{"mm_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_init =
+static inline function_call const mm_init =
    function_call{mm_init_decl, {}};
 
-static inline function_decl mm_init_short_with_dt_decl =
+static inline function_decl const mm_init_short_with_dt_decl =
    function_decl{"mm_init_short_with_dt", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_init_short_with_dt =
+static inline function_call const mm_init_short_with_dt =
    function_call{mm_init_short_with_dt_decl, {}};
 
-static inline function_decl mm_init_short_decl =
+static inline function_decl const mm_init_short_decl =
    function_decl{"mm_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_init_short =
+static inline function_call const mm_init_short =
    function_call{mm_init_short_decl, {}};
 
-static inline function_decl matmul_tiles_decl =
+static inline function_decl const matmul_tiles_decl =
    function_decl{"matmul_tiles", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call matmul_tiles =
+static inline function_call const matmul_tiles =
    function_call{matmul_tiles_decl, {}};
 
-static inline function_decl mm_block_init_decl =
+static inline function_decl const mm_block_init_decl =
    function_decl{"mm_block_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_block_init =
+static inline function_call const mm_block_init =
    function_call{mm_block_init_decl, {}};
 
-static inline function_decl mm_block_init_short_decl =
+static inline function_decl const mm_block_init_short_decl =
    function_decl{"mm_block_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_block_init_short =
+static inline function_call const mm_block_init_short =
    function_call{mm_block_init_short_decl, {}};
 
-static inline function_decl mm_block_init_short_dt_decl =
+static inline function_decl const mm_block_init_short_dt_decl =
    function_decl{"mm_block_init_short_dt", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call mm_block_init_short_dt =
+static inline function_call const mm_block_init_short_dt =
    function_call{mm_block_init_short_dt_decl, {}};
 
-static inline function_decl matmul_block_decl =
+static inline function_decl const matmul_block_decl =
    function_decl{"matmul_block", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call matmul_block =
+static inline function_call const matmul_block =
    function_call{matmul_block_decl, {}};
 
-static inline function_decl exp_tile_init_decl =
+static inline function_decl const exp_tile_init_decl =
    function_decl{"exp_tile_init", std::vector<variable_type>{}};
 
-static inline function_call exp_tile_init =
+static inline function_call const exp_tile_init =
    function_call{exp_tile_init_decl, {}};
 
-static inline function_decl exp_tile_decl =
+static inline function_decl const exp_tile_decl =
    function_decl{"exp_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call exp_tile =
+static inline function_call const exp_tile =
    function_call{exp_tile_decl, {}};
 
-static inline function_decl exp_tile_fast_approx_init_decl =
+static inline function_decl const exp_tile_fast_approx_init_decl =
    function_decl{"exp_tile_init<true>", std::vector<variable_type>{}};
 
-static inline function_call exp_tile_fast_approx_init =
+static inline function_call const exp_tile_fast_approx_init =
    function_call{exp_tile_fast_approx_init_decl, {}};
 
-static inline function_decl exp_tile_fast_approx_decl =
+static inline function_decl const exp_tile_fast_approx_decl =
    function_decl{"exp_tile<true>", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call exp_tile_fast_approx =
+static inline function_call const exp_tile_fast_approx =
    function_call{exp_tile_fast_approx_decl, {}};
 
-static inline function_decl exp2_tile_init_decl =
+static inline function_decl const exp2_tile_init_decl =
    function_decl{"exp2_tile_init", std::vector<variable_type>{}};
 
-static inline function_call exp2_tile_init =
+static inline function_call const exp2_tile_init =
    function_call{exp2_tile_init_decl, {}};
 
-static inline function_decl exp2_tile_decl =
+static inline function_decl const exp2_tile_decl =
    function_decl{"exp2_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call exp2_tile =
+static inline function_call const exp2_tile =
    function_call{exp2_tile_decl, {}};
 
-static inline function_decl expm1_tile_init_decl =
+static inline function_decl const expm1_tile_init_decl =
    function_decl{"expm1_tile_init", std::vector<variable_type>{}};
 
-static inline function_call expm1_tile_init =
+static inline function_call const expm1_tile_init =
    function_call{expm1_tile_init_decl, {}};
 
-static inline function_decl expm1_tile_decl =
+static inline function_decl const expm1_tile_decl =
    function_decl{"expm1_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call expm1_tile =
+static inline function_call const expm1_tile =
    function_call{expm1_tile_decl, {}};
 
-static inline function_decl relu_tile_init_decl =
+static inline function_decl const relu_tile_init_decl =
    function_decl{"relu_tile_init", std::vector<variable_type>{}};
 
-static inline function_call relu_tile_init =
+static inline function_call const relu_tile_init =
    function_call{relu_tile_init_decl, {}};
 
-static inline function_decl relu_tile_decl =
+static inline function_decl const relu_tile_decl =
    function_decl{"relu_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call relu_tile =
+static inline function_call const relu_tile =
    function_call{relu_tile_decl, {}};
 
-static inline function_decl relu_max_tile_init_decl =
+static inline function_decl const relu_max_tile_init_decl =
    function_decl{"relu_max_tile_init", std::vector<variable_type>{}};
 
-static inline function_call relu_max_tile_init =
+static inline function_call const relu_max_tile_init =
    function_call{relu_max_tile_init_decl, {}};
 
-static inline function_decl relu_max_tile_decl =
+static inline function_decl const relu_max_tile_decl =
    function_decl{"relu_max_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call relu_max_tile =
+static inline function_call const relu_max_tile =
    function_call{relu_max_tile_decl, {}};
 
-static inline function_decl relu_min_tile_init_decl =
+static inline function_decl const relu_min_tile_init_decl =
    function_decl{"relu_min_tile_init", std::vector<variable_type>{}};
 
-static inline function_call relu_min_tile_init =
+static inline function_call const relu_min_tile_init =
    function_call{relu_min_tile_init_decl, {}};
 
-static inline function_decl relu_min_tile_decl =
+static inline function_decl const relu_min_tile_decl =
    function_decl{"relu_min_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call relu_min_tile =
+static inline function_call const relu_min_tile =
    function_call{relu_min_tile_decl, {}};
 
-static inline function_decl leaky_relu_tile_init_decl =
+static inline function_decl const leaky_relu_tile_init_decl =
    function_decl{"leaky_relu_tile_init", std::vector<variable_type>{}};
 
-static inline function_call leaky_relu_tile_init =
+static inline function_call const leaky_relu_tile_init =
    function_call{leaky_relu_tile_init_decl, {}};
 
-static inline function_decl leaky_relu_tile_decl =
+static inline function_decl const leaky_relu_tile_decl =
    function_decl{"leaky_relu_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call leaky_relu_tile =
+static inline function_call const leaky_relu_tile =
    function_call{leaky_relu_tile_decl, {}};
 
-static inline function_decl elu_tile_init_decl =
+static inline function_decl const elu_tile_init_decl =
    function_decl{"elu_tile_init", std::vector<variable_type>{}};
 
-static inline function_call elu_tile_init =
+static inline function_call const elu_tile_init =
    function_call{elu_tile_init_decl, {}};
 
-static inline function_decl elu_tile_decl =
+static inline function_decl const elu_tile_decl =
    function_decl{"elu_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call elu_tile =
+static inline function_call const elu_tile =
    function_call{elu_tile_decl, {}};
 
-static inline function_decl erf_tile_init_decl =
+static inline function_decl const erf_tile_init_decl =
    function_decl{"erf_tile_init<false>", std::vector<variable_type>{}};
 
-static inline function_call erf_tile_init =
+static inline function_call const erf_tile_init =
    function_call{erf_tile_init_decl, {}};
 
-static inline function_decl erf_tile_decl =
+static inline function_decl const erf_tile_decl =
    function_decl{"erf_tile<false>", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call erf_tile =
+static inline function_call const erf_tile =
    function_call{erf_tile_decl, {}};
 
-static inline function_decl erf_tile_fast_approx_init_decl =
+static inline function_decl const erf_tile_fast_approx_init_decl =
    function_decl{"erf_tile_init", std::vector<variable_type>{}};
 
-static inline function_call erf_tile_fast_approx_init =
+static inline function_call const erf_tile_fast_approx_init =
    function_call{erf_tile_fast_approx_init_decl, {}};
 
-static inline function_decl erf_tile_fast_approx_decl =
+static inline function_decl const erf_tile_fast_approx_decl =
    function_decl{"erf_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call erf_tile_fast_approx =
+static inline function_call const erf_tile_fast_approx =
    function_call{erf_tile_fast_approx_decl, {}};
 
-static inline function_decl erfc_tile_init_decl =
+static inline function_decl const erfc_tile_init_decl =
    function_decl{"erfc_tile_init<false>", std::vector<variable_type>{}};
 
-static inline function_call erfc_tile_init =
+static inline function_call const erfc_tile_init =
    function_call{erfc_tile_init_decl, {}};
 
-static inline function_decl erfc_tile_decl =
+static inline function_decl const erfc_tile_decl =
    function_decl{"erfc_tile<false>", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call erfc_tile =
+static inline function_call const erfc_tile =
    function_call{erfc_tile_decl, {}};
 
-static inline function_decl erfc_tile_fast_approx_init_decl =
+static inline function_decl const erfc_tile_fast_approx_init_decl =
    function_decl{"erfc_tile_init", std::vector<variable_type>{}};
 
-static inline function_call erfc_tile_fast_approx_init =
+static inline function_call const erfc_tile_fast_approx_init =
    function_call{erfc_tile_fast_approx_init_decl, {}};
 
-static inline function_decl erfc_tile_fast_approx_decl =
+static inline function_decl const erfc_tile_fast_approx_decl =
    function_decl{"erfc_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call erfc_tile_fast_approx =
+static inline function_call const erfc_tile_fast_approx =
    function_call{erfc_tile_fast_approx_decl, {}};
 
-static inline function_decl erfinv_tile_init_decl =
+static inline function_decl const erfinv_tile_init_decl =
    function_decl{"erfinv_tile_init", std::vector<variable_type>{}};
 
-static inline function_call erfinv_tile_init =
+static inline function_call const erfinv_tile_init =
    function_call{erfinv_tile_init_decl, {}};
 
-static inline function_decl erfinv_tile_decl =
+static inline function_decl const erfinv_tile_decl =
    function_decl{"erfinv_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call erfinv_tile =
+static inline function_call const erfinv_tile =
    function_call{erfinv_tile_decl, {}};
 
-static inline function_decl gelu_tile_init_decl =
+static inline function_decl const gelu_tile_init_decl =
    function_decl{"gelu_tile_init<false>", std::vector<variable_type>{}};
 
-static inline function_call gelu_tile_init =
+static inline function_call const gelu_tile_init =
    function_call{gelu_tile_init_decl, {}};
 
-static inline function_decl gelu_tile_decl =
+static inline function_decl const gelu_tile_decl =
    function_decl{"gelu_tile<false>", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call gelu_tile =
+static inline function_call const gelu_tile =
    function_call{gelu_tile_decl, {}};
 
-static inline function_decl gelu_tile_fast_approx_init_decl =
+static inline function_decl const gelu_tile_fast_approx_init_decl =
    function_decl{"gelu_tile_init", std::vector<variable_type>{}};
 
-static inline function_call gelu_tile_fast_approx_init =
+static inline function_call const gelu_tile_fast_approx_init =
    function_call{gelu_tile_fast_approx_init_decl, {}};
 
-static inline function_decl gelu_tile_fast_approx_decl =
+static inline function_decl const gelu_tile_fast_approx_decl =
    function_decl{"gelu_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call gelu_tile_fast_approx =
+static inline function_call const gelu_tile_fast_approx =
    function_call{gelu_tile_fast_approx_decl, {}};
 
-static inline function_decl heaviside_tile_init_decl =
+static inline function_decl const heaviside_tile_init_decl =
    function_decl{"heaviside_tile_init", std::vector<variable_type>{}};
 
-static inline function_call heaviside_tile_init =
+static inline function_call const heaviside_tile_init =
    function_call{heaviside_tile_init_decl, {}};
 
-static inline function_decl heaviside_tile_decl =
+static inline function_decl const heaviside_tile_decl =
    function_decl{"heaviside_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call heaviside_tile =
+static inline function_call const heaviside_tile =
    function_call{heaviside_tile_decl, {}};
 
-static inline function_decl isinf_tile_init_decl =
+static inline function_decl const isinf_tile_init_decl =
    function_decl{"isinf_tile_init", std::vector<variable_type>{}};
 
-static inline function_call isinf_tile_init =
+static inline function_call const isinf_tile_init =
    function_call{isinf_tile_init_decl, {}};
 
-static inline function_decl isinf_tile_decl =
+static inline function_decl const isinf_tile_decl =
    function_decl{"isinf_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call isinf_tile =
+static inline function_call const isinf_tile =
    function_call{isinf_tile_decl, {}};
 
-static inline function_decl isposinf_tile_init_decl =
+static inline function_decl const isposinf_tile_init_decl =
    function_decl{"isposinf_tile_init", std::vector<variable_type>{}};
 
-static inline function_call isposinf_tile_init =
+static inline function_call const isposinf_tile_init =
    function_call{isposinf_tile_init_decl, {}};
 
-static inline function_decl isposinf_tile_decl =
+static inline function_decl const isposinf_tile_decl =
    function_decl{"isposinf_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call isposinf_tile =
+static inline function_call const isposinf_tile =
    function_call{isposinf_tile_decl, {}};
 
-static inline function_decl isneginf_tile_init_decl =
+static inline function_decl const isneginf_tile_init_decl =
    function_decl{"isneginf_tile_init", std::vector<variable_type>{}};
 
-static inline function_call isneginf_tile_init =
+static inline function_call const isneginf_tile_init =
    function_call{isneginf_tile_init_decl, {}};
 
-static inline function_decl isneginf_tile_decl =
+static inline function_decl const isneginf_tile_decl =
    function_decl{"isneginf_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call isneginf_tile =
+static inline function_call const isneginf_tile =
    function_call{isneginf_tile_decl, {}};
 
-static inline function_decl isfinite_tile_init_decl =
+static inline function_decl const isfinite_tile_init_decl =
    function_decl{"isfinite_tile_init", std::vector<variable_type>{}};
 
-static inline function_call isfinite_tile_init =
+static inline function_call const isfinite_tile_init =
    function_call{isfinite_tile_init_decl, {}};
 
-static inline function_decl isfinite_tile_decl =
+static inline function_decl const isfinite_tile_decl =
    function_decl{"isfinite_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call isfinite_tile =
+static inline function_call const isfinite_tile =
    function_call{isfinite_tile_decl, {}};
 
-static inline function_decl isnan_tile_decl =
+static inline function_decl const isnan_tile_decl =
    function_decl{"isnan_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call isnan_tile =
+static inline function_call const isnan_tile =
    function_call{isnan_tile_decl, {}};
 
-static inline function_decl i0_tile_init_decl =
+static inline function_decl const i0_tile_init_decl =
    function_decl{"i0_tile_init", std::vector<variable_type>{}};
 
-static inline function_call i0_tile_init =
+static inline function_call const i0_tile_init =
    function_call{i0_tile_init_decl, {}};
 
-static inline function_decl i0_tile_decl =
+static inline function_decl const i0_tile_decl =
    function_decl{"i0_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call i0_tile =
+static inline function_call const i0_tile =
    function_call{i0_tile_decl, {}};
 
-static inline function_decl logical_not_unary_tile_init_decl =
+static inline function_decl const logical_not_unary_tile_init_decl =
    function_decl{"logical_not_unary_tile_init", std::vector<variable_type>{}};
 
-static inline function_call logical_not_unary_tile_init =
+static inline function_call const logical_not_unary_tile_init =
    function_call{logical_not_unary_tile_init_decl, {}};
 
-static inline function_decl logical_not_unary_tile_decl =
+static inline function_decl const logical_not_unary_tile_decl =
    function_decl{"logical_not_unary_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call logical_not_unary_tile =
+static inline function_call const logical_not_unary_tile =
    function_call{logical_not_unary_tile_decl, {}};
 
-static inline function_decl recip_tile_init_decl =
+static inline function_decl const recip_tile_init_decl =
    function_decl{"recip_tile_init", std::vector<variable_type>{}};
 
-static inline function_call recip_tile_init =
+static inline function_call const recip_tile_init =
    function_call{recip_tile_init_decl, {}};
 
-static inline function_decl recip_tile_decl =
+static inline function_decl const recip_tile_decl =
    function_decl{"recip_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call recip_tile =
+static inline function_call const recip_tile =
    function_call{recip_tile_decl, {}};
 
-static inline function_decl sign_tile_init_decl =
+static inline function_decl const sign_tile_init_decl =
    function_decl{"sign_tile_init", std::vector<variable_type>{}};
 
-static inline function_call sign_tile_init =
+static inline function_call const sign_tile_init =
    function_call{sign_tile_init_decl, {}};
 
-static inline function_decl sign_tile_decl =
+static inline function_decl const sign_tile_decl =
    function_decl{"sign_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call sign_tile =
+static inline function_call const sign_tile =
    function_call{sign_tile_decl, {}};
 
-static inline function_decl sqrt_tile_init_decl =
+static inline function_decl const sqrt_tile_init_decl =
    function_decl{"sqrt_tile_init", std::vector<variable_type>{}};
 
-static inline function_call sqrt_tile_init =
+static inline function_call const sqrt_tile_init =
    function_call{sqrt_tile_init_decl, {}};
 
-static inline function_decl sqrt_tile_decl =
+static inline function_decl const sqrt_tile_decl =
    function_decl{"sqrt_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call sqrt_tile =
+static inline function_call const sqrt_tile =
    function_call{sqrt_tile_decl, {}};
 
-static inline function_decl rsqrt_tile_init_decl =
+static inline function_decl const rsqrt_tile_init_decl =
    function_decl{"rsqrt_tile_init<false>", std::vector<variable_type>{}};
 
-static inline function_call rsqrt_tile_init =
+static inline function_call const rsqrt_tile_init =
    function_call{rsqrt_tile_init_decl, {}};
 
-static inline function_decl rsqrt_tile_decl =
+static inline function_decl const rsqrt_tile_decl =
    function_decl{"rsqrt_tile<false>", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call rsqrt_tile =
+static inline function_call const rsqrt_tile =
    function_call{rsqrt_tile_decl, {}};
 
-static inline function_decl rsqrt_tile_fast_approx_init_decl =
+static inline function_decl const rsqrt_tile_fast_approx_init_decl =
    function_decl{"rsqrt_tile_init", std::vector<variable_type>{}};
 
-static inline function_call rsqrt_tile_fast_approx_init =
+static inline function_call const rsqrt_tile_fast_approx_init =
    function_call{rsqrt_tile_fast_approx_init_decl, {}};
 
-static inline function_decl rsqrt_tile_fast_approx_decl =
+static inline function_decl const rsqrt_tile_fast_approx_decl =
    function_decl{"rsqrt_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call rsqrt_tile_fast_approx =
+static inline function_call const rsqrt_tile_fast_approx =
    function_call{rsqrt_tile_fast_approx_decl, {}};
 
-static inline function_decl sigmoid_tile_init_decl =
+static inline function_decl const sigmoid_tile_init_decl =
    function_decl{"sigmoid_tile_init", std::vector<variable_type>{}};
 
-static inline function_call sigmoid_tile_init =
+static inline function_call const sigmoid_tile_init =
    function_call{sigmoid_tile_init_decl, {}};
 
-static inline function_decl sigmoid_tile_decl =
+static inline function_decl const sigmoid_tile_decl =
    function_decl{"sigmoid_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call sigmoid_tile =
+static inline function_call const sigmoid_tile =
    function_call{sigmoid_tile_decl, {}};
 
-static inline function_decl log_tile_init_decl =
+static inline function_decl const log_tile_init_decl =
    function_decl{"log_tile_init", std::vector<variable_type>{}};
 
-static inline function_call log_tile_init =
+static inline function_call const log_tile_init =
    function_call{log_tile_init_decl, {}};
 
-static inline function_decl log_tile_decl =
+static inline function_decl const log_tile_decl =
    function_decl{"log_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call log_tile =
+static inline function_call const log_tile =
    function_call{log_tile_decl, {}};
 
-static inline function_decl log_with_base_tile_init_decl =
+static inline function_decl const log_with_base_tile_init_decl =
    function_decl{"log_with_base_tile_init", std::vector<variable_type>{}};
 
-static inline function_call log_with_base_tile_init =
+static inline function_call const log_with_base_tile_init =
    function_call{log_with_base_tile_init_decl, {}};
 
-static inline function_decl log_with_base_tile_decl =
+static inline function_decl const log_with_base_tile_decl =
    function_decl{"log_with_base_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call log_with_base_tile =
+static inline function_call const log_with_base_tile =
    function_call{log_with_base_tile_decl, {}};
 
-static inline function_decl power_tile_init_decl =
+static inline function_decl const power_tile_init_decl =
    function_decl{"power_tile_init", std::vector<variable_type>{}};
 
-static inline function_call power_tile_init =
+static inline function_call const power_tile_init =
    function_call{power_tile_init_decl, {}};
 
-static inline function_decl power_tile_decl =
+static inline function_decl const power_tile_decl =
    function_decl{"power_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call power_tile =
+static inline function_call const power_tile =
    function_call{power_tile_decl, {}};
 
-static inline function_decl rsub_tile_init_decl =
+static inline function_decl const rsub_tile_init_decl =
    function_decl{"rsub_tile_init", std::vector<variable_type>{}};
 
-static inline function_call rsub_tile_init =
+static inline function_call const rsub_tile_init =
    function_call{rsub_tile_init_decl, {}};
 
-static inline function_decl rsub_tile_decl =
+static inline function_decl const rsub_tile_decl =
    function_decl{"rsub_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call rsub_tile =
+static inline function_call const rsub_tile =
    function_call{rsub_tile_decl, {}};
 
-static inline function_decl signbit_tile_init_decl =
+static inline function_decl const signbit_tile_init_decl =
    function_decl{"signbit_tile_init", std::vector<variable_type>{}};
 
-static inline function_call signbit_tile_init =
+static inline function_call const signbit_tile_init =
    function_call{signbit_tile_init_decl, {}};
 
-static inline function_decl signbit_tile_decl =
+static inline function_decl const signbit_tile_decl =
    function_decl{"signbit_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call signbit_tile =
+static inline function_call const signbit_tile =
    function_call{signbit_tile_decl, {}};
 
-static inline function_decl square_tile_init_decl =
+static inline function_decl const square_tile_init_decl =
    function_decl{"square_tile_init", std::vector<variable_type>{}};
 
-static inline function_call square_tile_init =
+static inline function_call const square_tile_init =
    function_call{square_tile_init_decl, {}};
 
-static inline function_decl square_tile_decl =
+static inline function_decl const square_tile_decl =
    function_decl{"square_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call square_tile =
+static inline function_call const square_tile =
    function_call{square_tile_decl, {}};
 
-static inline function_decl reduce_tile_sum_r_decl =
+static inline function_decl const reduce_tile_sum_r_decl =
    function_decl{"reduce_tile<ReduceFunc::Sum, Reduce::R>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_sum_r =
+static inline function_call const reduce_tile_sum_r =
    function_call{reduce_tile_sum_r_decl, {}};
 
-static inline function_decl reduce_tile_sum_c_decl =
+static inline function_decl const reduce_tile_sum_c_decl =
    function_decl{"reduce_tile<ReduceFunc::Sum, Reduce::C>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_sum_c =
+static inline function_call const reduce_tile_sum_c =
    function_call{reduce_tile_sum_c_decl, {}};
 
-static inline function_decl reduce_tile_sum_rc_decl =
+static inline function_decl const reduce_tile_sum_rc_decl =
    function_decl{"reduce_tile<ReduceFunc::Sum, Reduce::RC>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_sum_rc =
+static inline function_call const reduce_tile_sum_rc =
    function_call{reduce_tile_sum_rc_decl, {}};
 
-static inline function_decl reduce_tile_max_r_decl =
+static inline function_decl const reduce_tile_max_r_decl =
    function_decl{"reduce_tile<ReduceFunc::Max, Reduce::R>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_max_r =
+static inline function_call const reduce_tile_max_r =
    function_call{reduce_tile_max_r_decl, {}};
 
-static inline function_decl reduce_tile_max_c_decl =
+static inline function_decl const reduce_tile_max_c_decl =
    function_decl{"reduce_tile<ReduceFunc::Max, Reduce::C>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_max_c =
+static inline function_call const reduce_tile_max_c =
    function_call{reduce_tile_max_c_decl, {}};
 
-static inline function_decl reduce_tile_max_rc_decl =
+static inline function_decl const reduce_tile_max_rc_decl =
    function_decl{"reduce_tile<ReduceFunc::Max, Reduce::RC>", std::vector<variable_type>{scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{},scalar<u32>{}}};
 
-static inline function_call reduce_tile_max_rc =
+static inline function_call const reduce_tile_max_rc =
    function_call{reduce_tile_max_rc_decl, {}};
 
-static inline function_decl transpose_wh_init_decl =
+static inline function_decl const transpose_wh_init_decl =
    function_decl{"transpose_wh_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call transpose_wh_init =
+static inline function_call const transpose_wh_init =
    function_call{transpose_wh_init_decl, {}};
 
-static inline function_decl transpose_wh_tile_decl =
+static inline function_decl const transpose_wh_tile_decl =
    function_decl{"transpose_wh_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call transpose_wh_tile =
+static inline function_call const transpose_wh_tile =
    function_call{transpose_wh_tile_decl, {}};
 
-static inline function_decl tanh_tile_init_decl =
+static inline function_decl const tanh_tile_init_decl =
    function_decl{"tanh_tile_init", std::vector<variable_type>{}};
 
-static inline function_call tanh_tile_init =
+static inline function_call const tanh_tile_init =
    function_call{tanh_tile_init_decl, {}};
 
-static inline function_decl tanh_tile_decl =
+static inline function_decl const tanh_tile_decl =
    function_decl{"tanh_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call tanh_tile =
+static inline function_call const tanh_tile =
    function_call{tanh_tile_decl, {}};
 
-static inline function_decl tan_tile_init_decl =
+static inline function_decl const tan_tile_init_decl =
    function_decl{"tan_tile_init", std::vector<variable_type>{}};
 
-static inline function_call tan_tile_init =
+static inline function_call const tan_tile_init =
    function_call{tan_tile_init_decl, {}};
 
-static inline function_decl tan_tile_decl =
+static inline function_decl const tan_tile_decl =
    function_decl{"tan_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call tan_tile =
+static inline function_call const tan_tile =
    function_call{tan_tile_decl, {}};
 
-static inline function_decl sin_tile_init_decl =
+static inline function_decl const sin_tile_init_decl =
    function_decl{"sin_tile_init", std::vector<variable_type>{}};
 
-static inline function_call sin_tile_init =
+static inline function_call const sin_tile_init =
    function_call{sin_tile_init_decl, {}};
 
-static inline function_decl sin_tile_decl =
+static inline function_decl const sin_tile_decl =
    function_decl{"sin_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call sin_tile =
+static inline function_call const sin_tile =
    function_call{sin_tile_decl, {}};
 
-static inline function_decl cos_tile_init_decl =
+static inline function_decl const cos_tile_init_decl =
    function_decl{"cos_tile_init", std::vector<variable_type>{}};
 
-static inline function_call cos_tile_init =
+static inline function_call const cos_tile_init =
    function_call{cos_tile_init_decl, {}};
 
-static inline function_decl cos_tile_decl =
+static inline function_decl const cos_tile_decl =
    function_decl{"cos_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call cos_tile =
+static inline function_call const cos_tile =
    function_call{cos_tile_decl, {}};
 
-static inline function_decl asin_tile_init_decl =
+static inline function_decl const asin_tile_init_decl =
    function_decl{"asin_tile_init", std::vector<variable_type>{}};
 
-static inline function_call asin_tile_init =
+static inline function_call const asin_tile_init =
    function_call{asin_tile_init_decl, {}};
 
-static inline function_decl asin_tile_decl =
+static inline function_decl const asin_tile_decl =
    function_decl{"asin_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call asin_tile =
+static inline function_call const asin_tile =
    function_call{asin_tile_decl, {}};
 
-static inline function_decl atan_tile_init_decl =
+static inline function_decl const atan_tile_init_decl =
    function_decl{"atan_tile_init", std::vector<variable_type>{}};
 
-static inline function_call atan_tile_init =
+static inline function_call const atan_tile_init =
    function_call{atan_tile_init_decl, {}};
 
-static inline function_decl atan_tile_decl =
+static inline function_decl const atan_tile_decl =
    function_decl{"atan_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call atan_tile =
+static inline function_call const atan_tile =
    function_call{atan_tile_decl, {}};
 
-static inline function_decl acos_tile_init_decl =
+static inline function_decl const acos_tile_init_decl =
    function_decl{"acos_tile_init", std::vector<variable_type>{}};
 
-static inline function_call acos_tile_init =
+static inline function_call const acos_tile_init =
    function_call{acos_tile_init_decl, {}};
 
-static inline function_decl acos_tile_decl =
+static inline function_decl const acos_tile_decl =
    function_decl{"acos_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call acos_tile =
+static inline function_call const acos_tile =
    function_call{acos_tile_decl, {}};
 
-static inline function_decl ltz_tile_init_decl =
+static inline function_decl const ltz_tile_init_decl =
    function_decl{"ltz_tile_init", std::vector<variable_type>{}};
 
-static inline function_call ltz_tile_init =
+static inline function_call const ltz_tile_init =
    function_call{ltz_tile_init_decl, {}};
 
-static inline function_decl ltz_tile_decl =
+static inline function_decl const ltz_tile_decl =
    function_decl{"ltz_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call ltz_tile =
+static inline function_call const ltz_tile =
    function_call{ltz_tile_decl, {}};
 
-static inline function_decl eqz_tile_init_decl =
+static inline function_decl const eqz_tile_init_decl =
    function_decl{"eqz_tile_init", std::vector<variable_type>{}};
 
-static inline function_call eqz_tile_init =
+static inline function_call const eqz_tile_init =
    function_call{eqz_tile_init_decl, {}};
 
-static inline function_decl eqz_tile_decl =
+static inline function_decl const eqz_tile_decl =
    function_decl{"eqz_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call eqz_tile =
+static inline function_call const eqz_tile =
    function_call{eqz_tile_decl, {}};
 
-static inline function_decl lez_tile_init_decl =
+static inline function_decl const lez_tile_init_decl =
    function_decl{"lez_tile_init", std::vector<variable_type>{}};
 
-static inline function_call lez_tile_init =
+static inline function_call const lez_tile_init =
    function_call{lez_tile_init_decl, {}};
 
-static inline function_decl lez_tile_decl =
+static inline function_decl const lez_tile_decl =
    function_decl{"lez_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call lez_tile =
+static inline function_call const lez_tile =
    function_call{lez_tile_decl, {}};
 
-static inline function_decl gtz_tile_init_decl =
+static inline function_decl const gtz_tile_init_decl =
    function_decl{"gtz_tile_init", std::vector<variable_type>{}};
 
-static inline function_call gtz_tile_init =
+static inline function_call const gtz_tile_init =
    function_call{gtz_tile_init_decl, {}};
 
-static inline function_decl gtz_tile_decl =
+static inline function_decl const gtz_tile_decl =
    function_decl{"gtz_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call gtz_tile =
+static inline function_call const gtz_tile =
    function_call{gtz_tile_decl, {}};
 
-static inline function_decl gez_tile_init_decl =
+static inline function_decl const gez_tile_init_decl =
    function_decl{"gez_tile_init", std::vector<variable_type>{}};
 
-static inline function_call gez_tile_init =
+static inline function_call const gez_tile_init =
    function_call{gez_tile_init_decl, {}};
 
-static inline function_decl gez_tile_decl =
+static inline function_decl const gez_tile_decl =
    function_decl{"gez_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call gez_tile =
+static inline function_call const gez_tile =
    function_call{gez_tile_decl, {}};
 
-static inline function_decl nez_tile_init_decl =
+static inline function_decl const nez_tile_init_decl =
    function_decl{"nez_tile_init", std::vector<variable_type>{}};
 
-static inline function_call nez_tile_init =
+static inline function_call const nez_tile_init =
    function_call{nez_tile_init_decl, {}};
 
-static inline function_decl nez_tile_decl =
+static inline function_decl const nez_tile_decl =
    function_decl{"nez_tile", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call nez_tile =
+static inline function_call const nez_tile =
    function_call{nez_tile_decl, {}};
 
-static inline function_decl unary_ne_tile_init_decl =
+static inline function_decl const unary_ne_tile_init_decl =
    function_decl{"unary_ne_tile_init", std::vector<variable_type>{}};
 
-static inline function_call unary_ne_tile_init =
+static inline function_call const unary_ne_tile_init =
    function_call{unary_ne_tile_init_decl, {}};
 
-static inline function_decl unary_ne_tile_decl =
+static inline function_decl const unary_ne_tile_decl =
    function_decl{"unary_ne_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call unary_ne_tile =
+static inline function_call const unary_ne_tile =
    function_call{unary_ne_tile_decl, {}};
 
-static inline function_decl unary_gt_tile_init_decl =
+static inline function_decl const unary_gt_tile_init_decl =
    function_decl{"unary_gt_tile_init", std::vector<variable_type>{}};
 
-static inline function_call unary_gt_tile_init =
+static inline function_call const unary_gt_tile_init =
    function_call{unary_gt_tile_init_decl, {}};
 
-static inline function_decl unary_gt_tile_decl =
+static inline function_decl const unary_gt_tile_decl =
    function_decl{"unary_gt_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call unary_gt_tile =
+static inline function_call const unary_gt_tile =
    function_call{unary_gt_tile_decl, {}};
 
-static inline function_decl unary_lt_tile_init_decl =
+static inline function_decl const unary_lt_tile_init_decl =
    function_decl{"unary_lt_tile_init", std::vector<variable_type>{}};
 
-static inline function_call unary_lt_tile_init =
+static inline function_call const unary_lt_tile_init =
    function_call{unary_lt_tile_init_decl, {}};
 
-static inline function_decl unary_lt_tile_decl =
+static inline function_decl const unary_lt_tile_decl =
    function_decl{"unary_lt_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call unary_lt_tile =
+static inline function_call const unary_lt_tile =
    function_call{unary_lt_tile_decl, {}};
 
-static inline function_decl cb_wait_front_decl =
+static inline function_decl const cb_wait_front_decl =
    function_decl{"cb_wait_front", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call cb_wait_front =
+static inline function_call const cb_wait_front =
    function_call{cb_wait_front_decl, {}};
 
-static inline function_decl cb_pop_front_decl =
+static inline function_decl const cb_pop_front_decl =
    function_decl{"cb_pop_front", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call cb_pop_front =
+static inline function_call const cb_pop_front =
    function_call{cb_pop_front_decl, {}};
 
-static inline function_decl cb_reserve_back_decl =
+static inline function_decl const cb_reserve_back_decl =
    function_decl{"cb_reserve_back", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call cb_reserve_back =
+static inline function_call const cb_reserve_back =
    function_call{cb_reserve_back_decl, {}};
 
-static inline function_decl cb_push_back_decl =
+static inline function_decl const cb_push_back_decl =
    function_decl{"cb_push_back", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call cb_push_back =
+static inline function_call const cb_push_back =
    function_call{cb_push_back_decl, {}};
 
-static inline function_decl binary_op_init_common_decl =
+static inline function_decl const binary_op_init_common_decl =
    function_decl{"binary_op_init_common", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call binary_op_init_common =
+static inline function_call const binary_op_init_common =
    function_call{binary_op_init_common_decl, {}};
 
-static inline function_decl binary_op_specific_full_add_init_decl =
+static inline function_decl const binary_op_specific_full_add_init_decl =
    function_decl{"binary_op_specific_init<true, EltwiseBinaryType::ELWADD>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_full_add_init =
+static inline function_call const binary_op_specific_full_add_init =
    function_call{binary_op_specific_full_add_init_decl, {}};
 
-static inline function_decl binary_op_specific_full_sub_init_decl =
+static inline function_decl const binary_op_specific_full_sub_init_decl =
    function_decl{"binary_op_specific_init<true, EltwiseBinaryType::ELWSUB>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_full_sub_init =
+static inline function_call const binary_op_specific_full_sub_init =
    function_call{binary_op_specific_full_sub_init_decl, {}};
 
-static inline function_decl binary_op_specific_full_mul_init_decl =
+static inline function_decl const binary_op_specific_full_mul_init_decl =
    function_decl{"binary_op_specific_init<true, EltwiseBinaryType::ELWMUL>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_full_mul_init =
+static inline function_call const binary_op_specific_full_mul_init =
    function_call{binary_op_specific_full_mul_init_decl, {}};
 
-static inline function_decl binary_op_specific_add_init_decl =
+static inline function_decl const binary_op_specific_add_init_decl =
    function_decl{"binary_op_specific_init<false, EltwiseBinaryType::ELWADD>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_add_init =
+static inline function_call const binary_op_specific_add_init =
    function_call{binary_op_specific_add_init_decl, {}};
 
-static inline function_decl binary_op_specific_sub_init_decl =
+static inline function_decl const binary_op_specific_sub_init_decl =
    function_decl{"binary_op_specific_init<false, EltwiseBinaryType::ELWSUB>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_sub_init =
+static inline function_call const binary_op_specific_sub_init =
    function_call{binary_op_specific_sub_init_decl, {}};
 
-static inline function_decl binary_op_specific_mul_init_decl =
+static inline function_decl const binary_op_specific_mul_init_decl =
    function_decl{"binary_op_specific_init<false, EltwiseBinaryType::ELWMUL>", std::vector<variable_type>{}};
 
-static inline function_call binary_op_specific_mul_init =
+static inline function_call const binary_op_specific_mul_init =
    function_call{binary_op_specific_mul_init_decl, {}};
 
-static inline function_decl tilize_init_decl =
+static inline function_decl const tilize_init_decl =
    function_decl{"tilize_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_init =
+static inline function_call const tilize_init =
    function_call{tilize_init_decl, {}};
 
-static inline function_decl tilize_init_short_decl =
+static inline function_decl const tilize_init_short_decl =
    function_decl{"tilize_init_short", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_init_short =
+static inline function_call const tilize_init_short =
    function_call{tilize_init_short_decl, {}};
 
-static inline function_decl tilize_init_short_with_dt_decl =
+static inline function_decl const tilize_init_short_with_dt_decl =
    function_decl{"tilize_init_short_with_dt", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_init_short_with_dt =
+static inline function_call const tilize_init_short_with_dt =
    function_call{tilize_init_short_with_dt_decl, {}};
 
-static inline function_decl tilize_block_decl =
+static inline function_decl const tilize_block_decl =
    function_decl{"tilize_block", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_block =
+static inline function_call const tilize_block =
    function_call{tilize_block_decl, {}};
 
-static inline function_decl tilize_uninit_decl =
+static inline function_decl const tilize_uninit_decl =
    function_decl{"tilize_uninit", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_uninit =
+static inline function_call const tilize_uninit =
    function_call{tilize_uninit_decl, {}};
 
-static inline function_decl tilize_uninit_with_dt_decl =
+static inline function_decl const tilize_uninit_with_dt_decl =
    function_decl{"tilize_uninit_with_dt", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call tilize_uninit_with_dt =
+static inline function_call const tilize_uninit_with_dt =
    function_call{tilize_uninit_with_dt_decl, {}};
 
-static inline function_decl untilize_init_decl =
+static inline function_decl const untilize_init_decl =
    function_decl{"untilize_init", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call untilize_init =
+static inline function_call const untilize_init =
    function_call{untilize_init_decl, {}};
 
-static inline function_decl untilize_init_short_decl =
+static inline function_decl const untilize_init_short_decl =
    function_decl{"untilize_init_short", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call untilize_init_short =
+static inline function_call const untilize_init_short =
    function_call{untilize_init_short_decl, {}};
 
-static inline function_decl untilize_block_decl =
+static inline function_decl const untilize_block_decl =
    function_decl{"untilize_block", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<i32>{}}};
 
-static inline function_call untilize_block =
+static inline function_call const untilize_block =
    function_call{untilize_block_decl, {}};
 
-static inline function_decl untilize_uninit_decl =
+static inline function_decl const untilize_uninit_decl =
    function_decl{"untilize_uninit", std::vector<variable_type>{scalar<u32>{}}};
 
-static inline function_call untilize_uninit =
+static inline function_call const untilize_uninit =
    function_call{untilize_uninit_decl, {}};
 
 } /* namespace compute */
 
 namespace packing {
 
-static inline function_decl pack_tile_ooo_decl =
+static inline function_decl const pack_tile_ooo_decl =
    function_decl{"pack_tile<true>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call pack_tile_ooo =
+static inline function_call const pack_tile_ooo =
    function_call{pack_tile_ooo_decl, {}};
 
-static inline function_decl pack_tile_decl =
+static inline function_decl const pack_tile_decl =
    function_decl{"pack_tile<false>", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call pack_tile =
+static inline function_call const pack_tile =
    function_call{pack_tile_decl, {}};
 
-static inline function_decl matmul_pack_tile_decl =
+static inline function_decl const matmul_pack_tile_decl =
    function_decl{"matmul_pack_tile", std::vector<variable_type>{scalar<u32>{}, scalar<u32>{}, scalar<u32>{}}};
 
-static inline function_call matmul_pack_tile =
+static inline function_call const matmul_pack_tile =
    function_call{matmul_pack_tile_decl, {}};
 
 }
@@ -0,0 +1,198 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_ARENA_HPP__
+#define __TT_EDSL_ARENA_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+#include "recursive_wrapper.hpp"
+
+namespace tt { namespace dsl {
+
+struct arena_resource : public mpark::util::node_resource {
+
+   // bump allocator backing recursive_wrapper nodes
+   //
+   // nodes are carved out of large blocks; deallocate only
+   // tracks the number of live nodes. release() rewinds every
+   // block in one shot once the last live node is destroyed,
+   // retained blocks are reused by the next kernel.
+   //
+   // the resource outlives its owning node_arena while nodes
+   // allocated from it are still alive (ie: statements copied
+   // into a global function_def); live counts those nodes plus
+   // one for the owner, and whichever thread's decrement takes
+   // it to zero deletes the resource
+   //
+   // blocks are reclaimed all at once, never one at a time: a
+   // single long lived node keeps every block alive and defers
+   // the rewind, so a context that keeps nodes alive across
+   // repeated kernel_main calls grows by the size of each
+   // kernel until those nodes are destroyed
+   //
+
+   using block_size = std::integral_constant<std::size_t, 64UL * 1024UL>;
+
+   struct block {
+      std::unique_ptr<unsigned char[]> data;
+      std::size_t size;
+   };
+
+   std::vector<block> blocks;
+   std::size_t block_idx;
+   std::size_t offset;
+   std::atomic<std::size_t> live;
+   bool release_pending;
+
+   arena_resource() :
+      blocks(), block_idx(0), offset(0), live(1), release_pending(false) {
+   }
+
+   // blocks, block_idx, offset and release_pending belong to the
+   // owner's thread; only live is touched by other threads
+   //
+   void* allocate(std::size_t bytes, std::size_t align) override {
+      if(release_pending && nodes() == 0) {
+         rewind();
+      }
+
+      while(block_idx < blocks.size()) {
+         block & blk = blocks[block_idx];
+         const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(blk.data.get());
+         const std::size_t aligned =
+            ((base + offset + align - 1UL) & ~(static_cast<std::uintptr_t>(align) - 1UL)) - base;
+
+         if(aligned + bytes <= blk.size) {
+            offset = aligned + bytes;
+            live.fetch_add(1UL, std::memory_order_relaxed);
+            return blk.data.get() + aligned;
+         }
+
+         ++block_idx;
+         offset = 0;
+      }
+
+      const std::size_t size = (bytes + align > block_size::value) ? bytes + align : block_size::value;
+      blocks.push_back(block{std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+      block_idx = blocks.size() - 1UL;
+      offset = 0;
+
+      return allocate(bytes, align);
+   }
+
+   void deallocate(void*, std::size_t, std::size_t) override {
+      unref();
+   }
+
+   // live nodes, while the resource is owned
+   //
+   std::size_t nodes() const {
+      return live.load(std::memory_order_acquire) - 1UL;
+   }
+
+   // a pending rewind is applied by the owner, here or at its
+   // next allocate, never by a thread destroying nodes
+   //
+   void release() {
+      if(nodes() == 0) {
+         rewind();
+      }
+      else {
+         release_pending = true;
+      }
+   }
+
+   void rewind() {
+      block_idx = 0;
+      offset = 0;
+      release_pending = false;
+   }
+
+   void orphan() {
+      unref();
+   }
+
+   void unref() {
+      if(live.fetch_sub(1UL, std::memory_order_acq_rel) == 1UL) {
+         delete this;
+      }
+   }
+};
+
+struct node_arena {
+
+   // per kernel_context owner of an arena_resource
+   //
+
+   arena_resource * resource;
+
+   node_arena() : resource(new arena_resource{}) {}
+
+   // arenas are never shared, a copied kernel_context starts empty
+   //
+   node_arena(node_arena const&) : node_arena() {}
+
+   node_arena & operator=(node_arena const&) = delete;
+
+   ~node_arena() {
+      resource->orphan();
+   }
+
+   // frees every node in one shot; deferred until the
+   // last live node built in the arena is destroyed and the
+   // arena next allocates
+   //
+   void release() {
+      resource->release();
+   }
+
+   std::size_t live() const {
+      return resource->nodes();
+   }
+
+   std::size_t bytes_reserved() const {
+      std::size_t total = 0;
+      for(auto const& blk : resource->blocks) {
+         total += blk.size;
+      }
+      return total;
+   }
+};
+
+struct arena_scope {
+
+   // installs a node_arena as the allocator for every
+   // recursive_wrapper constructed on this thread until
+   // the scope ends
+   //
+
+   mpark::util::node_resource * previous;
+
+   arena_scope(node_arena & arena) :
+      previous(mpark::util::current_node_resource()) {
+      mpark::util::current_node_resource() = arena.resource;
+   }
+
+   arena_scope(arena_scope const&) = delete;
+   arena_scope & operator=(arena_scope const&) = delete;
+
+   ~arena_scope() {
+      mpark::util::current_node_resource() = previous;
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
@@ -10,259 +10,1969 @@
 #ifndef __TT_EDSL_CACHE_HPP__
 #define __TT_EDSL_CACHE_HPP__
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <initializer_list>
 #include <limits>
-#include <random>
+#include <mutex>
+#include <optional>
 #include <string>
-
-#include <db_cxx.h>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #define FMT_HEADER_ONLY
 #include <fmt/format.h>
 
-#include "dsl.hpp"
+#include "ir.hpp"
+#include "hash.hpp"
+#include "lru.hpp"
 
 namespace fs = std::filesystem;
 
 namespace tt { namespace dsl {
 
-struct kernel_cache {
+struct mapped_file {
+
+   // read-only mapping of a whole file; the view is valid
+   // for the lifetime of the handle
+   //
+
+   void * data;
+   std::size_t size;
+
+   mapped_file() : data(nullptr), size(0) {}
+
+   mapped_file(mapped_file const&) = delete;
+   mapped_file & operator=(mapped_file const&) = delete;
+
+   mapped_file(mapped_file && other) noexcept : data(other.data), size(other.size) {
+      other.data = nullptr;
+      other.size = 0;
+   }
+
+   mapped_file & operator=(mapped_file && other) noexcept {
+      if(this != &other) {
+         reset();
+         data = other.data;
+         size = other.size;
+         other.data = nullptr;
+         other.size = 0;
+      }
+      return (*this);
+   }
+
+   ~mapped_file() {
+      reset();
+   }
+
+   bool map(fs::path const& path) {
+      reset();
+
+      const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if(fd < 0) { return false; }
+
+      struct stat st;
+      if(::fstat(fd, &st) != 0) {
+         ::close(fd);
+         return false;
+      }
+
+      // an empty file is a valid, empty view
+      //
+      if(0 < st.st_size) {
+         void * addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+         if(addr == MAP_FAILED) {
+            ::close(fd);
+            return false;
+         }
+
+         data = addr;
+         size = static_cast<std::size_t>(st.st_size);
+      }
+
+      // the mapping outlives the descriptor
+      //
+      ::close(fd);
+      return true;
+   }
+
+   void reset() {
+      if(data != nullptr) {
+         ::munmap(data, size);
+      }
+      data = nullptr;
+      size = 0;
+   }
+
+   std::string_view view() const {
+      return (data == nullptr) ? std::string_view{} : std::string_view{static_cast<char const*>(data), size};
+   }
+};
+
+struct cache_io {
 
-   // berkeley database backed kernel cache
+   // file helpers shared by the cache and its backends
    //
-   // keys are hashes of the kernel source code
+
+   static bool read_file(fs::path const& path, std::string & data) {
+      std::ifstream ifs(path, std::ios::binary);
+      if(!ifs) { return false; }
+
+      std::ostringstream oss;
+      oss << ifs.rdbuf();
+      data = oss.str();
+
+      return true;
+   }
+
+   // atomically replaces path with data; the file is written
+   // under a unique temporary name in the same directory,
+   // fsync'd (when sync is set), and renamed over path
    //
-   // values are paths to the file stored in $HOME/.tt_edsl
+   static bool write_file(fs::path const& path, std::string_view const data, bool const sync = true) {
+      fs::path tmp_path;
+      if(!write_temp(path, data, sync, tmp_path)) {
+         return false;
+      }
+
+      if(::rename(tmp_path.c_str(), path.c_str()) != 0) {
+         std::error_code ec;
+         fs::remove(tmp_path, ec);
+         return false;
+      }
+
+      return true;
+   }
+
+   // writes data next to path under a unique temporary name
    //
+   static bool write_temp(fs::path const& path, std::string_view const data, bool const sync, fs::path & tmp_path) {
+      static std::atomic<std::uint64_t> counter{0};
 
-   const static inline fs::path home = "./.tt_edsl";
+      std::error_code ec;
+      fs::create_directories(path.parent_path(), ec);
 
-   using max_path = std::integral_constant<std::size_t, 260UL>;
+      tmp_path = path.parent_path() / fs::path{fmt::format("{}{}.{}.{}", temp_prefix,
+         ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()), counter.fetch_add(1))};
 
-   Db dbobj;
+      const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+      if(fd < 0) { return false; }
 
-   kernel_cache() : dbobj(nullptr, 0) {
-      if(!fs::exists(home)) {
-         setup();
+      char const* p = data.data();
+      std::size_t remaining = data.size();
+      bool ok = true;
+
+      while(ok && 0 < remaining) {
+         const ssize_t written = ::write(fd, p, remaining);
+         if(written < 0) {
+            ok = (errno == EINTR);
+            continue;
+         }
+         p += written;
+         remaining -= static_cast<std::size_t>(written);
+      }
+
+      ok = ok && (!sync || ::fsync(fd) == 0);
+      ok = (::close(fd) == 0) && ok;
+
+      if(!ok) {
+         fs::remove(tmp_path, ec);
       }
+
+      return ok;
+   }
+
+   // fsyncs a directory, making the renames into it durable
+   //
+   static bool sync_directory(fs::path const& dir) {
+      const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if(fd < 0) { return false; }
+
+      const bool ok = (::fsync(fd) == 0);
+      ::close(fd);
+      return ok;
    }
 
-   // hsearch hashing function from musl MIT license
+   // fsyncs, once each, the directories paths were renamed
+   // into and their parents, which hold any directory
+   // write_temp created for them
    //
-   // libc/musl/src/search/hsearch.c
+   static bool sync_parents(std::vector<fs::path> const& paths) {
+      std::unordered_set<std::string> synced;
+      bool ok = true;
+
+      for(auto const& pth : paths) {
+         for(fs::path const& dir : { pth.parent_path(), pth.parent_path().parent_path() }) {
+            if(synced.insert(dir.string()).second) {
+               ok = sync_directory(dir) && ok;
+            }
+         }
+      }
+
+      return ok;
+   }
+
+   // asks the kernel to read path ahead into the page cache; a
+   // no-op where posix_fadvise is unavailable
    //
-   // static size_t keyhash(char *k)
+   static bool will_need(fs::path const& path) {
+#if defined(POSIX_FADV_WILLNEED)
+      const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if(fd < 0) { return false; }
+
+      const bool ok = (::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) == 0);
+      ::close(fd);
+      return ok;
+#else
+      static_cast<void>(path);
+      return true;
+#endif
+   }
+
+   // s as one single quoted /bin/sh word; embedded quotes are
+   // closed, escaped and reopened
    //
-   static std::size_t hash(std::string & str) {
-      unsigned char *p = reinterpret_cast<unsigned char *>(const_cast<char*>(str.c_str()));
-      std::size_t h = 0;
-      while (*p) h = 31*h + *p++;
-      return h;
+   static std::string shell_quote(std::string_view const s) {
+      std::string quoted{"'"};
+      quoted.reserve(s.size() + 2UL);
+      for(const char c : s) {
+         if(c == '\'') { quoted += "'\\''"; }
+         else { quoted += c; }
+      }
+      quoted += '\'';
+      return quoted;
    }
 
-   static void setup() {
-      if(create_directory(kernel_cache::home)) {
-         std::cerr << fmt::format("tt-edsl error: {} failed to setup", kernel_cache::home.string()) << std::endl;
+   // each whitespace separated word of s quoted on its own, so
+   // a flag list stays a list of arguments and nothing in it
+   // is read by the shell
+   //
+   static std::string shell_quote_words(std::string_view const s) {
+      std::string quoted;
+      std::size_t i = 0;
+      while(i < s.size()) {
+         if(std::isspace(static_cast<unsigned char>(s[i]))) { ++i; continue; }
+
+         std::size_t j = i;
+         while(j < s.size() && !std::isspace(static_cast<unsigned char>(s[j]))) { ++j; }
+
+         if(!quoted.empty()) { quoted += ' '; }
+         quoted += shell_quote(s.substr(i, j - i));
+         i = j;
       }
+      return quoted;
+   }
 
-      fs::path cache_path = home / fs::path{"cache.db"};
+   // removes the temporaries under dir older than age; a
+   // writer that dies before its rename leaves one behind
+   //
+   static void remove_stale_temps(fs::path const& dir, std::chrono::seconds const age) {
+      const auto stale_before = fs::file_time_type::clock::now() - age;
 
-      const std::uint32_t oflags = DB_CREATE;
+      std::error_code ec;
+      for(fs::recursive_directory_iterator itr{dir, ec}, end; !ec && itr != end; itr.increment(ec)) {
+         if(itr->path().filename().string().rfind(temp_prefix, 0) != 0) { continue; }
 
-      Db db(nullptr, 0);
-      try {
-         db.open(nullptr, cache_path.string().c_str(), nullptr, DB_BTREE, DB_CREATE, 0);
-         db.close(0);
+         std::error_code tmp_ec;
+         const auto written = fs::last_write_time(itr->path(), tmp_ec);
+         if(!tmp_ec && written < stale_before) {
+            fs::remove(itr->path(), tmp_ec);
+         }
       }
-      catch(DbException &e) {
-         std::cerr << fmt::format("tt-edsl error: {} failed to create database", cache_path.string()) << std::endl;
+   }
+
+   constexpr static inline char const* temp_prefix = ".tmp.";
+
+   // seconds after which a temporary is treated as abandoned
+   //
+   using stale_temp_age = std::integral_constant<std::int64_t, 3600L>;
+};
+
+// backend value, one per source or artifact
+//
+struct cache_record {
+   char core[16];
+   std::uint64_t bytes;
+   std::uint64_t atime;
+   std::uint64_t hits;
+};
+
+static_assert(std::is_trivially_copyable<cache_record>::value, "cache_record is stored as raw bytes");
+
+struct cache_item {
+   content_hash key;
+   cache_record rec;
+};
+
+// batched use of one entry, folded into its record
+//
+struct cache_access {
+   content_hash key;
+   std::uint64_t hits;
+   std::uint64_t atime;
+};
+
+// lock free log2 histogram of nanosecond latencies; bucket i
+// counts samples in [2^i, 2^(i+1)), bucket 0 also counts 0
+//
+struct latency_histogram {
+
+   using buckets = std::integral_constant<std::size_t, 48UL>;
+
+   std::array<std::atomic<std::uint64_t>, buckets::value> counts;
+
+   latency_histogram() : counts() {
+      for(auto & c : counts) { c.store(0, std::memory_order_relaxed); }
+   }
+
+   static std::size_t bucket_of(std::uint64_t ns) {
+      std::size_t i = 0;
+      while(1ULL < ns && i + 1UL < buckets::value) {
+         ns >>= 1U;
+         ++i;
       }
-      catch(std::exception &e) {
-         std::cerr << fmt::format("tt-edsl error: {} failed to create database", cache_path.string()) << std::endl;
-      } 
+      return i;
    }
 
-   void open() {
-      fs::path cache_path = home / fs::path{"cache.db"};
-      dbobj.open(nullptr, cache_path.string().c_str(), nullptr, DB_BTREE, DB_THREAD, 0);
-      dbobj.set_error_stream(&std::cerr);
+   void record(std::uint64_t const ns) {
+      counts[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
    }
+};
 
-   void close() {
-      dbobj.close(0);
+// point in time copy of one operation's counters
+//
+struct operation_stats {
+   std::uint64_t calls;
+   std::uint64_t hits;
+   std::uint64_t misses;
+   std::uint64_t bytes_read;
+   std::uint64_t bytes_written;
+   std::uint64_t total_ns;
+   std::array<std::uint64_t, latency_histogram::buckets::value> latency;
+
+   // upper bound of the bucket holding the p-th quantile,
+   // p in [0, 1]; 0 without samples
+   //
+   std::uint64_t percentile_ns(double const p) const {
+      std::uint64_t samples = 0;
+      for(auto const c : latency) { samples += c; }
+      if(samples < 1) { return 0; }
+
+      const double rank = p * static_cast<double>(samples);
+      std::uint64_t seen = 0;
+      for(std::size_t i = 0; i < latency.size(); ++i) {
+         seen += latency[i];
+         if(rank <= static_cast<double>(seen)) { return 2ULL << i; }
+      }
+
+      return 2ULL << (latency.size() - 1UL);
+   }
+
+   std::string json() const {
+      std::string buckets;
+      for(std::size_t i = 0; i < latency.size(); ++i) {
+         buckets += fmt::format("{}{}", (i == 0) ? "" : ",", latency[i]);
+      }
+
+      return fmt::format("{{\"calls\":{},\"hits\":{},\"misses\":{},\"bytes_read\":{},\"bytes_written\":{},"
+         "\"total_ns\":{},\"p50_ns\":{},\"p99_ns\":{},\"latency_log2_ns\":[{}]}}",
+         calls, hits, misses, bytes_read, bytes_written, total_ns, percentile_ns(0.5), percentile_ns(0.99), buckets);
+   }
+};
+
+struct operation_counters {
+   std::atomic<std::uint64_t> calls;
+   std::atomic<std::uint64_t> hits;
+   std::atomic<std::uint64_t> misses;
+   std::atomic<std::uint64_t> bytes_read;
+   std::atomic<std::uint64_t> bytes_written;
+   std::atomic<std::uint64_t> total_ns;
+   latency_histogram latency;
+
+   operation_counters() :
+      calls(0), hits(0), misses(0), bytes_read(0), bytes_written(0), total_ns(0), latency() {}
+
+   operation_stats snapshot() const {
+      operation_stats s{};
+      s.calls = calls.load(std::memory_order_relaxed);
+      s.hits = hits.load(std::memory_order_relaxed);
+      s.misses = misses.load(std::memory_order_relaxed);
+      s.bytes_read = bytes_read.load(std::memory_order_relaxed);
+      s.bytes_written = bytes_written.load(std::memory_order_relaxed);
+      s.total_ns = total_ns.load(std::memory_order_relaxed);
+      for(std::size_t i = 0; i < s.latency.size(); ++i) {
+         s.latency[i] = latency.counts[i].load(std::memory_order_relaxed);
+      }
+      return s;
+   }
+};
+
+// kernel_cache counters; see basic_kernel_cache::stats()
+//
+// get covers get, get_view and get_artifact; put covers put,
+// put_many and put_artifact (a hit is a key already stored);
+// purge hits are records kept, misses records dropped.
+// backend_ns and filesystem_ns split the time spent under
+// every operation between the record backend and file io
+//
+struct cache_stats {
+   operation_stats get;
+   operation_stats put;
+   operation_stats contains;
+   operation_stats purge;
+
+   std::uint64_t memory_hits;
+   std::uint64_t memory_misses;
+   std::uint64_t memory_evictions;
+
+   std::uint64_t backend_ns;
+   std::uint64_t filesystem_ns;
+   std::uint64_t backend_errors;
+
+   std::string json() const {
+      return fmt::format("{{\"get\":{},\"put\":{},\"contains\":{},\"purge\":{},"
+         "\"memory\":{{\"hits\":{},\"misses\":{},\"evictions\":{}}},"
+         "\"backend_ns\":{},\"filesystem_ns\":{},\"backend_errors\":{}}}",
+         get.json(), put.json(), contains.json(), purge.json(),
+         memory_hits, memory_misses, memory_evictions,
+         backend_ns, filesystem_ns, backend_errors);
+   }
+};
+
+struct cache_counters {
+   operation_counters get;
+   operation_counters put;
+   operation_counters contains;
+   operation_counters purge;
+
+   std::atomic<std::uint64_t> backend_ns;
+   std::atomic<std::uint64_t> filesystem_ns;
+   std::atomic<std::uint64_t> backend_errors;
+
+   cache_counters() :
+      get(), put(), contains(), purge(), backend_ns(0), filesystem_ns(0), backend_errors(0) {}
+};
+
+// a kernel_cache backend stores one cache_record per key;
+// sources and artifacts themselves are content addressed
+// files owned by the cache. a backend is default
+// constructible and provides
+//
+//    bool open(fs::path const& home);
+//    void close();
+//
+//    // existing records are kept
+//    bool insert(content_hash const& key, cache_record const& rec);
+//    bool insert_many(std::vector<cache_item> const& items);
+//
+//    // folds accesses into existing records, missing keys are skipped
+//    bool touch(std::vector<cache_access> const& accesses);
+//
+//    // at most max_records well formed records in key order,
+//    // starting after `after` (from the first key when empty);
+//    // finished is set once the last record was returned
+//    bool scan(std::optional<content_hash> const& after, std::size_t const max_records,
+//       std::vector<cache_item> & items, bool & finished);
+//
+//    bool erase(std::vector<content_hash> const& keys);
+//
+//    // erases the records of keys not used after since and
+//    // reports them in erased
+//    bool erase_idle(std::vector<content_hash> const& keys, std::uint64_t const since,
+//       std::vector<cache_item> & erased);
+//
+//    // drops records the backend cannot parse
+//    bool repair();
+//
+// every call returns false on failure after reporting it;
+// see flat_file_backend (cache_file.hpp) and
+// berkeleydb_backend (cache_bdb.hpp)
+//
+template<typename Backend>
+struct basic_kernel_cache {
+
+   // content addressed kernel cache over a pluggable record
+   // backend
+   //
+   // keys are sha-256 digests of the kernel core type and
+   // kernel source code
+   //
+   // sources are stored in $HOME/.tt_edsl/objects/<2 hex>/<62 hex>;
+   // the path is a function of the key so identical kernels
+   // are stored once and lookups never touch the backend.
+   // the backend records every key (value is the kernel core
+   // type) for purge and eviction
+   //
+   // a bounded in-memory tier (sharded lru of source text and
+   // path) answers repeated lookups without a system call, and
+   // put writes through to both tiers. an entry whose file was
+   // evicted by another process is dropped lazily: when
+   // reading or mapping the file fails, when put finds the
+   // file gone, or when compact_step or purge checks it
+   //
+   // compiled binaries are cached next to the sources in
+   // $HOME/.tt_edsl/artifacts, keyed by the source digest and
+   // the digest of the build_config that produced them
+   //
+   // files are written to a temporary name, fsync'd, and
+   // renamed into place before the record is stored so readers
+   // never see a torn kernel
+   //
+   // every record keeps the file size, last access time and
+   // access count. compact_step() walks a bounded number of
+   // records per call and, once a full pass shows the cache
+   // over its cache_budget, evicts the least recently (lru) or
+   // least frequently (lfu) used entries a few at a time;
+   // start_compactor() runs it on a background thread
+   //
+   // every key put or looked up is appended, once, to the run
+   // manifest. save_manifest() stores it under an application
+   // name in $HOME/.tt_edsl/manifests; prefetch() loads a saved
+   // manifest into the memory tier on a background thread so
+   // the next run starts warm
+   //
+   // get_or_emit() looks a kernel up by the sha256 structural
+   // fingerprint of its statement tree (see dsl.hpp) before it
+   // is emitted; $HOME/.tt_edsl/fingerprints/<2 hex>/<62 hex>
+   // holds the digest of the source that fingerprint was
+   // emitted as. a hit skips code generation entirely.
+   // fingerprints are backend records like sources and
+   // artifacts, so they count against the budget and are
+   // evicted and purged with them
+   //
+   // stats() returns hit/miss, byte and latency counters for
+   // get, put, contains and purge; start_stats_dump() writes
+   // them as json to a file on a background thread
+   //
+
+   const static inline fs::path home = "./.tt_edsl";
+   const static inline fs::path objects = home / fs::path{"objects"};
+   const static inline fs::path artifacts = home / fs::path{"artifacts"};
+   const static inline fs::path manifests = home / fs::path{"manifests"};
+   const static inline fs::path fingerprints = home / fs::path{"fingerprints"};
+
+   // record core marking a compiled artifact
+   //
+   constexpr static inline char const* artifact_core = "artifact";
+
+   // record core marking a fingerprint
+   //
+   constexpr static inline char const* fingerprint_core = "fingerprint";
+
+   using default_memory_capacity = std::integral_constant<std::size_t, 4096UL>;
+
+   using backend_type = Backend;
+   using record = cache_record;
+
+   struct entry {
+      std::string source;
+      fs::path path;
+   };
+
+   // how a kernel source becomes a binary
+   //
+   // command is a shell command template; {src}, {out} and
+   // {flags} are replaced with the cached source path, the
+   // output path and flags, each path quoted as one word and
+   // each whitespace separated flag as its own word, so none
+   // of them is parsed by the shell. any other brace (ie: a
+   // shell ${VAR} or an awk program) is left as written. the
+   // default copies the source, a stand-in for the RISC-V
+   // toolchain when no hardware or SDK is present
+   //
+   struct build_config {
+      std::string command = "cp {src} {out}";
+      std::string flags;
+      std::string toolchain_version = "stand-in";
+
+      content_hash hash() const {
+         return sha256{}.update(command).update("\0", 1UL)
+            .update(flags).update("\0", 1UL)
+            .update(toolchain_version).finalize();
+      }
+
+      std::string expand(std::string const& src, std::string const& out) const {
+         const std::pair<std::string_view, std::string> args[] = {
+            {"{src}", cache_io::shell_quote(src)},
+            {"{out}", cache_io::shell_quote(out)},
+            {"{flags}", cache_io::shell_quote_words(flags)}
+         };
+
+         std::string cmd;
+         cmd.reserve(command.size());
+
+         for(std::size_t i = 0; i < command.size();) {
+            bool replaced = false;
+
+            // ${src} is a shell variable, not a placeholder
+            //
+            if(command[i] == '{' && (i < 1 || command[i - 1UL] != '$')) {
+               for(auto const& arg : args) {
+                  if(command.compare(i, arg.first.size(), arg.first) == 0) {
+                     cmd += arg.second;
+                     i += arg.first.size();
+                     replaced = true;
+                     break;
+                  }
+               }
+            }
+
+            if(!replaced) {
+               cmd += command[i++];
+            }
+         }
+
+         return cmd;
+      }
+   };
+
+   // opaque compiled kernel (ie: an ELF blob) and the
+   // configuration it was built with
+   //
+   struct artifact {
+      std::string binary;
+      std::string flags;
+      std::string toolchain_version;
+   };
+
+   enum class eviction_policy : std::uint8_t {
+      lru,
+      lfu
+   };
+
+   struct cache_budget {
+      std::uint64_t max_bytes = std::numeric_limits<std::uint64_t>::max();
+      std::uint64_t max_entries = std::numeric_limits<std::uint64_t>::max();
+      eviction_policy policy = eviction_policy::lru;
+   };
+
+   struct compaction_state {
+      using candidate = cache_item;
+
+      std::optional<content_hash> cursor;
+      std::uint64_t sweep_start;
+      std::uint64_t sweep_bytes;
+      std::uint64_t sweep_entries;
+      eviction_policy sweep_policy;
+
+      // the coldest records seen by the pass, a heap with the
+      // warmest on top; holds at most the largest max_records
+      // of any step in the pass
+      //
+      std::vector<candidate> coldest;
+      std::size_t coldest_capacity;
+
+      std::vector<content_hash> evict;
+
+      // next memory tier entries audit_step checks
+      //
+      std::size_t audit_shard;
+      std::size_t audit_offset;
+
+      // totals of the last complete pass
+      //
+      std::uint64_t bytes;
+      std::uint64_t entries;
+   };
+
+   using default_compact_records = std::integral_constant<std::size_t, 256UL>;
+
+   Backend backend;
+   sharded_lru<content_hash, entry> memory;
+
+   // sha256 fingerprint to source digest, in front of the
+   // fingerprint files
+   //
+   sharded_lru<content_hash, content_hash> aliases;
+
+   cache_budget budget;
+
+   // accesses are batched in memory and folded into the
+   // records by the next compact_step
+   //
+   std::mutex access_lock;
+   std::unordered_map< content_hash, std::pair<std::uint64_t, std::uint64_t> > accesses;
+
+   // keys used this run in first use order, guarded by access_lock
+   //
+   std::vector<content_hash> used;
+   std::unordered_set<content_hash> used_keys;
+
+   std::mutex compact_lock;
+   compaction_state compaction;
+
+   std::mutex compactor_lock;
+   std::condition_variable compactor_wake;
+   std::thread compactor;
+   bool compactor_stop;
+
+   std::thread prefetcher;
+   std::atomic<bool> prefetch_stop;
+
+   cache_counters counters;
+
+   std::mutex dump_lock;
+   std::condition_variable dump_wake;
+   std::thread dumper;
+   bool dump_stop;
+
+   basic_kernel_cache(std::size_t const memory_capacity = default_memory_capacity::value) :
+      backend(), memory(memory_capacity), aliases(memory_capacity), budget(), access_lock(), accesses(), used(), used_keys(),
+      compact_lock(), compaction(), compactor_lock(), compactor_wake(), compactor(), compactor_stop(false),
+      prefetcher(), prefetch_stop(false), counters(), dump_lock(), dump_wake(), dumper(), dump_stop(false) {
+      if(!fs::exists(home)) {
+         setup();
+      }
    }
 
-   static std::string generateRandomString(const std::size_t length)
-   {
-      // Define the list of possible characters
-      const std::string CHARACTERS =
-          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+   ~basic_kernel_cache() {
+      stop_stats_dump();
+      stop_prefetch();
+      stop_compactor();
+   }
 
-       // Create a random number generator
-       std::random_device rd;
-       std::mt19937 generator(rd());
+   static void setup() {
+      std::error_code ec;
+      fs::create_directories(objects, ec);
+      if(ec) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to setup", home.string()) << std::endl;
+      }
+   }
 
-       // Create a distribution to uniformly select from all
-       // characters
-       std::uniform_int_distribution<> distribution(
-           0, CHARACTERS.size() - 1);
+   bool open() {
+      return on_backend([this]() { return backend.open(home); });
+   }
 
-       // Generate the random string
-       std::string random_string;
-       for (int i = 0; i < length; ++i) {
-           random_string
-               += CHARACTERS[distribution(generator)];
-       }
+   void close() {
+      stop_stats_dump();
+      stop_prefetch();
+      stop_compactor();
+      backend.close();
+   }
 
-       return random_string;
+   static content_hash compute_hash(std::string_view const kernel_tensix_core, std::string_view const src) {
+      return sha256{}.update(kernel_tensix_core).update("\0", 1UL).update(src).finalize();
    }
 
    template<typename T>
-   void compute_key(kernel<T> const& kern, std::string & db_key) {
+   static content_hash compute_hash(kernel<T> const& kern) {
       static_assert(is_kernel_type<T>::type::value, "kernel<T> where T is not brisc, ncrisc, or crisc");
+      return compute_hash(T::value, kern.kernel_impl_src);
+   }
 
-      if(kern.host_program_location.size() < 1) {
-         std::cerr << fmt::format("Put operation failed, kernel has no host_program_location defined") << std::endl;
-         return;
-      }
+   static fs::path object_path(content_hash const& kern_hash) {
+      const std::string hex = kern_hash.hex();
+      return objects / fs::path{hex.substr(0, 2)} / fs::path{hex.substr(2)};
+   }
 
-      std::string const kernel_tensix_core{T::value};
+   static std::uint64_t now() {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::system_clock::now().time_since_epoch()).count());
+   }
 
-      fs::path tmpfnpth = home / fs::path{fmt::format("ttedsl_kernel_{}_{}", kernel_tensix_core, generateRandomString(max_path::value-14UL))};
-      db_key = tmpfnpth.string();
+   static record make_record(char const* core, std::uint64_t const bytes) {
+      record rec{};
+      std::strncpy(rec.core, core, sizeof(rec.core) - 1UL);
+      rec.bytes = bytes;
+      rec.atime = now();
+      rec.hits = 0;
+      return rec;
    }
 
-   template<typename T>
-   void compute_hash(kernel<T> const& kern, std::string & hash_value) {
-      hash_value = std::to_string(hash(kern.host_program));
+   void note_access(content_hash const& key) {
+      std::lock_guard<std::mutex> guard{access_lock};
+      auto & acc = accesses[key];
+      acc.first += 1;
+      acc.second = now();
+
+      if(used_keys.insert(key).second) {
+         used.push_back(key);
+      }
    }
 
-   void compute_hash(std::string & kern, std::string & hash_value) {
-      hash_value = std::to_string(hash(kern));
+   // counts a use of a fingerprint; the run manifest lists
+   // only sources and artifacts
+   //
+   void note_use(content_hash const& key) {
+      std::lock_guard<std::mutex> guard{access_lock};
+      auto & acc = accesses[key];
+      acc.first += 1;
+      acc.second = now();
    }
 
-   const static inline std::map<int, std::string> error_msgs = {
-      std::make_pair<int, std::string>(DB_KEYEXIST, "Put failed because key already exists"),
-      std::make_pair<int, std::string>(DB_NOTFOUND, "Get operation failed, kernel not found")
-   };
+   // adds a stored key to the run manifest without counting a use
+   //
+   void note_stored(content_hash const& key) {
+      std::lock_guard<std::mutex> guard{access_lock};
+      if(used_keys.insert(key).second) {
+         used.push_back(key);
+      }
+   }
 
-   bool handle_rc(const int rc) {
-      std::map<int, std::string>::const_iterator end_itr = error_msgs.end();
-      std::map<int, std::string>::const_iterator value_itr = error_msgs.find(rc);
-      if(value_itr != end_itr) {
-          dbobj.err(rc, value_itr->second.c_str());
-          return true;
+   // whether the file of a stored kernel exists; another
+   // process sharing the cache home may evict or purge it, and
+   // its memory tier entry is dropped when it has. lookups
+   // answered by the memory tier do not call it
+   //
+   bool stored(content_hash const& kern_hash) {
+      if(on_filesystem([&kern_hash]() { return fs::exists(object_path(kern_hash)); })) {
+         return true;
       }
 
+      memory.erase(kern_hash);
       return false;
    }
 
-   template<typename T>
-   bool contains(kernel<T> const& kern) {
-      std::string db_key;
-      compute_key(kern, db_key);
+   bool contains(content_hash const& kern_hash) {
+      op_timer timer{counters.contains};
 
-      std::string kern_hash;
-      compute_hash(kern, kern_hash);
+      const bool found = counted(counters.contains, memory.contains(kern_hash) ||
+         on_filesystem([&kern_hash]() { return fs::exists(object_path(kern_hash)); }));
+      if(found) {
+         note_access(kern_hash);
+      }
+      return found;
+   }
 
-      Dbt dbkey((void*)kern_hash.c_str(), kern_hash.size());
-      const int ret = dbobj.exists(nullptr, &dbkey, 0);
-      return handle_rc(ret);
+   template<typename T>
+   bool contains(kernel<T> const& kern) {
+      return contains(compute_hash(kern));
    }
 
+   // re-inserting a stored kernel writes no file; one stored
+   // by an earlier run is copied into the memory tier and has
+   // its record inserted again, in case it was lost
+   //
    template<typename T>
    bool put(kernel<T> const& kern) {
+      op_timer timer{counters.put};
+
+      const content_hash kern_hash = compute_hash(kern);
+      const fs::path kern_path = object_path(kern_hash);
+
+      if(counted(counters.put, stored(kern_hash))) {
+         note_stored(kern_hash);
+         if(memory.contains(kern_hash)) { return true; }
+
+         // the key is the source's digest, so the source in
+         // hand is the stored one and the next get() skips
+         // the read. the file may have been renamed into place
+         // by a put whose insert failed or never ran; insert
+         // keeps a stored record and restores a lost one
+         //
+         memory.put(kern_hash, entry{kern.kernel_impl_src, kern_path});
+         return on_backend([&]() { return backend.insert(kern_hash, make_record(T::value, kern.kernel_impl_src.size())); });
+      }
+
+      if(!on_filesystem([&]() { return cache_io::write_file(kern_path, kern.kernel_impl_src); })) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write kernel", kern_path.string()) << std::endl;
+         return false;
+      }
+
+      counters.put.bytes_written.fetch_add(kern.kernel_impl_src.size(), std::memory_order_relaxed);
 
-      std::string kern_hash;
-      compute_hash(kern, kern_hash);
+      memory.put(kern_hash, entry{kern.kernel_impl_src, kern_path});
+      note_stored(kern_hash);
 
-      Dbt dbkey((void*)kern_hash.c_str(), kern_hash.size());
+      return on_backend([&]() { return backend.insert(kern_hash, make_record(T::value, kern.kernel_impl_src.size())); });
+   }
+
+   // source text and path of a stored kernel; a memory tier
+   // miss reads the file and fills the memory tier
+   //
+   bool get(content_hash const& kern_hash, entry & kern_entry) {
+      op_timer timer{counters.get};
 
-      std::string db_key;
-      compute_key(kern, db_key);
+      if(memory.get(kern_hash, kern_entry)) {
+         counted(counters.get, true);
+         note_access(kern_hash);
+         return true;
+      }
 
-      Dbt dbdata(reinterpret_cast<void*>(const_cast<char*>(db_key.c_str())), db_key.size()+1); 
+      const fs::path kern_path = object_path(kern_hash);
 
-      const int ret = dbobj.put(nullptr, &dbkey, &dbdata, DB_NOOVERWRITE);
-      { 
-         std::ofstream ofs(db_key);
-         ofs << kern << std::endl << std::flush;
-         ofs.close();
+      std::string source;
+      if(!counted(counters.get, on_filesystem([&]() { return cache_io::read_file(kern_path, source); }))) {
+         return false;
       }
 
-      return handle_rc(ret);
+      counters.get.bytes_read.fetch_add(source.size(), std::memory_order_relaxed);
+      kern_entry = entry{std::move(source), kern_path};
+      memory.put(kern_hash, kern_entry);
+      note_access(kern_hash);
+
+      return true;
    }
 
+   // path of a stored kernel; a memory tier hit is not
+   // checked against the disk, so a caller that fails to open
+   // the path puts the kernel again, which rewrites the file
+   //
    template<typename T>
    bool get(kernel<T> const& kern, fs::path & kern_path) {
-      if(kern.host_program_location.size() < 1) {
-         std::cerr << fmt::format("Put operation failed, kernel has no host_program_location defined; use the 'host_location()' macro where the kernel_context is defined") << std::endl;
-         return -1;
+      op_timer timer{counters.get};
+
+      const content_hash kern_hash = compute_hash(kern);
+
+      kern_path = object_path(kern_hash);
+      if(!counted(counters.get, memory.contains(kern_hash) ||
+         on_filesystem([&kern_path]() { return fs::exists(kern_path); }))) {
+         return false;
       }
 
-      std::string kern_hash;
-      compute_hash(kern, kern_hash);
+      note_access(kern_hash);
+      return true;
+   }
+
+   // zero copy access to a stored kernel source; files are
+   // replaced by rename, never rewritten in place, so the
+   // mapping stays consistent while the handle is held
+   //
+   //    mapped_file src;
+   //    if(cache.get_view(kern, src)) { compile(src.view()); }
+   //
+   bool get_view(content_hash const& kern_hash, mapped_file & src) {
+      op_timer timer{counters.get};
 
-      Dbt dbkey((void*)kern_hash.c_str(), kern_hash.size());
+      if(!counted(counters.get, on_filesystem([&]() { return src.map(object_path(kern_hash)); }))) {
+         memory.erase(kern_hash);
+         return false;
+      }
 
-      char tmpfn_buf[max_path::value];
-      std::memset(tmpfn_buf, 0, max_path::value);
+      counters.get.bytes_read.fetch_add(src.size, std::memory_order_relaxed);
+      note_access(kern_hash);
+      return true;
+   }
 
-      Dbt dbdata(tmpfn_buf, max_path::value); 
+   template<typename T>
+   bool get_view(kernel<T> const& kern, mapped_file & src) {
+      return get_view(compute_hash(kern), src);
+   }
 
-      const int ret = dbobj.get(nullptr, &dbkey, &dbdata, 0);
+   static content_hash artifact_hash(content_hash const& src_hash, build_config const& config) {
+      const content_hash config_hash = config.hash();
+      return sha256{}.update(src_hash.bytes.data(), src_hash.bytes.size())
+         .update(config_hash.bytes.data(), config_hash.bytes.size()).finalize();
+   }
 
-      kern_path = std::string{tmpfn_buf};
-      return handle_rc(ret);
+   static fs::path artifact_path(content_hash const& art_hash) {
+      const std::string hex = art_hash.hex();
+      return artifacts / fs::path{hex.substr(0, 2)} / fs::path{hex.substr(2)};
    }
 
-   bool purge() {
+   // artifact files are a one line header
+   //
+   //    tt-edsl-artifact <flags bytes> <toolchain bytes> <binary bytes>
+   //
+   // followed by the flags, toolchain version and binary
+   //
+   static std::string encode_artifact(artifact const& art) {
+      std::string data = fmt::format("tt-edsl-artifact {} {} {}\n",
+         art.flags.size(), art.toolchain_version.size(), art.binary.size());
+      data.reserve(data.size() + art.flags.size() + art.toolchain_version.size() + art.binary.size());
+      data += art.flags;
+      data += art.toolchain_version;
+      data += art.binary;
+      return data;
+   }
 
-      Dbc * dbcur;
-      dbobj.cursor(nullptr, &dbcur, DB_CURSOR_BULK);
+   static bool decode_artifact(std::string const& data, artifact & art) {
+      std::size_t flags_len = 0, toolchain_len = 0, binary_len = 0;
+      int header_len = 0;
 
-      char tmp_buf[max_path::value];
-      std::memset(tmp_buf, 0, max_path::value);
+      if(std::sscanf(data.c_str(), "tt-edsl-artifact %zu %zu %zu%n", &flags_len, &toolchain_len, &binary_len, &header_len) != 3 ||
+         header_len < 1 || data.size() <= static_cast<std::size_t>(header_len) || data[header_len] != '\n' ||
+         data.size() != static_cast<std::size_t>(header_len) + 1UL + flags_len + toolchain_len + binary_len) {
+         return false;
+      }
 
-      Dbt dbkey(tmp_buf, max_path::value);
+      std::size_t offset = static_cast<std::size_t>(header_len) + 1UL;
+      art.flags = data.substr(offset, flags_len);
+      offset += flags_len;
+      art.toolchain_version = data.substr(offset, toolchain_len);
+      offset += toolchain_len;
+      art.binary = data.substr(offset, binary_len);
 
-      char tmpfn_buf[max_path::value];
-      std::memset(tmpfn_buf, 0, max_path::value);
+      return true;
+   }
 
-      Dbt dbdata(tmpfn_buf, max_path::value);
+   bool put_artifact(content_hash const& src_hash, build_config const& config, artifact const& art) {
+      op_timer timer{counters.put};
 
-      memset(&dbkey, 0, sizeof(dbkey));
-      memset(&dbdata, 0, sizeof(dbdata));
+      const content_hash art_hash = artifact_hash(src_hash, config);
+      const std::string data = encode_artifact(art);
 
-      for(int ret = dbcur->get(&dbkey, &dbdata, DB_NEXT); ret == 0; ret = dbcur->get(&dbkey, &dbdata, DB_NEXT)) {
+      counted(counters.put, false);
+      if(!on_filesystem([&]() { return cache_io::write_file(artifact_path(art_hash), data); })) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write artifact", artifact_path(art_hash).string()) << std::endl;
+         return false;
+      }
 
-         if(handle_rc(ret)) { break; }
+      counters.put.bytes_written.fetch_add(data.size(), std::memory_order_relaxed);
+      note_stored(art_hash);
 
-         fs::path pth{std::string{tmpfn_buf}};
+      return on_backend([&]() { return backend.insert(art_hash, make_record(artifact_core, data.size())); });
+   }
 
-         if(!fs::exists(pth)) { continue; }
+   bool get_artifact(content_hash const& src_hash, build_config const& config, artifact & art) {
+      op_timer timer{counters.get};
 
-         std::string kernelstr;
+      const content_hash art_hash = artifact_hash(src_hash, config);
 
-         {
-            std::ifstream ifs(pth.string());
-            ifs >> kernelstr;
-            ifs.close();
-         }
+      std::string data;
+      if(!counted(counters.get, on_filesystem([&]() { return cache_io::read_file(artifact_path(art_hash), data); }) &&
+         decode_artifact(data, art))) {
+         return false;
+      }
+
+      counters.get.bytes_read.fetch_add(data.size(), std::memory_order_relaxed);
+      note_access(art_hash);
+      return true;
+   }
+
+   // returns the cached binary for kern built with config;
+   // on a miss the source is cached, config.command is run
+   // and its output is cached
+   //
+   template<typename T>
+   bool get_or_compile(kernel<T> const& kern, build_config const& config, artifact & art) {
+      const content_hash src_hash = compute_hash(kern);
+
+      if(get_artifact(src_hash, config, art)) {
+         return true;
+      }
+
+      // the command reads the source file; put writes it again
+      // when it was evicted elsewhere
+      //
+      if(!put(kern)) {
+         return false;
+      }
+
+      // the output is named like a temporary so purge removes
+      // it if this process dies before reading it
+      //
+      const fs::path art_path = artifact_path(artifact_hash(src_hash, config));
+      const fs::path out_path = art_path.parent_path() / fs::path{fmt::format("{}{}.out.{}.{}", cache_io::temp_prefix,
+         art_path.filename().string(), ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()))};
+
+      std::error_code ec;
+      fs::create_directories(out_path.parent_path(), ec);
+
+      const std::string cmd = config.expand(object_path(src_hash).string(), out_path.string());
+
+      if(std::system(cmd.c_str()) != 0) {
+         std::cerr << fmt::format("tt-edsl error: compile failed: {}", cmd) << std::endl;
+         fs::remove(out_path, ec);
+         return false;
+      }
+
+      std::string binary;
+      if(!cache_io::read_file(out_path, binary)) {
+         std::cerr << fmt::format("tt-edsl error: compile produced no output: {}", cmd) << std::endl;
+         return false;
+      }
+
+      art = artifact{std::move(binary), config.flags, config.toolchain_version};
+
+      fs::remove(out_path, ec);
+
+      return put_artifact(src_hash, config, art);
+   }
 
-         std::string kern_hash;
-         compute_hash(kernelstr, kern_hash);
+   static fs::path fingerprint_path(content_hash const& fp) {
+      const std::string hex = fp.hex();
+      return fingerprints / fs::path{hex.substr(0, 2)} / fs::path{hex.substr(2)};
+   }
 
-         if(kern_hash.compare(std::string{tmp_buf}) != 0) {
-            dbcur->del(0);
+   // fills kern from the cache when a kernel with the same
+   // fingerprint is stored, otherwise emits statements into
+   // kern and caches it. fingerprint files are not synced; a
+   // lost one costs one more emission, and one whose source
+   // was purged or evicted is a miss and is rewritten
+   //
+   // a hit in the aliases tier costs one sha256 walk and two
+   // memory lookups; the file read is paid only when the
+   // aliases tier misses. a hit returns another kernel's
+   // source if two trees share a fingerprint, so both tiers
+   // are keyed by sha256
+   //
+   //    kernel<crisc> kern;
+   //    cache.get_or_emit(ctx, { kernel_main[{ ... }] }, kern);
+   //
+   template<typename T>
+   bool get_or_emit(kernel_context<T> & kctx, std::vector<statement> const& statements, kernel<T> & kern) {
+      const content_hash fp = fingerprint<T, sha256>(statements);
+
+      std::string hex;
+      content_hash src_hash{};
+      entry kern_entry;
+
+      bool aliased = aliases.get(fp, src_hash);
+      if(!aliased) {
+         if(on_filesystem([&]() { return cache_io::read_file(fingerprint_path(fp), hex); }) && content_hash::from_hex(hex, src_hash)) {
+            aliases.put(fp, src_hash);
+            aliased = true;
          }
       }
 
-      return handle_rc(dbcur->close());
+      if(aliased && get(src_hash, kern_entry)) {
+         note_use(fp);
+         kern.kernel_impl_src = std::move(kern_entry.source);
+         kern.host_program_location = kctx.host_program_location;
+         kctx.arena.release();
+         return true;
+      }
+
+      kern = kernel<T>{kctx, statements};
+
+      if(!put(kern)) {
+         return false;
+      }
+
+      src_hash = compute_hash(kern);
+      aliases.put(fp, src_hash);
+
+      hex = src_hash.hex();
+      const fs::path fp_path = fingerprint_path(fp);
+      if(!on_filesystem([&]() { return cache_io::write_file(fp_path, hex, false); })) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write fingerprint", fp_path.string()) << std::endl;
+         return false;
+      }
+
+      return on_backend([&]() { return backend.insert(fp, make_record(fingerprint_core, hex.size())); });
+   }
+
+   // the source digest a fingerprint file names, when the file
+   // is intact and that source is stored
+   //
+   static bool fingerprint_target(std::string const& data, content_hash & src_hash) {
+      return content_hash::from_hex(data, src_hash) && fs::exists(object_path(src_hash));
+   }
+
+   // the file a record describes
+   //
+   static fs::path record_path(content_hash const& key, cache_record const& rec) {
+      if(std::strncmp(rec.core, artifact_core, sizeof(rec.core)) == 0) { return artifact_path(key); }
+      if(std::strncmp(rec.core, fingerprint_core, sizeof(rec.core)) == 0) { return fingerprint_path(key); }
+      return object_path(key);
+   }
+
+   // an object, artifact or fingerprint file with no record,
+   // left by a put that died, or whose insert failed, after its
+   // rename. an intact one gets a record again, so it counts
+   // against the budget and can be evicted; any other one,
+   // including a fingerprint whose source is not stored, is
+   // removed
+   //
+   void recover_orphans(fs::path const& dir, std::unordered_set<content_hash> const& recorded, std::vector<cache_item> & orphans) {
+      std::error_code ec;
+      for(fs::recursive_directory_iterator itr{dir, ec}, end; !ec && itr != end; itr.increment(ec)) {
+         std::error_code file_ec;
+         content_hash key{};
+         if(!itr->is_regular_file(file_ec) ||
+            !content_hash::from_hex(itr->path().parent_path().filename().string() + itr->path().filename().string(), key) ||
+            recorded.count(key) != 0UL) {
+            continue;
+         }
+
+         std::string data;
+         if(!cache_io::read_file(itr->path(), data)) { continue; }
+         counters.purge.bytes_read.fetch_add(data.size(), std::memory_order_relaxed);
+
+         char const* core = nullptr;
+         if(dir == artifacts) {
+            artifact art;
+            core = decode_artifact(data, art) ? artifact_core : nullptr;
+         }
+         else if(dir == fingerprints) {
+            content_hash src_hash{};
+            core = fingerprint_target(data, src_hash) ? fingerprint_core : nullptr;
+         }
+         else {
+            for(char const* c : { brisc::value, ncrisc::value, crisc::value }) {
+               if(compute_hash(c, data) == key) { core = c; }
+            }
+         }
+
+         if(counted(counters.purge, core != nullptr)) {
+            orphans.push_back(cache_item{key, make_record(core, data.size())});
+         }
+         else {
+            memory.erase(key);
+            aliases.erase(key);
+            fs::remove(itr->path(), file_ec);
+         }
+      }
+   }
+
+   // drops records whose file is missing or no longer
+   // matches its key and the mismatched files, and
+   // fingerprints whose source is no longer stored; records
+   // files whose record was lost, and removes abandoned
+   // temporaries under every directory the cache writes to
+   //
+   bool purge() {
+      op_timer timer{counters.purge};
+
+      if(!on_backend([this]() { return backend.repair(); })) { return false; }
+
+      for(auto const& dir : { objects, artifacts, fingerprints, manifests }) {
+         on_filesystem([&dir]() {
+            cache_io::remove_stale_temps(dir, std::chrono::seconds{cache_io::stale_temp_age::value});
+            return true;
+         });
+      }
+
+      std::vector<content_hash> stale;
+      std::vector<content_hash> fps;
+      std::unordered_set<content_hash> recorded;
+      std::vector<cache_item> items;
+      std::optional<content_hash> cursor;
+      bool finished = false;
+
+      while(!finished) {
+         items.clear();
+         if(!on_backend([&]() { return backend.scan(cursor, default_compact_records::value, items, finished); })) { return false; }
+         if(items.empty()) { break; }
+         cursor = items.back().key;
+
+         for(auto const& item : items) {
+            recorded.insert(item.key);
+            std::string const kernel_tensix_core{item.rec.core, ::strnlen(item.rec.core, sizeof(item.rec.core))};
+            std::error_code ec;
+
+            if(kernel_tensix_core == fingerprint_core) {
+               fps.push_back(item.key);
+               continue;
+            }
+
+            if(kernel_tensix_core == artifact_core) {
+               std::string data;
+               artifact art;
+
+               const bool read = on_filesystem([&]() { return cache_io::read_file(artifact_path(item.key), data); });
+               counters.purge.bytes_read.fetch_add(data.size(), std::memory_order_relaxed);
+
+               if(!counted(counters.purge, read && decode_artifact(data, art))) {
+                  stale.push_back(item.key);
+                  fs::remove(artifact_path(item.key), ec);
+               }
+
+               continue;
+            }
+
+            const fs::path pth = object_path(item.key);
+
+            std::string kernelstr;
+            const bool read = on_filesystem([&]() { return cache_io::read_file(pth, kernelstr); });
+            counters.purge.bytes_read.fetch_add(kernelstr.size(), std::memory_order_relaxed);
+
+            if(counted(counters.purge, read && compute_hash(kernel_tensix_core, kernelstr) == item.key)) {
+               continue;
+            }
+
+            stale.push_back(item.key);
+            memory.erase(item.key);
+
+            if(read) {
+               fs::remove(pth, ec);
+            }
+         }
+      }
+
+      // fingerprints are checked once every source has been,
+      // so one naming a source dropped above is dropped too
+      //
+      for(auto const& fp : fps) {
+         std::string data;
+         content_hash src_hash{};
+
+         const bool read = on_filesystem([&]() { return cache_io::read_file(fingerprint_path(fp), data); });
+         counters.purge.bytes_read.fetch_add(data.size(), std::memory_order_relaxed);
+
+         if(counted(counters.purge, read && fingerprint_target(data, src_hash))) {
+            continue;
+         }
+
+         std::error_code ec;
+         stale.push_back(fp);
+         aliases.erase(fp);
+         fs::remove(fingerprint_path(fp), ec);
+      }
+
+      std::vector<cache_item> orphans;
+      for(auto const& dir : { objects, artifacts, fingerprints }) {
+         on_filesystem([&]() {
+            recover_orphans(dir, recorded, orphans);
+            return true;
+         });
+      }
+
+      return (stale.empty() || on_backend([&]() { return backend.erase(stale); })) &&
+         (orphans.empty() || on_backend([&]() { return backend.insert_many(orphans); }));
+   }
+
+   void set_budget(cache_budget const& b) {
+      std::lock_guard<std::mutex> guard{compact_lock};
+      budget = b;
+   }
+
+   // one bounded unit of maintenance; folds at most
+   // max_records batched accesses into the backend, checks at
+   // most max_records memory tier entries, then either evicts
+   // at most max_records entries chosen by the last pass or
+   // advances the current pass by max_records
+   //
+   bool compact_step(std::size_t const max_records = default_compact_records::value) {
+      std::lock_guard<std::mutex> guard{compact_lock};
+
+      audit_step(max_records);
+
+      bool ok = flush_accesses(max_records);
+
+      if(ok && !compaction.evict.empty()) {
+         ok = evict_step(max_records);
+      }
+      else if(ok) {
+         ok = sweep_step(max_records);
+      }
+
+      return ok;
+   }
+
+   // runs compact_step every interval until stop_compactor()
+   //
+   void start_compactor(std::chrono::milliseconds const interval, std::size_t const max_records = default_compact_records::value) {
+      stop_compactor();
+
+      {
+         std::lock_guard<std::mutex> guard{compactor_lock};
+         compactor_stop = false;
+      }
+
+      compactor = std::thread([this, interval, max_records]() {
+         std::unique_lock<std::mutex> guard{compactor_lock};
+         while(!compactor_wake.wait_for(guard, interval, [this]() { return compactor_stop; })) {
+            guard.unlock();
+            compact_step(max_records);
+            guard.lock();
+         }
+      });
+   }
+
+   void stop_compactor() {
+      {
+         std::lock_guard<std::mutex> guard{compactor_lock};
+         compactor_stop = true;
+      }
+      compactor_wake.notify_all();
+
+      if(compactor.joinable()) {
+         compactor.join();
+      }
+   }
+
+   // stores every kernel not already cached: each file is
+   // written and fsync'd under a temporary name, the batch is
+   // renamed into place, each directory it landed in is
+   // fsync'd once, and the records are inserted with one
+   // backend insert_many
+   //
+   template<typename T>
+   bool put_many(std::vector< kernel<T> > const& kerns) {
+      op_timer timer{counters.put};
+
+      struct pending {
+         content_hash key;
+         kernel<T> const* kern;
+         fs::path tmp_path;
+      };
+
+      std::vector<pending> batch;
+      batch.reserve(kerns.size());
+
+      // records for every written file, and for files stored by
+      // an earlier run, whose records may have been lost (see put)
+      //
+      std::vector<cache_item> items;
+      items.reserve(kerns.size());
+
+      std::unordered_set<content_hash> seen;
+
+      for(auto const& kern : kerns) {
+         const content_hash kern_hash = compute_hash(kern);
+         if(!seen.insert(kern_hash).second) { continue; }
+
+         note_stored(kern_hash);
+
+         if(counted(counters.put, stored(kern_hash))) {
+            if(!memory.contains(kern_hash)) {
+               items.push_back(cache_item{kern_hash, make_record(T::value, kern.kernel_impl_src.size())});
+               memory.put(kern_hash, entry{kern.kernel_impl_src, object_path(kern_hash)});
+            }
+            continue;
+         }
+
+         batch.push_back(pending{kern_hash, &kern, fs::path{}});
+      }
+
+      if(batch.empty()) {
+         return items.empty() || on_backend([&]() { return backend.insert_many(items); });
+      }
+
+      const bool ok = on_filesystem([&batch]() {
+         bool written = true;
+         for(auto & p : batch) {
+            written = written && cache_io::write_temp(object_path(p.key), p.kern->kernel_impl_src, true, p.tmp_path);
+         }
+
+         std::vector<fs::path> renamed;
+         renamed.reserve(batch.size());
+
+         for(auto & p : batch) {
+            if(p.tmp_path.empty()) { continue; }
+
+            std::error_code ec;
+            if(!written || ::rename(p.tmp_path.c_str(), object_path(p.key).c_str()) != 0) {
+               fs::remove(p.tmp_path, ec);
+               written = false;
+               continue;
+            }
+
+            renamed.push_back(object_path(p.key));
+         }
+
+         return cache_io::sync_parents(renamed) && written;
+      });
+
+      if(!ok) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write kernels", objects.string()) << std::endl;
+         return false;
+      }
+
+      for(auto const& p : batch) {
+         items.push_back(cache_item{p.key, make_record(T::value, p.kern->kernel_impl_src.size())});
+         memory.put(p.key, entry{p.kern->kernel_impl_src, object_path(p.key)});
+         counters.put.bytes_written.fetch_add(p.kern->kernel_impl_src.size(), std::memory_order_relaxed);
+      }
+
+      return on_backend([&]() { return backend.insert_many(items); });
+   }
+
+   // looks up every key; entries[i].path is empty when keys[i]
+   // is not cached. sources are content addressed, so the batch
+   // needs no backend round trip: the memory tier answers the
+   // keys it holds, then one pass over the misses asks the
+   // kernel to read every file ahead and a second reads them,
+   // so the reads overlap rather than each waiting on the disk.
+   // returns the number found
+   //
+   std::size_t get_many(std::vector<content_hash> const& keys, std::vector<entry> & entries) {
+      op_timer timer{counters.get};
+
+      entries.clear();
+      entries.resize(keys.size());
+
+      std::size_t found = 0;
+      std::vector<std::size_t> misses;
+
+      for(std::size_t i = 0; i < keys.size(); ++i) {
+         if(!memory.get(keys[i], entries[i])) {
+            misses.push_back(i);
+            continue;
+         }
+
+         counted(counters.get, true);
+         note_access(keys[i]);
+         ++found;
+      }
+
+      if(misses.empty()) {
+         return found;
+      }
+
+      on_filesystem([&]() {
+         for(auto const i : misses) {
+            cache_io::will_need(object_path(keys[i]));
+         }
+
+         for(auto const i : misses) {
+            const fs::path kern_path = object_path(keys[i]);
+
+            std::string source;
+            if(!counted(counters.get, cache_io::read_file(kern_path, source))) { continue; }
+
+            counters.get.bytes_read.fetch_add(source.size(), std::memory_order_relaxed);
+            entries[i] = entry{std::move(source), kern_path};
+            memory.put(keys[i], entries[i]);
+            note_access(keys[i]);
+            ++found;
+         }
+
+         return true;
+      });
+
+      return found;
+   }
+
+   template<typename T>
+   std::size_t get_many(std::vector< kernel<T> > const& kerns, std::vector<entry> & entries) {
+      std::vector<content_hash> keys;
+      keys.reserve(kerns.size());
+
+      for(auto const& kern : kerns) {
+         keys.push_back(compute_hash(kern));
+      }
+
+      return get_many(keys, entries);
+   }
+
+   // keys put or looked up so far, in first use order
+   //
+   std::vector<content_hash> manifest() {
+      std::lock_guard<std::mutex> guard{access_lock};
+      return used;
+   }
+
+   static fs::path manifest_path(std::string_view const app) {
+      return manifests / fs::path{std::string{app}}.filename();
+   }
+
+   // manifest files hold one hex digest per line
+   //
+   bool save_manifest(std::string_view const app) {
+      const std::vector<content_hash> keys = manifest();
+
+      std::string data;
+      data.reserve(keys.size() * (2UL * content_hash::digest_size::value + 1UL));
+      for(auto const& key : keys) {
+         data += key.hex();
+         data += '\n';
+      }
+
+      if(!cache_io::write_file(manifest_path(app), data)) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write manifest", manifest_path(app).string()) << std::endl;
+         return false;
+      }
+
+      return true;
+   }
+
+   // malformed lines are skipped
+   //
+   static bool load_manifest(std::string_view const app, std::vector<content_hash> & keys) {
+      std::string data;
+      if(!cache_io::read_file(manifest_path(app), data)) {
+         return false;
+      }
+
+      keys.clear();
+
+      std::string_view rest{data};
+      while(!rest.empty()) {
+         const std::size_t eol = rest.find('\n');
+         const std::string_view line = rest.substr(0, eol);
+         rest = (eol == std::string_view::npos) ? std::string_view{} : rest.substr(eol + 1UL);
+
+         content_hash key{};
+         if(content_hash::from_hex(line, key)) {
+            keys.push_back(key);
+         }
+      }
+
+      return true;
+   }
+
+   // loads every listed source into the memory tier on a
+   // background thread, in manifest order; artifact files are
+   // pulled into the page cache. lookups made while it runs
+   // simply read the files themselves
+   //
+   //    kernel_cache cache;
+   //    cache.open();
+   //    cache.prefetch("my_service");
+   //    ... build kernels ...
+   //    cache.save_manifest("my_service");
+   //
+   void prefetch(std::vector<content_hash> keys) {
+      stop_prefetch();
+      prefetch_stop.store(false);
+
+      prefetcher = std::thread([this, keys = std::move(keys)]() {
+         for(auto const& key : keys) {
+            if(prefetch_stop.load(std::memory_order_relaxed)) { return; }
+            if(memory.contains(key)) { continue; }
+
+            const fs::path kern_path = object_path(key);
+
+            std::string source;
+            if(cache_io::read_file(kern_path, source)) {
+               memory.put(key, entry{std::move(source), kern_path});
+               continue;
+            }
+
+            cache_io::will_need(artifact_path(key));
+         }
+      });
+   }
+
+   bool prefetch(std::string_view const app) {
+      std::vector<content_hash> keys;
+      if(!load_manifest(app, keys)) {
+         return false;
+      }
+
+      prefetch(std::move(keys));
+      return true;
+   }
+
+   // blocks until the running prefetch is done
+   //
+   void wait_prefetch() {
+      if(prefetcher.joinable()) {
+         prefetcher.join();
+      }
+   }
+
+   void stop_prefetch() {
+      prefetch_stop.store(true);
+      wait_prefetch();
+   }
+
+   // counters since construction or the last reset_stats()
+   //
+   //    cache_stats s = cache.stats();
+   //    double hit_rate = double(s.get.hits) / double(s.get.calls);
+   //    std::uint64_t p99 = s.get.percentile_ns(0.99);
+   //
+   cache_stats stats() const {
+      cache_stats s{};
+      s.get = counters.get.snapshot();
+      s.put = counters.put.snapshot();
+      s.contains = counters.contains.snapshot();
+      s.purge = counters.purge.snapshot();
+      s.memory_hits = memory.hits.load(std::memory_order_relaxed);
+      s.memory_misses = memory.misses.load(std::memory_order_relaxed);
+      s.memory_evictions = memory.evictions.load(std::memory_order_relaxed);
+      s.backend_ns = counters.backend_ns.load(std::memory_order_relaxed);
+      s.filesystem_ns = counters.filesystem_ns.load(std::memory_order_relaxed);
+      s.backend_errors = counters.backend_errors.load(std::memory_order_relaxed);
+      return s;
+   }
+
+   void reset_stats() {
+      for(operation_counters * op : { &counters.get, &counters.put, &counters.contains, &counters.purge }) {
+         op->calls.store(0, std::memory_order_relaxed);
+         op->hits.store(0, std::memory_order_relaxed);
+         op->misses.store(0, std::memory_order_relaxed);
+         op->bytes_read.store(0, std::memory_order_relaxed);
+         op->bytes_written.store(0, std::memory_order_relaxed);
+         op->total_ns.store(0, std::memory_order_relaxed);
+         for(auto & c : op->latency.counts) { c.store(0, std::memory_order_relaxed); }
+      }
+
+      memory.hits.store(0, std::memory_order_relaxed);
+      memory.misses.store(0, std::memory_order_relaxed);
+      memory.evictions.store(0, std::memory_order_relaxed);
+      counters.backend_ns.store(0, std::memory_order_relaxed);
+      counters.filesystem_ns.store(0, std::memory_order_relaxed);
+      counters.backend_errors.store(0, std::memory_order_relaxed);
+   }
+
+   // replaces path with stats().json() every interval until
+   // stop_stats_dump(), and once more when stopped
+   //
+   void start_stats_dump(fs::path const& path, std::chrono::milliseconds const interval) {
+      stop_stats_dump();
+
+      {
+         std::lock_guard<std::mutex> guard{dump_lock};
+         dump_stop = false;
+      }
+
+      dumper = std::thread([this, path, interval]() {
+         std::unique_lock<std::mutex> guard{dump_lock};
+         while(!dump_wake.wait_for(guard, interval, [this]() { return dump_stop; })) {
+            guard.unlock();
+            cache_io::write_file(path, stats().json(), false);
+            guard.lock();
+         }
+
+         cache_io::write_file(path, stats().json(), false);
+      });
+   }
+
+   void stop_stats_dump() {
+      {
+         std::lock_guard<std::mutex> guard{dump_lock};
+         dump_stop = true;
+      }
+      dump_wake.notify_all();
+
+      if(dumper.joinable()) {
+         dumper.join();
+      }
+   }
+
+private:
+
+   // times one public operation into its counters
+   //
+   struct op_timer {
+      operation_counters & op;
+      std::chrono::steady_clock::time_point start;
+
+      explicit op_timer(operation_counters & o) : op(o), start(std::chrono::steady_clock::now()) {
+         op.calls.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      ~op_timer() {
+         const std::uint64_t ns = elapsed_ns(start);
+         op.total_ns.fetch_add(ns, std::memory_order_relaxed);
+         op.latency.record(ns);
+      }
+   };
+
+   static std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point const start) {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now() - start).count());
+   }
+
+   static bool counted(operation_counters & op, bool const hit) {
+      (hit ? op.hits : op.misses).fetch_add(1, std::memory_order_relaxed);
+      return hit;
+   }
+
+   template<typename F>
+   bool on_backend(F && f) {
+      const auto start = std::chrono::steady_clock::now();
+      const bool ok = f();
+      counters.backend_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+      if(!ok) {
+         counters.backend_errors.fetch_add(1, std::memory_order_relaxed);
+      }
+      return ok;
+   }
+
+   template<typename F>
+   bool on_filesystem(F && f) {
+      const auto start = std::chrono::steady_clock::now();
+      const bool ok = f();
+      counters.filesystem_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+      return ok;
+   }
+
+   // moves at most max_records batched accesses into batch
+   //
+   void take_accesses(std::size_t const max_records, std::vector<cache_access> & batch) {
+      std::lock_guard<std::mutex> guard{access_lock};
+      batch.reserve((accesses.size() < max_records) ? accesses.size() : max_records);
+
+      for(auto itr = accesses.begin(); itr != accesses.end() && batch.size() < max_records;) {
+         batch.push_back(cache_access{itr->first, itr->second.first, itr->second.second});
+         itr = accesses.erase(itr);
+      }
+   }
+
+   bool flush_accesses(std::size_t const max_records) {
+      std::vector<cache_access> batch;
+      take_accesses(max_records, batch);
+
+      // access counts are advisory; a failed batch is dropped
+      //
+      return batch.empty() || on_backend([&]() { return backend.touch(batch); });
+   }
+
+   // memory tier hits are not checked against the disk, so an
+   // entry whose file another process sharing the cache home
+   // evicted is dropped here unless a failed read or a put
+   // drops it first. checks at most max_records entries, one
+   // shard at a time
+   //
+   void audit_step(std::size_t const max_records) {
+      std::vector< std::pair<content_hash, fs::path> > checked;
+      checked.reserve(max_records);
+
+      const std::size_t visited = memory.visit(compaction.audit_shard, compaction.audit_offset, max_records,
+         [&checked](content_hash const& key, entry const& e) { checked.emplace_back(key, e.path); });
+
+      compaction.audit_offset += visited;
+      if(visited < max_records) {
+         compaction.audit_shard = (compaction.audit_shard + 1UL) % memory.shard_count();
+         compaction.audit_offset = 0;
+      }
+
+      for(auto const& c : checked) {
+         if(!on_filesystem([&c]() { return fs::exists(c.second); })) {
+            memory.erase(c.first);
+         }
+      }
+   }
+
+   static bool colder(eviction_policy const policy, cache_item const& a, cache_item const& b) {
+      if(policy == eviction_policy::lfu && a.rec.hits != b.rec.hits) {
+         return a.rec.hits < b.rec.hits;
+      }
+
+      return a.rec.atime < b.rec.atime;
+   }
+
+   // advances the pass by at most max_records records, keeping
+   // the coldest of them; a finished pass over budget fills
+   // compaction.evict with at most coldest_capacity victims,
+   // coldest first, and a later pass picks any more needed
+   //
+   bool sweep_step(std::size_t const max_records) {
+      if(!compaction.cursor && compaction.coldest.empty()) {
+         compaction.sweep_start = now();
+         compaction.sweep_bytes = 0;
+         compaction.sweep_entries = 0;
+         compaction.sweep_policy = budget.policy;
+         compaction.coldest_capacity = 0;
+      }
+
+      std::vector<cache_item> visited;
+      bool finished = false;
+
+      if(!on_backend([&]() { return backend.scan(compaction.cursor, max_records, visited, finished); })) {
+         return false;
+      }
+
+      auto & coldest = compaction.coldest;
+      const eviction_policy policy = compaction.sweep_policy;
+      const auto rank = [policy](cache_item const& a, cache_item const& b) { return colder(policy, a, b); };
+
+      if(compaction.coldest_capacity < max_records) {
+         compaction.coldest_capacity = max_records;
+      }
+
+      for(auto const& c : visited) {
+         compaction.sweep_bytes += c.rec.bytes;
+         compaction.sweep_entries += 1;
+
+         if(coldest.size() < compaction.coldest_capacity) {
+            coldest.push_back(c);
+            std::push_heap(coldest.begin(), coldest.end(), rank);
+         }
+         else if(!coldest.empty() && colder(policy, c, coldest.front())) {
+            std::pop_heap(coldest.begin(), coldest.end(), rank);
+            coldest.back() = c;
+            std::push_heap(coldest.begin(), coldest.end(), rank);
+         }
+      }
+      if(!visited.empty()) {
+         compaction.cursor = visited.back().key;
+      }
+
+      if(!finished) { return true; }
+
+      compaction.bytes = compaction.sweep_bytes;
+      compaction.entries = compaction.sweep_entries;
+
+      if(budget.max_bytes < compaction.bytes || budget.max_entries < compaction.entries) {
+         // records were read over many steps; uses of the
+         // candidates still batched in memory are folded into
+         // them before they are ranked
+         //
+         {
+            std::lock_guard<std::mutex> guard{access_lock};
+            for(auto & c : coldest) {
+               const auto itr = accesses.find(c.key);
+               if(itr == accesses.end()) { continue; }
+
+               c.rec.hits += itr->second.first;
+               c.rec.atime = (c.rec.atime < itr->second.second) ? itr->second.second : c.rec.atime;
+            }
+         }
+
+         std::sort(coldest.begin(), coldest.end(), rank);
+
+         std::uint64_t bytes = compaction.bytes;
+         std::uint64_t entries = compaction.entries;
+
+         for(auto const& c : coldest) {
+            if(bytes <= budget.max_bytes && entries <= budget.max_entries) { break; }
+            compaction.evict.push_back(c.key);
+            bytes -= c.rec.bytes;
+            entries -= 1;
+         }
+      }
+
+      coldest.clear();
+      compaction.cursor.reset();
+
+      return true;
+   }
+
+   // evicts at most max_records entries chosen by the last
+   // pass, coldest first; entries used since that pass began
+   // are kept, including uses not yet flushed to the backend
+   //
+   bool evict_step(std::size_t const max_records) {
+      const std::size_t n = (compaction.evict.size() < max_records) ? compaction.evict.size() : max_records;
+      const auto first = compaction.evict.begin();
+      const auto last = first + static_cast<std::ptrdiff_t>(n);
+
+      // erase_idle keeps records touched since the pass began;
+      // victims used since then whose use is still batched in
+      // memory are kept here
+      //
+      std::vector<content_hash> keys;
+      keys.reserve(n);
+      {
+         std::lock_guard<std::mutex> guard{access_lock};
+         for(auto itr = first; itr != last; ++itr) {
+            const auto acc = accesses.find(*itr);
+            if(acc != accesses.end() && compaction.sweep_start < acc->second.second) { continue; }
+            keys.push_back(*itr);
+         }
+      }
+
+      std::vector<cache_item> removed;
+
+      if(!keys.empty() && !on_backend([&]() { return backend.erase_idle(keys, compaction.sweep_start, removed); })) {
+         return false;
+      }
+
+      // entries kept by erase_idle stay in the memory tier
+      //
+      for(auto const& item : removed) {
+         memory.erase(item.key);
+         aliases.erase(item.key);
+      }
+      compaction.evict.erase(first, last);
+
+      // files go once the records are gone
+      //
+      for(auto const& item : removed) {
+         std::error_code ec;
+         fs::remove(record_path(item.key, item.rec), ec);
+      }
+
+      return true;
    }
 
 };
@@ -0,0 +1,400 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_CACHE_BDB_HPP__
+#define __TT_EDSL_CACHE_BDB_HPP__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <db_cxx.h>
+
+#include "cache.hpp"
+
+namespace tt { namespace dsl {
+
+struct berkeleydb_backend {
+
+   // berkeley database kernel_cache backend
+   //
+   // records live in a btree, $HOME/.tt_edsl/cache.db, keyed
+   // by the hex digest. the database lives in a DbEnv shared
+   // by every process using the cache home (locking, logging,
+   // transactions, multiversion reads); every call runs in
+   // one transaction and scans read a snapshot
+   //
+
+   using env_flags = std::integral_constant<std::uint32_t,
+      DB_CREATE | DB_INIT_LOCK | DB_INIT_LOG | DB_INIT_MPOOL | DB_INIT_TXN | DB_THREAD | DB_REGISTER | DB_RECOVER>;
+   using db_flags = std::integral_constant<std::uint32_t,
+      DB_CREATE | DB_THREAD | DB_AUTO_COMMIT | DB_MULTIVERSION>;
+   using max_deadlock_retries = std::integral_constant<std::size_t, 8UL>;
+   using max_path = std::integral_constant<std::size_t, 260UL>;
+
+   DbEnv env;
+   Db dbobj;
+
+   berkeleydb_backend() : env(0), dbobj(&env, 0) {}
+
+   bool open(fs::path const& home) {
+      try {
+         env.set_error_stream(&std::cerr);
+         env.set_lk_detect(DB_LOCK_DEFAULT);
+         env.open(home.string().c_str(), env_flags::value, 0);
+
+         dbobj.set_error_stream(&std::cerr);
+         dbobj.open(nullptr, "cache.db", nullptr, DB_BTREE, db_flags::value, 0);
+      }
+      catch(DbException &e) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to open database: {}", home.string(), e.what()) << std::endl;
+         return false;
+      }
+
+      return true;
+   }
+
+   void close() {
+      dbobj.close(0);
+      env.close(0);
+   }
+
+   // DB_KEYEXIST and DB_NOTFOUND are expected outcomes; any
+   // other nonzero code (ie: DB_LOCK_DEADLOCK once retries run
+   // out, ENOSPC, DB_RUNRECOVERY) is reported and fails the call
+   //
+   bool succeeded(const int rc, char const* op) {
+      if(rc == 0 || rc == DB_KEYEXIST || rc == DB_NOTFOUND) {
+         return true;
+      }
+
+      dbobj.err(rc, "tt-edsl error: %s failed", op);
+      return false;
+   }
+
+   bool insert(content_hash const& key, cache_record const& rec) {
+      const std::string hex = key.hex();
+      cache_record value = rec;
+
+      Dbt dbkey(reinterpret_cast<void*>(const_cast<char*>(hex.c_str())), hex.size());
+      Dbt dbdata(&value, sizeof(cache_record));
+
+      const int ret = transact([&](DbTxn * txn) {
+         const int rc = dbobj.put(txn, &dbkey, &dbdata, DB_NOOVERWRITE);
+         return (rc == DB_KEYEXIST) ? 0 : rc;
+      });
+
+      return succeeded(ret, "insert");
+   }
+
+   // one DB_MULTIPLE_KEY bulk put in one transaction; bulk puts
+   // do not take DB_NOOVERWRITE, so keys already stored are
+   // dropped from the batch first, under write locks held until
+   // the commit, and keep their atime and hits
+   //
+   bool insert_many(std::vector<cache_item> const& items) {
+      if(items.empty()) { return true; }
+
+      // DB_MULTIPLE_KEY buffers are u_int32_t aligned and sized
+      // in 1KiB multiples; each pair costs 4 offsets of overhead
+      //
+      std::size_t bulk_bytes = 1024UL;
+      for(std::size_t i = 0; i < items.size(); ++i) {
+         bulk_bytes += 2UL * content_hash::digest_size::value + sizeof(cache_record) + 4UL * sizeof(std::uint32_t);
+      }
+      bulk_bytes = ((bulk_bytes + 1023UL) / 1024UL) * 1024UL;
+
+      std::vector<std::uint32_t> bulk_buf(bulk_bytes / sizeof(std::uint32_t), 0U);
+
+      const int ret = transact([&](DbTxn * txn) {
+         std::fill(bulk_buf.begin(), bulk_buf.end(), 0U);
+
+         Dbt bulk(bulk_buf.data(), static_cast<std::uint32_t>(bulk_bytes));
+         bulk.set_ulen(static_cast<std::uint32_t>(bulk_bytes));
+         bulk.set_flags(DB_DBT_USERMEM);
+
+         std::size_t added = 0;
+         {
+            DbMultipleKeyDataBuilder builder(bulk);
+
+            for(auto const& item : items) {
+               std::string hex = item.key.hex();
+               Dbt dbkey(&hex[0], hex.size());
+
+               const int rc = dbobj.exists(txn, &dbkey, DB_RMW);
+               if(rc == 0) { continue; }
+               if(rc != DB_NOTFOUND) { return rc; }
+
+               cache_record rec = item.rec;
+               builder.append(&hex[0], hex.size(), &rec, sizeof(cache_record));
+               ++added;
+            }
+         }
+
+         if(added < 1) { return 0; }
+
+         Dbt unused;
+         return dbobj.put(txn, &bulk, &unused, DB_MULTIPLE_KEY);
+      });
+
+      return succeeded(ret, "insert_many");
+   }
+
+   bool touch(std::vector<cache_access> const& accesses) {
+      const int ret = transact([&](DbTxn * txn) {
+         for(auto const& acc : accesses) {
+            const std::string hex = acc.key.hex();
+            cache_record rec{};
+
+            Dbt dbkey(reinterpret_cast<void*>(const_cast<char*>(hex.c_str())), hex.size());
+
+            const int rc = get_record(txn, dbkey, rec);
+            if(rc == DB_NOTFOUND) { continue; }
+            if(rc != 0) { return rc; }
+
+            rec.hits += acc.hits;
+            rec.atime = (rec.atime < acc.atime) ? acc.atime : rec.atime;
+
+            Dbt dbput(&rec, sizeof(cache_record));
+            const int prc = dbobj.put(txn, &dbkey, &dbput, 0);
+            if(prc != 0) { return prc; }
+         }
+
+         return 0;
+      });
+
+      return succeeded(ret, "touch");
+   }
+
+   bool scan(std::optional<content_hash> const& after, std::size_t const max_records,
+      std::vector<cache_item> & items, bool & finished) {
+
+      const std::string after_hex = after ? after->hex() : std::string{};
+      const std::size_t base = items.size();
+
+      const int ret = transact([&](DbTxn * txn) {
+         items.resize(base);
+         finished = false;
+
+         Dbc * dbcur;
+         dbobj.cursor(txn, &dbcur, 0);
+
+         char key_buf[max_path::value];
+         std::memset(key_buf, 0, max_path::value);
+         std::memcpy(key_buf, after_hex.data(), after_hex.size());
+
+         Dbt dbkey(key_buf, after_hex.size());
+         dbkey.set_ulen(max_path::value);
+         dbkey.set_flags(DB_DBT_USERMEM);
+
+         // a value too large for value_buf is read partially, so
+         // it fails the size check below instead of stopping the
+         // scan with DB_BUFFER_SMALL
+         //
+         char value_buf[max_path::value];
+         Dbt dbdata(value_buf, max_path::value);
+         dbdata.set_ulen(max_path::value);
+         dbdata.set_dlen(max_path::value);
+         dbdata.set_doff(0);
+         dbdata.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+
+         // cursors must be closed before the transaction aborts
+         //
+         int rc = 0;
+         try {
+            rc = after_hex.empty() ?
+               dbcur->get(&dbkey, &dbdata, DB_FIRST) :
+               dbcur->get(&dbkey, &dbdata, DB_SET_RANGE);
+
+            // DB_SET_RANGE lands on the last key of the previous scan
+            //
+            if(rc == 0 && !after_hex.empty() && std::string{key_buf, dbkey.get_size()} == after_hex) {
+               rc = dbcur->get(&dbkey, &dbdata, DB_NEXT);
+            }
+
+            for(; rc == 0 && items.size() - base < max_records; rc = dbcur->get(&dbkey, &dbdata, DB_NEXT)) {
+               cache_item item{};
+               if(dbdata.get_size() != sizeof(cache_record) ||
+                  !content_hash::from_hex(std::string_view{key_buf, dbkey.get_size()}, item.key)) { continue; }
+
+               std::memcpy(&item.rec, value_buf, sizeof(cache_record));
+               items.push_back(item);
+            }
+         }
+         catch(DbException &e) {
+            dbcur->close();
+            throw;
+         }
+
+         dbcur->close();
+
+         finished = (rc == DB_NOTFOUND);
+         return (rc == 0 || rc == DB_NOTFOUND) ? 0 : rc;
+      }, DB_TXN_SNAPSHOT);
+
+      return succeeded(ret, "scan");
+   }
+
+   bool erase(std::vector<content_hash> const& keys) {
+      const int ret = transact([&](DbTxn * txn) {
+         for(auto const& key : keys) {
+            const std::string hex = key.hex();
+            Dbt dbkey(reinterpret_cast<void*>(const_cast<char*>(hex.c_str())), hex.size());
+
+            const int rc = dbobj.del(txn, &dbkey, 0);
+            if(rc != 0 && rc != DB_NOTFOUND) { return rc; }
+         }
+
+         return 0;
+      });
+
+      return succeeded(ret, "erase");
+   }
+
+   bool erase_idle(std::vector<content_hash> const& keys, std::uint64_t const since, std::vector<cache_item> & erased) {
+      const std::size_t base = erased.size();
+
+      const int ret = transact([&](DbTxn * txn) {
+         erased.resize(base);
+
+         for(auto const& key : keys) {
+            const std::string hex = key.hex();
+            cache_item item{key, cache_record{}};
+
+            Dbt dbkey(reinterpret_cast<void*>(const_cast<char*>(hex.c_str())), hex.size());
+
+            const int rc = get_record(txn, dbkey, item.rec);
+            if(rc == DB_NOTFOUND) { continue; }
+            if(rc != 0) { return rc; }
+
+            if(since < item.rec.atime) { continue; }
+
+            const int drc = dbobj.del(txn, &dbkey, 0);
+            if(drc != 0) { return drc; }
+
+            erased.push_back(item);
+         }
+
+         return 0;
+      });
+
+      return succeeded(ret, "erase_idle");
+   }
+
+   bool repair() {
+      const int ret = transact([this](DbTxn * txn) {
+         Dbc * dbcur;
+         dbobj.cursor(txn, &dbcur, DB_CURSOR_BULK);
+
+         char key_buf[max_path::value];
+         std::memset(key_buf, 0, max_path::value);
+
+         Dbt dbkey(key_buf, max_path::value);
+         dbkey.set_ulen(max_path::value);
+         dbkey.set_flags(DB_DBT_USERMEM);
+
+         char value_buf[max_path::value];
+         std::memset(value_buf, 0, max_path::value);
+
+         Dbt dbdata(value_buf, max_path::value);
+         dbdata.set_ulen(max_path::value);
+         dbdata.set_dlen(max_path::value);
+         dbdata.set_doff(0);
+         dbdata.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+
+         int rc = 0;
+         try {
+            for(rc = dbcur->get(&dbkey, &dbdata, DB_NEXT); rc == 0; rc = dbcur->get(&dbkey, &dbdata, DB_NEXT)) {
+               content_hash key{};
+               if(!content_hash::from_hex(std::string_view{key_buf, dbkey.get_size()}, key) ||
+                  dbdata.get_size() != sizeof(cache_record)) {
+                  dbcur->del(0);
+               }
+            }
+         }
+         catch(DbException &e) {
+            dbcur->close();
+            throw;
+         }
+
+         dbcur->close();
+         return (rc == DB_NOTFOUND) ? 0 : rc;
+      });
+
+      return succeeded(ret, "repair");
+   }
+
+private:
+
+   // reads the record under key with a write lock; a value
+   // of any other size reads as DB_NOTFOUND. USERMEM alone
+   // throws DbMemoryException on an oversized value, so it is
+   // read partially, one byte past a record, as scan does
+   //
+   int get_record(DbTxn * txn, Dbt & dbkey, cache_record & rec) {
+      char value_buf[sizeof(cache_record) + 1];
+      Dbt dbdata(value_buf, sizeof(value_buf));
+      dbdata.set_ulen(sizeof(value_buf));
+      dbdata.set_dlen(sizeof(value_buf));
+      dbdata.set_doff(0);
+      dbdata.set_flags(DB_DBT_USERMEM | DB_DBT_PARTIAL);
+
+      const int rc = dbobj.get(txn, &dbkey, &dbdata, DB_RMW);
+      if(rc != 0) { return rc; }
+      if(dbdata.get_size() != sizeof(cache_record)) { return DB_NOTFOUND; }
+
+      std::memcpy(&rec, value_buf, sizeof(cache_record));
+      return 0;
+   }
+
+   // runs f(txn) in a transaction; commits when f returns 0,
+   // retries on deadlock, aborts otherwise
+   //
+   template<typename F>
+   int transact(F && f, std::uint32_t const flags = 0) {
+      int ret = 0;
+
+      for(std::size_t attempt = 0; attempt < max_deadlock_retries::value; ++attempt) {
+         DbTxn * txn = nullptr;
+
+         try {
+            env.txn_begin(nullptr, &txn, flags);
+            ret = f(txn);
+
+            if(ret == 0) {
+               ret = txn->commit(0);
+               txn = nullptr;
+            }
+         }
+         catch(DbException &e) {
+            ret = e.get_errno();
+         }
+
+         if(txn != nullptr) {
+            txn->abort();
+         }
+
+         if(ret != DB_LOCK_DEADLOCK) {
+            break;
+         }
+      }
+
+      return ret;
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
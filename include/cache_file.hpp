@@ -0,0 +1,262 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_CACHE_FILE_HPP__
+#define __TT_EDSL_CACHE_FILE_HPP__
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "cache.hpp"
+
+namespace tt { namespace dsl {
+
+struct flat_file_backend {
+
+   // dependency free kernel_cache backend
+   //
+   // every record is a file, $HOME/.tt_edsl/records/<2 hex>/<62 hex>,
+   // holding the raw cache_record. the 256 shard directories
+   // keep directory sizes small and give scan its key order
+   // (shards in order, names sorted within a shard)
+   //
+   // records are written to a temporary name and renamed into
+   // place, so concurrent processes sharing the cache home
+   // only ever see whole records. inserts are fsync'd, and a
+   // batch fsyncs each directory it renamed records into once;
+   // access folding is advisory and not synced, a lost update
+   // only ages an entry
+   //
+
+   using shards = std::integral_constant<std::size_t, 256UL>;
+
+   using stale_temp_age = cache_io::stale_temp_age;
+
+   fs::path records;
+
+   flat_file_backend() : records() {}
+
+   bool open(fs::path const& home) {
+      records = home / fs::path{"records"};
+
+      std::error_code ec;
+      fs::create_directories(records, ec);
+      if(ec) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to open records: {}", records.string(), ec.message()) << std::endl;
+         return false;
+      }
+
+      return true;
+   }
+
+   void close() {}
+
+   fs::path record_path(content_hash const& key) const {
+      const std::string hex = key.hex();
+      return records / fs::path{hex.substr(0, 2)} / fs::path{hex.substr(2)};
+   }
+
+   bool insert(content_hash const& key, cache_record const& rec) {
+      const fs::path pth = record_path(key);
+      if(fs::exists(pth)) { return true; }
+
+      if(!cache_io::write_file(pth, encode(rec))) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write record", pth.string()) << std::endl;
+         return false;
+      }
+
+      return true;
+   }
+
+   bool insert_many(std::vector<cache_item> const& items) {
+      std::vector< std::pair<fs::path, fs::path> > renames;
+      renames.reserve(items.size());
+
+      bool ok = true;
+      for(auto const& item : items) {
+         fs::path pth = record_path(item.key);
+         if(fs::exists(pth)) { continue; }
+
+         fs::path tmp_path;
+         ok = cache_io::write_temp(pth, encode(item.rec), true, tmp_path);
+         if(!ok) { break; }
+
+         renames.emplace_back(std::move(tmp_path), std::move(pth));
+      }
+
+      std::vector<fs::path> renamed;
+      renamed.reserve(renames.size());
+
+      for(auto const& r : renames) {
+         std::error_code ec;
+         if(!ok || ::rename(r.first.c_str(), r.second.c_str()) != 0) {
+            fs::remove(r.first, ec);
+            ok = false;
+            continue;
+         }
+
+         renamed.push_back(r.second);
+      }
+
+      ok = cache_io::sync_parents(renamed) && ok;
+
+      if(!ok) {
+         std::cerr << fmt::format("tt-edsl error: {} failed to write records", records.string()) << std::endl;
+      }
+
+      return ok;
+   }
+
+   // every updated record is written to a temporary name,
+   // then the batch is renamed into place; unsynced, a lost
+   // update only ages an entry
+   //
+   bool touch(std::vector<cache_access> const& accesses) {
+      std::vector< std::pair<fs::path, fs::path> > renames;
+      renames.reserve(accesses.size());
+
+      for(auto const& acc : accesses) {
+         fs::path pth = record_path(acc.key);
+
+         cache_record rec{};
+         if(!read(pth, rec)) { continue; }
+
+         rec.hits += acc.hits;
+         rec.atime = (rec.atime < acc.atime) ? acc.atime : rec.atime;
+
+         fs::path tmp_path;
+         if(!cache_io::write_temp(pth, encode(rec), false, tmp_path)) { continue; }
+
+         renames.emplace_back(std::move(tmp_path), std::move(pth));
+      }
+
+      for(auto const& r : renames) {
+         if(::rename(r.first.c_str(), r.second.c_str()) != 0) {
+            std::error_code ec;
+            fs::remove(r.first, ec);
+         }
+      }
+
+      return true;
+   }
+
+   bool scan(std::optional<content_hash> const& after, std::size_t const max_records,
+      std::vector<cache_item> & items, bool & finished) {
+
+      const std::string after_hex = after ? after->hex() : std::string{};
+      std::size_t shard = after ? static_cast<std::size_t>(after->bytes[0]) : 0UL;
+
+      finished = false;
+
+      for(; shard < shards::value; ++shard) {
+         const std::string prefix = fmt::format("{:02x}", shard);
+
+         std::vector<std::string> names;
+         std::error_code ec;
+         for(fs::directory_iterator itr{records / fs::path{prefix}, ec}, end; !ec && itr != end; itr.increment(ec)) {
+            names.push_back(itr->path().filename().string());
+         }
+         std::sort(names.begin(), names.end());
+
+         for(auto const& name : names) {
+            const std::string hex = prefix + name;
+            if(!after_hex.empty() && hex <= after_hex) { continue; }
+
+            cache_item item{};
+            if(!content_hash::from_hex(hex, item.key) || !read(records / fs::path{prefix} / fs::path{name}, item.rec)) { continue; }
+
+            if(max_records <= items.size()) { return true; }
+            items.push_back(item);
+         }
+      }
+
+      finished = true;
+      return true;
+   }
+
+   bool erase(std::vector<content_hash> const& keys) {
+      for(auto const& key : keys) {
+         std::error_code ec;
+         fs::remove(record_path(key), ec);
+      }
+
+      return true;
+   }
+
+   bool erase_idle(std::vector<content_hash> const& keys, std::uint64_t const since, std::vector<cache_item> & erased) {
+      for(auto const& key : keys) {
+         const fs::path pth = record_path(key);
+
+         cache_item item{key, cache_record{}};
+         if(!read(pth, item.rec) || since < item.rec.atime) { continue; }
+
+         std::error_code ec;
+         if(fs::remove(pth, ec)) {
+            erased.push_back(item);
+         }
+      }
+
+      return true;
+   }
+
+   // removes files in the record tree that are neither a
+   // well formed record nor another writer's temporary; a
+   // temporary older than stale_temp_age was left by a writer
+   // that died before its rename and is removed too
+   //
+   bool repair() {
+      cache_io::remove_stale_temps(records, std::chrono::seconds{stale_temp_age::value});
+
+      std::error_code ec;
+      for(fs::recursive_directory_iterator itr{records, ec}, end; !ec && itr != end; itr.increment(ec)) {
+         if(itr.depth() != 1) { continue; }
+
+         const std::string name = itr->path().filename().string();
+         if(name.rfind(cache_io::temp_prefix, 0) == 0) { continue; }
+
+         content_hash key{};
+         cache_record rec{};
+         const std::string hex = itr->path().parent_path().filename().string() + name;
+
+         if(!content_hash::from_hex(hex, key) || !read(itr->path(), rec)) {
+            std::error_code rec_ec;
+            fs::remove(itr->path(), rec_ec);
+         }
+      }
+
+      return true;
+   }
+
+private:
+
+   static std::string_view encode(cache_record const& rec) {
+      return std::string_view{reinterpret_cast<char const*>(&rec), sizeof(cache_record)};
+   }
+
+   static bool read(fs::path const& pth, cache_record & rec) {
+      std::string data;
+      if(!cache_io::read_file(pth, data) || data.size() != sizeof(cache_record)) { return false; }
+
+      std::memcpy(&rec, data.data(), sizeof(cache_record));
+      return true;
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
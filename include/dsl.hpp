@@ -10,13 +10,17 @@
 #ifndef __TT_EDSL_BASE_HPP__
 #define __TT_EDSL_BASE_HPP__
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <map>
 #include <vector>
 #include <type_traits>
 #include <functional>
 #include <initializer_list>
+#include <limits>
+#include <cstring>
 
 #define FMT_HEADER_ONLY
 #include <fmt/format.h>
@@ -25,6 +29,10 @@
 
 #include "variant.hpp"
 #include "recursive_wrapper.hpp"
+#include "arena.hpp"
+#include "emitter.hpp"
+#include "symbol.hpp"
+#include "hash.hpp"
 
 using namespace mpark;
 using namespace mpark::util;
@@ -37,7 +45,7 @@ struct none {
    using value_type = void*;
    constexpr static inline char const* value = R"(nullptr)";
 
-   void decl(std::string & buf) const {
+   void decl(emitter & buf) const {
    }
 };
 
@@ -146,11 +154,13 @@ struct variable_base {
 
    using value_type = T;
 
-   const std::string identity;
+   // interned, see symbol.hpp
+   //
+   const symbol identity;
 
    variable_base() : identity() {}
 
-   variable_base(std::string const& ident) : identity(ident) {}
+   variable_base(symbol const& ident) : identity(ident) {}
 };
 
 template<typename T>
@@ -162,12 +172,12 @@ struct scalar : public variable_base<T> {
 
    scalar() : variable_base<T>() {}
 
-   scalar(std::string const& ident) : variable_base<T>(ident) {}
+   scalar(symbol const& ident) : variable_base<T>(ident) {}
 
 //   scalar(scalar<T> s) : variable_base<T>(s.identity) {}
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} {}", scalar<T>::value_type::value, (*this).identity);
+   void decl(emitter & buf) const {
+      buf.format("{} {}", scalar<T>::value_type::value, (*this).identity);
    }
 };
 
@@ -225,8 +235,8 @@ struct literal : public variable_base<T> {
 
    integral_value_type value;
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} {}", scalar<T>::value_type::value, (*this).identity);
+   void decl(emitter & buf) const {
+      buf.format("{} {}", scalar<T>::value_type::value, (*this).identity);
    }
 };
 
@@ -280,16 +290,16 @@ struct array : public variable_base<T> {
    array() : 
       variable_base<T>(), num_dims(0) {}
 
-   array(std::string const& ident) :
+   array(symbol const& ident) :
       variable_base<T>(ident), num_dims(0) {}
 
-   array(std::string const& ident, const std::size_t ndims) :
+   array(symbol const& ident, const std::size_t ndims) :
       variable_base<T>(ident), num_dims(ndims) {}
 
 //   array(array<T> & s) : variable_base<T>(s.identity), num_dims(s.num_dims) {}
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} {} [{}]", array<T>::value_type::value, (*this).identity, num_dims);
+   void decl(emitter & buf) const {
+      buf.format("{} {} [{}]", array<T>::value_type::value, (*this).identity, num_dims);
    }
 };
 
@@ -344,21 +354,21 @@ struct matrix : variable_base<T> {
    matrix() :
       variable_base<T>(), num_dims(0), dimensions() {}
 
-   matrix(std::string const& ident) :
+   matrix(symbol const& ident) :
       variable_base<T>(ident), num_dims(0), dimensions() {}
 
-   matrix(std::string const& ident, std::initializer_list<std::size_t> values) :
+   matrix(symbol const& ident, std::initializer_list<std::size_t> values) :
       variable_base<T>(ident), num_dims(values.size()), dimensions(values) {}
 
-   matrix(std::string const& ident, std::vector<std::size_t> const& values) :
+   matrix(symbol const& ident, std::vector<std::size_t> const& values) :
       variable_base<T>(ident), num_dims(values.size()), dimensions(values) {}
 
 //   matrix(matrix<T> & s) : variable_base<T>(s.identity), num_dims(s.values.size()), dimensions(s.dimensions) {}
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} {} ", array<T>::value_type::value, (*this).identity);
+   void decl(emitter & buf) const {
+      buf.format("{} {} ", array<T>::value_type::value, (*this).identity);
       for(const auto & dim : dimensions) {
-         buf += fmt::format("[{}]", dim);
+         buf.format("[{}]", dim);
       }
    }
 };
@@ -424,6 +434,24 @@ struct underlying_value_type< matrix<T> > {
    using value_type = typename matrix<T>::value_type;
 };
 
+// dimension suffix used when a type is spelled as a
+// function argument or return type
+//
+template<typename T>
+struct type_suffix {
+   constexpr static inline char const* value = "";
+};
+
+template<typename T>
+struct type_suffix< array<T> > {
+   constexpr static inline char const* value = " []";
+};
+
+template<typename T>
+struct type_suffix< matrix<T> > {
+   constexpr static inline char const* value = " [][]";
+};
+
 template<typename T>
 struct pointer : public variable_base< typename underlying_value_type<T>::value_type > {
    static_assert(
@@ -437,12 +465,12 @@ struct pointer : public variable_base< typename underlying_value_type<T>::value_
 
    pointer() : variable_base< typename underlying_value_type<T>::value_type >() {}
 
-   pointer(std::string const& ident) : variable_base< typename underlying_value_type<T>::value_type >(ident) {}
+   pointer(symbol const& ident) : variable_base< typename underlying_value_type<T>::value_type >(ident) {}
 
 //   pointer(pointer<T> & s) : variable_base< typename underlying_value_type<T>::value_type >(s.identity) {}
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} * {}", pointer<T>::value_type::value, (*this).identity);
+   void decl(emitter & buf) const {
+      buf.format("{} * {}", pointer<T>::value_type::value, (*this).identity);
    }
 };
 
@@ -543,12 +571,12 @@ struct reference : public variable_base< typename underlying_value_type<T>::valu
       "variable declaration is not of tt::dsl::integral_type"
    );
 
-   reference(std::string const& ident) : variable_base< typename underlying_value_type<T>::value_type >(ident) {}
+   reference(symbol const& ident) : variable_base< typename underlying_value_type<T>::value_type >(ident) {}
 
 //   reference(reference<T> & s) : variable_base< typename underlying_value_type<T>::value_type >(s.identity) {}
 
-   void decl(std::string & buf) const {
-      buf += fmt::format("{} * {}", reference<T>::value_type::value, (*this).identity);
+   void decl(emitter & buf) const {
+      buf.format("{} * {}", reference<T>::value_type::value, (*this).identity);
    }
 };
 
@@ -693,285 +721,145 @@ using is_placeholder_variable_type = std::conditional<
    std::false_type
 >;
 
+// index of T in the alternatives of a variant
+//
+template<typename T, typename V>
+struct alternative_index;
+
+template<typename T, typename... Ts>
+struct alternative_index< T, variant<Ts...> > {
+   static constexpr std::size_t find() {
+      constexpr bool matches[] = { std::is_same<T, Ts>::value... };
+      for(std::size_t i = 0; i < sizeof...(Ts); ++i) {
+         if(matches[i]) { return i; }
+      }
+      return sizeof...(Ts);
+   }
+
+   constexpr static inline std::size_t value = find();
+};
+
+template<typename T>
+struct placeholder_dtype_name {
+   constexpr static inline std::string_view value{};
+};
+
+template<> struct placeholder_dtype_name<i8> { constexpr static inline std::string_view value{"i8"}; };
+template<> struct placeholder_dtype_name<i16> { constexpr static inline std::string_view value{"i16"}; };
+template<> struct placeholder_dtype_name<i32> { constexpr static inline std::string_view value{"i32"}; };
+template<> struct placeholder_dtype_name<i64> { constexpr static inline std::string_view value{"i64"}; };
+template<> struct placeholder_dtype_name<u8> { constexpr static inline std::string_view value{"u8"}; };
+template<> struct placeholder_dtype_name<u16> { constexpr static inline std::string_view value{"u16"}; };
+template<> struct placeholder_dtype_name<u32> { constexpr static inline std::string_view value{"u32"}; };
+template<> struct placeholder_dtype_name<u64> { constexpr static inline std::string_view value{"u64"}; };
+template<> struct placeholder_dtype_name<fp16a> { constexpr static inline std::string_view value{"fp16a"}; };
+template<> struct placeholder_dtype_name<fp16b> { constexpr static inline std::string_view value{"fp16b"}; };
+template<> struct placeholder_dtype_name<fp32> { constexpr static inline std::string_view value{"fp32"}; };
+template<> struct placeholder_dtype_name<fp64> { constexpr static inline std::string_view value{"fp64"}; };
+template<> struct placeholder_dtype_name<boolean> { constexpr static inline std::string_view value{"bool"}; };
+
+// "{kind}_{dtype}_{n}" built at compile time (ie: s_i8_0, m_bool_7)
+//
+template<typename T, std::size_t Identifier>
+struct placeholder_identity {
+   static_assert(is_placeholder_variable_type<T>::type::value, "placeholder_identity was passed a non-placeholder_variable_type type");
+
+   constexpr static inline std::string_view kind{
+      is_scalar_type<T>::type::value ? "s" : is_array_type<T>::type::value ? "a" : "m"
+   };
+
+   constexpr static inline std::string_view dtype = placeholder_dtype_name<typename T::value_type>::value;
+
+   constexpr static inline std::size_t size = kind.size() + dtype.size() + 3UL;
+
+   static constexpr std::array<char, size + 1UL> build() {
+      std::array<char, size + 1UL> chars{};
+      std::size_t i = 0;
+
+      for(char const c : kind) { chars[i++] = c; }
+      chars[i++] = '_';
+      for(char const c : dtype) { chars[i++] = c; }
+      chars[i++] = '_';
+      chars[i++] = static_cast<char>('0' + (Identifier % 8UL));
+
+      return chars;
+   }
+
+   constexpr static inline std::array<char, size + 1UL> chars = build();
+
+   constexpr static inline std::string_view value{chars.data(), size};
+};
+
+struct placeholder_type_info {
+   char const* type;
+   char const* suffix;
+};
+
+template<typename T>
+constexpr placeholder_type_info make_placeholder_type_info() {
+   if constexpr(is_placeholder_variable_type<T>::type::value) {
+      return placeholder_type_info{T::value_type::value, type_suffix<T>::value};
+   }
+   else {
+      return placeholder_type_info{nullptr, nullptr};
+   }
+}
+
+template<std::size_t... Is>
+constexpr std::array<placeholder_type_info, sizeof...(Is)> make_placeholder_type_table(std::index_sequence<Is...>) {
+   return {{ make_placeholder_type_info< variant_alternative_t<Is, placeholder_value_type> >()... }};
+}
+
+static constexpr std::array<placeholder_type_info, variant_size<placeholder_value_type>::value> placeholder_type_table =
+   make_placeholder_type_table(std::make_index_sequence<variant_size<placeholder_value_type>::value>{});
+
 struct placeholder_arg_base {
 
+   // literal type; placeholders are constant initialized and
+   // cost nothing at load time. type_index is the index of the
+   // placeholder's type in placeholder_value_type
+   //
+
    using placeholder_narg = std::integral_constant<std::size_t, 8UL>;
 
-   const placeholder_value_type node;
-   const std::size_t identifier;
-   const std::string identity;
+   std::size_t type_index;
+   std::size_t identifier;
+   std::string_view identity;
 
    template<typename T>
-   bool is_type() { return holds_alternative<T>(node); }
+   bool is_type() const { return type_index == alternative_index<T, placeholder_value_type>::value; }
 
-   std::size_t arg_n() { return identifier % placeholder_narg::value; }
+   std::size_t arg_n() const { return identifier % placeholder_narg::value; }
 
-   bool has_invalid_identity() { return identity.compare("{}_{}_{}") == 0UL; }
-   
-   template<typename T>
-   std::string argument_str_template() const {
-      static_assert(is_placeholder_variable_type<T>::type::value, "argument_str_template was passed a non-placeholder_variable_type type");
-      using value_type = typename T::value_type;
-      return fmt::format("{} {}", value_type::value, identity);
-   }   
-
-   void argument_str(std::string & buf) const {
-     if(holds_alternative<scalar<i8>>(node)) {
-        buf += argument_str_template<scalar<i8>>();
-     }
-     else if(holds_alternative<scalar<i16>>(node)) {
-        buf += argument_str_template<scalar<i16>>();
-     }
-     else if(holds_alternative<scalar<i32>>(node)) {
-        buf += argument_str_template<scalar<i32>>();
-     }
-     else if(holds_alternative<scalar<i64>>(node)) {
-        buf += argument_str_template<scalar<i64>>();
-     }
-     else if(holds_alternative<scalar<u8>>(node)) {
-        buf += argument_str_template<scalar<u8>>();
-     }
-     else if(holds_alternative<scalar<u16>>(node)) {
-        buf += argument_str_template<scalar<u16>>();
-     }
-     else if(holds_alternative<scalar<u32>>(node)) {
-        buf += argument_str_template<scalar<u32>>();
-     }
-     else if(holds_alternative<scalar<u64>>(node)) {
-        buf += argument_str_template<scalar<u64>>();
-     }
-     else if(holds_alternative<scalar<fp16a>>(node)) {
-        buf += argument_str_template<scalar<fp16b>>();
-     }
-     else if(holds_alternative<scalar<fp16b>>(node)) {
-        buf += argument_str_template<scalar<fp16b>>();
-     }
-     else if(holds_alternative<scalar<fp32>>(node)) {
-        buf += argument_str_template<scalar<fp32>>();
-     }
-     else if(holds_alternative<scalar<fp64>>(node)) {
-        buf += argument_str_template<scalar<fp64>>();
-     }
-     else if(holds_alternative<scalar<boolean>>(node)) {
-        buf += argument_str_template<scalar<boolean>>();
-     }
-     else if(holds_alternative<array<i8>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i8>>());
-     }
-     else if(holds_alternative<array<i16>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i16>>());
-     }
-     else if(holds_alternative<array<i32>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i32>>());
-     }
-     else if(holds_alternative<array<i64>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i64>>());
-     }
-     else if(holds_alternative<array<u8>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u8>>());
-     }
-     else if(holds_alternative<array<u16>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u16>>());
-     }
-     else if(holds_alternative<array<u32>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u32>>());
-     }
-     else if(holds_alternative<array<u64>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u64>>());
-     }
-     else if(holds_alternative<array<fp16a>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<array<fp16b>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<array<fp32>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp32>>());
-     }
-     else if(holds_alternative<array<fp64>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp64>>());
-     }
-     else if(holds_alternative<array<boolean>>(node)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<boolean>>());
-     }
-     else if(holds_alternative<matrix<i8>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i8>>());
-     }
-     else if(holds_alternative<matrix<i16>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i16>>());
-     }
-     else if(holds_alternative<matrix<i32>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i32>>());
-     }
-     else if(holds_alternative<matrix<i64>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i64>>());
-     }
-     else if(holds_alternative<matrix<u8>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u8>>());
-     }
-     else if(holds_alternative<matrix<u16>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u16>>());
-     }
-     else if(holds_alternative<matrix<u32>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u32>>());
-     }
-     else if(holds_alternative<matrix<u64>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u64>>());
-     }
-     else if(holds_alternative<matrix<fp16a>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<matrix<fp16b>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<matrix<fp32>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp32>>());
-     }
-     else if(holds_alternative<matrix<fp64>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp64>>());
-     }
-     else if(holds_alternative<matrix<boolean>>(node)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<boolean>>());
-     }
-
-     buf += "void";
-   }
-
-   void decl(std::string & buf) const {
-      argument_str(buf);
-   }
+   bool has_invalid_identity() const { return identity.empty(); }
 
-   template<typename T, std::size_t Identifier>
-   static inline std::string calc_identity() {
-      using identifier_value_type =
-         std::integral_constant<std::size_t, Identifier % placeholder_narg::value>;
-
-      if constexpr(std::is_same<T, scalar<i8>>::value) {
-         return fmt::format("{}_{}_{}", "s", "i8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<i16>>::value) {
-         return fmt::format("{}_{}_{}", "s", "i16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<i32>>::value) {
-         return fmt::format("{}_{}_{}", "s", "i32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<i64>>::value) {
-         return fmt::format("{}_{}_{}", "s", "i64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<u8>>::value) {
-         return fmt::format("{}_{}_{}", "s", "u8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<u16>>::value) {
-         return fmt::format("{}_{}_{}", "s", "u16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<u32>>::value) {
-         return fmt::format("{}_{}_{}", "s", "u32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<u64>>::value) {
-         return fmt::format("{}_{}_{}", "s", "u64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<fp16a>>::value) {
-         return fmt::format("{}_{}_{}", "s", "fp16a", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<fp16b>>::value) {
-         return fmt::format("{}_{}_{}", "s", "fp16b", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<fp32>>::value) {
-         return fmt::format("{}_{}_{}", "s", "fp32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<fp64>>::value) {
-         return fmt::format("{}_{}_{}", "s", "fp64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, scalar<boolean>>::value) {
-         return fmt::format("{}_{}_{}", "s", "bool", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<i8>>::value) {
-         return fmt::format("{}_{}_{}", "a", "i8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<i16>>::value) {
-         return fmt::format("{}_{}_{}", "a", "i16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<i32>>::value) {
-         return fmt::format("{}_{}_{}", "a", "i32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<i64>>::value) {
-         return fmt::format("{}_{}_{}", "a", "i64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<u8>>::value) {
-         return fmt::format("{}_{}_{}", "a", "u8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<u16>>::value) {
-         return fmt::format("{}_{}_{}", "a", "u16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<u32>>::value) {
-         return fmt::format("{}_{}_{}", "a", "u32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<u64>>::value) {
-         return fmt::format("{}_{}_{}", "a", "u64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<fp16a>>::value) {
-         return fmt::format("{}_{}_{}", "a", "fp16a", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<fp16b>>::value) {
-         return fmt::format("{}_{}_{}", "a", "fp16b", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<fp32>>::value) {
-         return fmt::format("{}_{}_{}", "a", "fp32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<fp64>>::value) {
-         return fmt::format("{}_{}_{}", "a", "fp64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, array<boolean>>::value) {
-         return fmt::format("{}_{}_{}", "a", "bool", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<i8>>::value) {
-         return fmt::format("{}_{}_{}", "m", "i8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<i16>>::value) {
-         return fmt::format("{}_{}_{}", "m", "i16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<i32>>::value) {
-         return fmt::format("{}_{}_{}", "m", "i32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<i64>>::value) {
-         return fmt::format("{}_{}_{}", "m", "i64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<u8>>::value) {
-         return fmt::format("{}_{}_{}", "m", "u8", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<u16>>::value) {
-         return fmt::format("{}_{}_{}", "m", "u16", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<u32>>::value) {
-         return fmt::format("{}_{}_{}", "m", "u32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<u64>>::value) {
-         return fmt::format("{}_{}_{}", "m", "u64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<fp16a>>::value) {
-         return fmt::format("{}_{}_{}", "m", "fp16a", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<fp16b>>::value) {
-         return fmt::format("{}_{}_{}", "m", "fp16b", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<fp32>>::value) {
-         return fmt::format("{}_{}_{}", "m", "fp32", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<fp64>>::value) {
-         return fmt::format("{}_{}_{}", "m", "fp64", std::to_string(identifier_value_type::value));
-      }
-      else if constexpr(std::is_same<T, matrix<boolean>>::value) {
-         return fmt::format("{}_{}_{}", "m", "bool", std::to_string(identifier_value_type::value));
-      }
+   void argument_str(emitter & buf) const {
+      placeholder_type_info const& info = placeholder_type_table[type_index];
+      if(info.type == nullptr) { return; }
 
-      return "{}_{}_{}";
+      buf += info.type;
+      buf += ' ';
+      buf += identity;
+      buf += info.suffix;
    }
 
+   void decl(emitter & buf) const {
+      argument_str(buf);
+   }
 };
 
 template<std::size_t NumArg>
 struct placeholder_arg : public placeholder_arg_base {
    using num_arg = std::integral_constant<std::size_t, NumArg>;
+
+   template<typename T, std::size_t Identifier>
+   static constexpr placeholder_arg<NumArg> make() {
+      return placeholder_arg<NumArg>{placeholder_arg_base{
+         alternative_index<T, placeholder_value_type>::value,
+         Identifier,
+         placeholder_identity<T, Identifier>::value
+      }};
+   }
 };
 
 using placeholder_arg_1 = placeholder_arg<1>;
@@ -1003,361 +891,362 @@ using is_placeholder_arg_type = std::conditional<
    std::is_same< placeholder_arg_4, T>::value ||
    std::is_same< placeholder_arg_5, T>::value ||
    std::is_same< placeholder_arg_6, T>::value ||
+   std::is_same< placeholder_arg_7, T>::value ||
    std::is_same< placeholder_arg_8, T>::value,
    std::true_type,
    std::false_type
 >;
 
-static inline placeholder const s_i8_1 = placeholder_arg_1{placeholder_value_type{scalar<i8>{}}, 0, placeholder_arg_base::calc_identity<scalar<i8>, 0>()};
-static inline placeholder const s_i8_2 = placeholder_arg_2{placeholder_value_type{scalar<i8>{}}, 1, placeholder_arg_base::calc_identity<scalar<i8>, 1>()};
-static inline placeholder const s_i8_3 = placeholder_arg_3{placeholder_value_type{scalar<i8>{}}, 2, placeholder_arg_base::calc_identity<scalar<i8>, 2>()};
-static inline placeholder const s_i8_4 = placeholder_arg_4{placeholder_value_type{scalar<i8>{}}, 3, placeholder_arg_base::calc_identity<scalar<i8>, 3>()};
-static inline placeholder const s_i8_5 = placeholder_arg_5{placeholder_value_type{scalar<i8>{}}, 4, placeholder_arg_base::calc_identity<scalar<i8>, 4>()};
-static inline placeholder const s_i8_6 = placeholder_arg_6{placeholder_value_type{scalar<i8>{}}, 5, placeholder_arg_base::calc_identity<scalar<i8>, 5>()};
-static inline placeholder const s_i8_7 = placeholder_arg_7{placeholder_value_type{scalar<i8>{}}, 6, placeholder_arg_base::calc_identity<scalar<i8>, 6>()};
-static inline placeholder const s_i8_8 = placeholder_arg_8{placeholder_value_type{scalar<i8>{}}, 7, placeholder_arg_base::calc_identity<scalar<i8>, 7>()};
-
-static inline placeholder const s_i16_1 = placeholder_arg_1{placeholder_value_type{scalar<i16>{}}, 8, placeholder_arg_base::calc_identity<scalar<i16>, 8>()};
-static inline placeholder const s_i16_2 = placeholder_arg_2{placeholder_value_type{scalar<i16>{}}, 9, placeholder_arg_base::calc_identity<scalar<i16>, 9>()};
-static inline placeholder const s_i16_3 = placeholder_arg_3{placeholder_value_type{scalar<i16>{}}, 10, placeholder_arg_base::calc_identity<scalar<i16>, 10>()};
-static inline placeholder const s_i16_4 = placeholder_arg_4{placeholder_value_type{scalar<i16>{}}, 11, placeholder_arg_base::calc_identity<scalar<i16>, 11>()};
-static inline placeholder const s_i16_5 = placeholder_arg_5{placeholder_value_type{scalar<i16>{}}, 12, placeholder_arg_base::calc_identity<scalar<i16>, 12>()};
-static inline placeholder const s_i16_6 = placeholder_arg_6{placeholder_value_type{scalar<i16>{}}, 13, placeholder_arg_base::calc_identity<scalar<i16>, 13>()};
-static inline placeholder const s_i16_7 = placeholder_arg_7{placeholder_value_type{scalar<i16>{}}, 14, placeholder_arg_base::calc_identity<scalar<i16>, 14>()};
-static inline placeholder const s_i16_8 = placeholder_arg_8{placeholder_value_type{scalar<i16>{}}, 15, placeholder_arg_base::calc_identity<scalar<i16>, 15>()};
-
-static inline placeholder const s_i32_1 = placeholder_arg_1{placeholder_value_type{scalar<i32>{}}, 16, placeholder_arg_base::calc_identity<scalar<i32>, 16>()};
-static inline placeholder const s_i32_2 = placeholder_arg_2{placeholder_value_type{scalar<i32>{}}, 17, placeholder_arg_base::calc_identity<scalar<i32>, 17>()};
-static inline placeholder const s_i32_3 = placeholder_arg_3{placeholder_value_type{scalar<i32>{}}, 18, placeholder_arg_base::calc_identity<scalar<i32>, 18>()};
-static inline placeholder const s_i32_4 = placeholder_arg_4{placeholder_value_type{scalar<i32>{}}, 19, placeholder_arg_base::calc_identity<scalar<i32>, 19>()};
-static inline placeholder const s_i32_5 = placeholder_arg_5{placeholder_value_type{scalar<i32>{}}, 20, placeholder_arg_base::calc_identity<scalar<i32>, 20>()};
-static inline placeholder const s_i32_6 = placeholder_arg_6{placeholder_value_type{scalar<i32>{}}, 21, placeholder_arg_base::calc_identity<scalar<i32>, 21>()};
-static inline placeholder const s_i32_7 = placeholder_arg_7{placeholder_value_type{scalar<i32>{}}, 22, placeholder_arg_base::calc_identity<scalar<i32>, 22>()};
-static inline placeholder const s_i32_8 = placeholder_arg_8{placeholder_value_type{scalar<i32>{}}, 23, placeholder_arg_base::calc_identity<scalar<i32>, 23>()};
-
-static inline placeholder const s_i64_1 = placeholder_arg_1{placeholder_value_type{scalar<i64>{}}, 24, placeholder_arg_base::calc_identity<scalar<i64>, 24>()};
-static inline placeholder const s_i64_2 = placeholder_arg_2{placeholder_value_type{scalar<i64>{}}, 25, placeholder_arg_base::calc_identity<scalar<i64>, 25>()};
-static inline placeholder const s_i64_3 = placeholder_arg_3{placeholder_value_type{scalar<i64>{}}, 26, placeholder_arg_base::calc_identity<scalar<i64>, 26>()};
-static inline placeholder const s_i64_4 = placeholder_arg_4{placeholder_value_type{scalar<i64>{}}, 27, placeholder_arg_base::calc_identity<scalar<i64>, 27>()};
-static inline placeholder const s_i64_5 = placeholder_arg_5{placeholder_value_type{scalar<i64>{}}, 28, placeholder_arg_base::calc_identity<scalar<i64>, 28>()};
-static inline placeholder const s_i64_6 = placeholder_arg_6{placeholder_value_type{scalar<i64>{}}, 29, placeholder_arg_base::calc_identity<scalar<i64>, 29>()};
-static inline placeholder const s_i64_7 = placeholder_arg_7{placeholder_value_type{scalar<i64>{}}, 30, placeholder_arg_base::calc_identity<scalar<i64>, 30>()};
-static inline placeholder const s_i64_8 = placeholder_arg_8{placeholder_value_type{scalar<i64>{}}, 31, placeholder_arg_base::calc_identity<scalar<i64>, 31>()};
-
-static inline placeholder const s_u8_1 = placeholder_arg_1{placeholder_value_type{scalar<u8>{}}, 32, placeholder_arg_base::calc_identity<scalar<u8>, 32>()};
-static inline placeholder const s_u8_2 = placeholder_arg_2{placeholder_value_type{scalar<u8>{}}, 33, placeholder_arg_base::calc_identity<scalar<u8>, 33>()};
-static inline placeholder const s_u8_3 = placeholder_arg_3{placeholder_value_type{scalar<u8>{}}, 34, placeholder_arg_base::calc_identity<scalar<u8>, 34>()};
-static inline placeholder const s_u8_4 = placeholder_arg_4{placeholder_value_type{scalar<u8>{}}, 35, placeholder_arg_base::calc_identity<scalar<u8>, 35>()};
-static inline placeholder const s_u8_5 = placeholder_arg_5{placeholder_value_type{scalar<u8>{}}, 36, placeholder_arg_base::calc_identity<scalar<u8>, 36>()};
-static inline placeholder const s_u8_6 = placeholder_arg_6{placeholder_value_type{scalar<u8>{}}, 37, placeholder_arg_base::calc_identity<scalar<u8>, 37>()};
-static inline placeholder const s_u8_7 = placeholder_arg_7{placeholder_value_type{scalar<u8>{}}, 38, placeholder_arg_base::calc_identity<scalar<u8>, 38>()};
-static inline placeholder const s_u8_8 = placeholder_arg_8{placeholder_value_type{scalar<u8>{}}, 39, placeholder_arg_base::calc_identity<scalar<u8>, 39>()};
-
-static inline placeholder const s_u16_1 = placeholder_arg_1{placeholder_value_type{scalar<u16>{}}, 40, placeholder_arg_base::calc_identity<scalar<u16>, 40>()};
-static inline placeholder const s_u16_2 = placeholder_arg_2{placeholder_value_type{scalar<u16>{}}, 41, placeholder_arg_base::calc_identity<scalar<u16>, 41>()};
-static inline placeholder const s_u16_3 = placeholder_arg_3{placeholder_value_type{scalar<u16>{}}, 42, placeholder_arg_base::calc_identity<scalar<u16>, 42>()};
-static inline placeholder const s_u16_4 = placeholder_arg_4{placeholder_value_type{scalar<u16>{}}, 43, placeholder_arg_base::calc_identity<scalar<u16>, 43>()};
-static inline placeholder const s_u16_5 = placeholder_arg_5{placeholder_value_type{scalar<u16>{}}, 44, placeholder_arg_base::calc_identity<scalar<u16>, 44>()};
-static inline placeholder const s_u16_6 = placeholder_arg_6{placeholder_value_type{scalar<u16>{}}, 45, placeholder_arg_base::calc_identity<scalar<u16>, 45>()};
-static inline placeholder const s_u16_7 = placeholder_arg_7{placeholder_value_type{scalar<u16>{}}, 46, placeholder_arg_base::calc_identity<scalar<u16>, 46>()};
-static inline placeholder const s_u16_8 = placeholder_arg_8{placeholder_value_type{scalar<u16>{}}, 47, placeholder_arg_base::calc_identity<scalar<u16>, 47>()};
-
-static inline placeholder const s_u32_1 = placeholder_arg_1{placeholder_value_type{scalar<u32>{}}, 48, placeholder_arg_base::calc_identity<scalar<u32>, 48>()};
-static inline placeholder const s_u32_2 = placeholder_arg_2{placeholder_value_type{scalar<u32>{}}, 49, placeholder_arg_base::calc_identity<scalar<u32>, 49>()};
-static inline placeholder const s_u32_3 = placeholder_arg_3{placeholder_value_type{scalar<u32>{}}, 50, placeholder_arg_base::calc_identity<scalar<u32>, 50>()};
-static inline placeholder const s_u32_4 = placeholder_arg_4{placeholder_value_type{scalar<u32>{}}, 51, placeholder_arg_base::calc_identity<scalar<u32>, 51>()};
-static inline placeholder const s_u32_5 = placeholder_arg_5{placeholder_value_type{scalar<u32>{}}, 52, placeholder_arg_base::calc_identity<scalar<u32>, 52>()};
-static inline placeholder const s_u32_6 = placeholder_arg_6{placeholder_value_type{scalar<u32>{}}, 53, placeholder_arg_base::calc_identity<scalar<u32>, 53>()};
-static inline placeholder const s_u32_7 = placeholder_arg_7{placeholder_value_type{scalar<u32>{}}, 54, placeholder_arg_base::calc_identity<scalar<u32>, 54>()};
-static inline placeholder const s_u32_8 = placeholder_arg_8{placeholder_value_type{scalar<u32>{}}, 55, placeholder_arg_base::calc_identity<scalar<u32>, 55>()};
-
-static inline placeholder const s_u64_1 = placeholder_arg_1{placeholder_value_type{scalar<u64>{}}, 56, placeholder_arg_base::calc_identity<scalar<u64>, 56>()};
-static inline placeholder const s_u64_2 = placeholder_arg_2{placeholder_value_type{scalar<u64>{}}, 57, placeholder_arg_base::calc_identity<scalar<u64>, 57>()};
-static inline placeholder const s_u64_3 = placeholder_arg_3{placeholder_value_type{scalar<u64>{}}, 58, placeholder_arg_base::calc_identity<scalar<u64>, 58>()};
-static inline placeholder const s_u64_4 = placeholder_arg_4{placeholder_value_type{scalar<u64>{}}, 59, placeholder_arg_base::calc_identity<scalar<u64>, 59>()};
-static inline placeholder const s_u64_5 = placeholder_arg_5{placeholder_value_type{scalar<u64>{}}, 60, placeholder_arg_base::calc_identity<scalar<u64>, 60>()};
-static inline placeholder const s_u64_6 = placeholder_arg_6{placeholder_value_type{scalar<u64>{}}, 61, placeholder_arg_base::calc_identity<scalar<u64>, 61>()};
-static inline placeholder const s_u64_7 = placeholder_arg_7{placeholder_value_type{scalar<u64>{}}, 62, placeholder_arg_base::calc_identity<scalar<u64>, 62>()};
-static inline placeholder const s_u64_8 = placeholder_arg_8{placeholder_value_type{scalar<u64>{}}, 63, placeholder_arg_base::calc_identity<scalar<u64>, 63>()};
-
-static inline placeholder const s_fp16a_1 = placeholder_arg_1{placeholder_value_type{scalar<fp16a>{}}, 64, placeholder_arg_base::calc_identity<scalar<fp16a>, 64>()};
-static inline placeholder const s_fp16a_2 = placeholder_arg_2{placeholder_value_type{scalar<fp16a>{}}, 65, placeholder_arg_base::calc_identity<scalar<fp16a>, 65>()};
-static inline placeholder const s_fp16a_3 = placeholder_arg_3{placeholder_value_type{scalar<fp16a>{}}, 66, placeholder_arg_base::calc_identity<scalar<fp16a>, 66>()};
-static inline placeholder const s_fp16a_4 = placeholder_arg_4{placeholder_value_type{scalar<fp16a>{}}, 67, placeholder_arg_base::calc_identity<scalar<fp16a>, 67>()};
-static inline placeholder const s_fp16a_5 = placeholder_arg_5{placeholder_value_type{scalar<fp16a>{}}, 68, placeholder_arg_base::calc_identity<scalar<fp16a>, 68>()};
-static inline placeholder const s_fp16a_6 = placeholder_arg_6{placeholder_value_type{scalar<fp16a>{}}, 69, placeholder_arg_base::calc_identity<scalar<fp16a>, 69>()};
-static inline placeholder const s_fp16a_7 = placeholder_arg_7{placeholder_value_type{scalar<fp16a>{}}, 70, placeholder_arg_base::calc_identity<scalar<fp16a>, 70>()};
-static inline placeholder const s_fp16a_8 = placeholder_arg_8{placeholder_value_type{scalar<fp16a>{}}, 71, placeholder_arg_base::calc_identity<scalar<fp16a>, 71>()};
-
-static inline placeholder const s_fp16b_1 = placeholder_arg_1{placeholder_value_type{scalar<fp16b>{}}, 72, placeholder_arg_base::calc_identity<scalar<fp16b>, 72>()};
-static inline placeholder const s_fp16b_2 = placeholder_arg_2{placeholder_value_type{scalar<fp16b>{}}, 73, placeholder_arg_base::calc_identity<scalar<fp16b>, 73>()};
-static inline placeholder const s_fp16b_3 = placeholder_arg_3{placeholder_value_type{scalar<fp16b>{}}, 74, placeholder_arg_base::calc_identity<scalar<fp16b>, 74>()};
-static inline placeholder const s_fp16b_4 = placeholder_arg_4{placeholder_value_type{scalar<fp16b>{}}, 75, placeholder_arg_base::calc_identity<scalar<fp16b>, 75>()};
-static inline placeholder const s_fp16b_5 = placeholder_arg_5{placeholder_value_type{scalar<fp16b>{}}, 76, placeholder_arg_base::calc_identity<scalar<fp16b>, 76>()};
-static inline placeholder const s_fp16b_6 = placeholder_arg_6{placeholder_value_type{scalar<fp16b>{}}, 77, placeholder_arg_base::calc_identity<scalar<fp16b>, 77>()};
-static inline placeholder const s_fp16b_7 = placeholder_arg_7{placeholder_value_type{scalar<fp16b>{}}, 78, placeholder_arg_base::calc_identity<scalar<fp16b>, 78>()};
-static inline placeholder const s_fp16b_8 = placeholder_arg_8{placeholder_value_type{scalar<fp16b>{}}, 79, placeholder_arg_base::calc_identity<scalar<fp16b>, 79>()};
-
-static inline placeholder const s_fp32_1 = placeholder_arg_1{placeholder_value_type{scalar<fp32>{}}, 80, placeholder_arg_base::calc_identity<scalar<fp32>, 80>()};
-static inline placeholder const s_fp32_2 = placeholder_arg_2{placeholder_value_type{scalar<fp32>{}}, 81, placeholder_arg_base::calc_identity<scalar<fp32>, 81>()};
-static inline placeholder const s_fp32_3 = placeholder_arg_3{placeholder_value_type{scalar<fp32>{}}, 82, placeholder_arg_base::calc_identity<scalar<fp32>, 82>()};
-static inline placeholder const s_fp32_4 = placeholder_arg_4{placeholder_value_type{scalar<fp32>{}}, 83, placeholder_arg_base::calc_identity<scalar<fp32>, 83>()};
-static inline placeholder const s_fp32_5 = placeholder_arg_5{placeholder_value_type{scalar<fp32>{}}, 84, placeholder_arg_base::calc_identity<scalar<fp32>, 84>()};
-static inline placeholder const s_fp32_6 = placeholder_arg_6{placeholder_value_type{scalar<fp32>{}}, 85, placeholder_arg_base::calc_identity<scalar<fp32>, 85>()};
-static inline placeholder const s_fp32_7 = placeholder_arg_7{placeholder_value_type{scalar<fp32>{}}, 86, placeholder_arg_base::calc_identity<scalar<fp32>, 86>()};
-static inline placeholder const s_fp32_8 = placeholder_arg_8{placeholder_value_type{scalar<fp32>{}}, 87, placeholder_arg_base::calc_identity<scalar<fp32>, 87>()};
-
-static inline placeholder const s_fp64_1 = placeholder_arg_1{placeholder_value_type{scalar<fp64>{}}, 88, placeholder_arg_base::calc_identity<scalar<fp64>, 88>()};
-static inline placeholder const s_fp64_2 = placeholder_arg_2{placeholder_value_type{scalar<fp64>{}}, 89, placeholder_arg_base::calc_identity<scalar<fp64>, 89>()};
-static inline placeholder const s_fp64_3 = placeholder_arg_3{placeholder_value_type{scalar<fp64>{}}, 90, placeholder_arg_base::calc_identity<scalar<fp64>, 90>()};
-static inline placeholder const s_fp64_4 = placeholder_arg_4{placeholder_value_type{scalar<fp64>{}}, 91, placeholder_arg_base::calc_identity<scalar<fp64>, 91>()};
-static inline placeholder const s_fp64_5 = placeholder_arg_5{placeholder_value_type{scalar<fp64>{}}, 92, placeholder_arg_base::calc_identity<scalar<fp64>, 92>()};
-static inline placeholder const s_fp64_6 = placeholder_arg_6{placeholder_value_type{scalar<fp64>{}}, 93, placeholder_arg_base::calc_identity<scalar<fp64>, 93>()};
-static inline placeholder const s_fp64_7 = placeholder_arg_7{placeholder_value_type{scalar<fp64>{}}, 94, placeholder_arg_base::calc_identity<scalar<fp64>, 94>()};
-static inline placeholder const s_fp64_8 = placeholder_arg_8{placeholder_value_type{scalar<fp64>{}}, 95, placeholder_arg_base::calc_identity<scalar<fp64>, 95>()};
-
-static inline placeholder const s_bool_1 = placeholder_arg_1{placeholder_value_type{scalar<boolean>{}}, 96, placeholder_arg_base::calc_identity<scalar<boolean>, 96>()};
-static inline placeholder const s_bool_2 = placeholder_arg_2{placeholder_value_type{scalar<boolean>{}}, 97, placeholder_arg_base::calc_identity<scalar<boolean>, 97>()};
-static inline placeholder const s_bool_3 = placeholder_arg_3{placeholder_value_type{scalar<boolean>{}}, 98, placeholder_arg_base::calc_identity<scalar<boolean>, 98>()};
-static inline placeholder const s_bool_4 = placeholder_arg_4{placeholder_value_type{scalar<boolean>{}}, 99, placeholder_arg_base::calc_identity<scalar<boolean>, 99>()};
-static inline placeholder const s_bool_5 = placeholder_arg_5{placeholder_value_type{scalar<boolean>{}}, 100, placeholder_arg_base::calc_identity<scalar<boolean>, 100>()};
-static inline placeholder const s_bool_6 = placeholder_arg_6{placeholder_value_type{scalar<boolean>{}}, 101, placeholder_arg_base::calc_identity<scalar<boolean>, 101>()};
-static inline placeholder const s_bool_7 = placeholder_arg_7{placeholder_value_type{scalar<boolean>{}}, 102, placeholder_arg_base::calc_identity<scalar<boolean>, 102>()};
-static inline placeholder const s_bool_8 = placeholder_arg_8{placeholder_value_type{scalar<boolean>{}}, 103, placeholder_arg_base::calc_identity<scalar<boolean>, 103>()};
-
-static inline placeholder const a_i8_1 = placeholder_arg_1{placeholder_value_type{array<i8>{}}, 104, placeholder_arg_base::calc_identity<array<i8>, 104>()};
-static inline placeholder const a_i8_2 = placeholder_arg_2{placeholder_value_type{array<i8>{}}, 105, placeholder_arg_base::calc_identity<array<i8>, 105>()};
-static inline placeholder const a_i8_3 = placeholder_arg_3{placeholder_value_type{array<i8>{}}, 106, placeholder_arg_base::calc_identity<array<i8>, 106>()};
-static inline placeholder const a_i8_4 = placeholder_arg_4{placeholder_value_type{array<i8>{}}, 107, placeholder_arg_base::calc_identity<array<i8>, 107>()};
-static inline placeholder const a_i8_5 = placeholder_arg_5{placeholder_value_type{array<i8>{}}, 108, placeholder_arg_base::calc_identity<array<i8>, 108>()};
-static inline placeholder const a_i8_6 = placeholder_arg_6{placeholder_value_type{array<i8>{}}, 109, placeholder_arg_base::calc_identity<array<i8>, 109>()};
-static inline placeholder const a_i8_7 = placeholder_arg_7{placeholder_value_type{array<i8>{}}, 110, placeholder_arg_base::calc_identity<array<i8>, 110>()};
-static inline placeholder const a_i8_8 = placeholder_arg_8{placeholder_value_type{array<i8>{}}, 111, placeholder_arg_base::calc_identity<array<i8>, 111>()};
-
-static inline placeholder const a_i16_1 = placeholder_arg_1{placeholder_value_type{array<i16>{}}, 112, placeholder_arg_base::calc_identity<array<i16>, 112>()};
-static inline placeholder const a_i16_2 = placeholder_arg_2{placeholder_value_type{array<i16>{}}, 113, placeholder_arg_base::calc_identity<array<i16>, 113>()};
-static inline placeholder const a_i16_3 = placeholder_arg_3{placeholder_value_type{array<i16>{}}, 114, placeholder_arg_base::calc_identity<array<i16>, 114>()};
-static inline placeholder const a_i16_4 = placeholder_arg_4{placeholder_value_type{array<i16>{}}, 115, placeholder_arg_base::calc_identity<array<i16>, 115>()};
-static inline placeholder const a_i16_5 = placeholder_arg_5{placeholder_value_type{array<i16>{}}, 116, placeholder_arg_base::calc_identity<array<i16>, 116>()};
-static inline placeholder const a_i16_6 = placeholder_arg_6{placeholder_value_type{array<i16>{}}, 117, placeholder_arg_base::calc_identity<array<i16>, 117>()};
-static inline placeholder const a_i16_7 = placeholder_arg_7{placeholder_value_type{array<i16>{}}, 118, placeholder_arg_base::calc_identity<array<i16>, 118>()};
-static inline placeholder const a_i16_8 = placeholder_arg_8{placeholder_value_type{array<i16>{}}, 119, placeholder_arg_base::calc_identity<array<i16>, 119>()};
-
-static inline placeholder const a_i32_1 = placeholder_arg_1{placeholder_value_type{array<i32>{}}, 120, placeholder_arg_base::calc_identity<array<i32>, 120>()};
-static inline placeholder const a_i32_2 = placeholder_arg_2{placeholder_value_type{array<i32>{}}, 121, placeholder_arg_base::calc_identity<array<i32>, 121>()};
-static inline placeholder const a_i32_3 = placeholder_arg_3{placeholder_value_type{array<i32>{}}, 122, placeholder_arg_base::calc_identity<array<i32>, 122>()};
-static inline placeholder const a_i32_4 = placeholder_arg_4{placeholder_value_type{array<i32>{}}, 123, placeholder_arg_base::calc_identity<array<i32>, 123>()};
-static inline placeholder const a_i32_5 = placeholder_arg_5{placeholder_value_type{array<i32>{}}, 124, placeholder_arg_base::calc_identity<array<i32>, 124>()};
-static inline placeholder const a_i32_6 = placeholder_arg_6{placeholder_value_type{array<i32>{}}, 125, placeholder_arg_base::calc_identity<array<i32>, 125>()};
-static inline placeholder const a_i32_7 = placeholder_arg_7{placeholder_value_type{array<i32>{}}, 126, placeholder_arg_base::calc_identity<array<i32>, 126>()};
-static inline placeholder const a_i32_8 = placeholder_arg_8{placeholder_value_type{array<i32>{}}, 127, placeholder_arg_base::calc_identity<array<i32>, 127>()};
-
-static inline placeholder const a_i64_1 = placeholder_arg_1{placeholder_value_type{array<i64>{}}, 128, placeholder_arg_base::calc_identity<array<i64>, 128>()};
-static inline placeholder const a_i64_2 = placeholder_arg_2{placeholder_value_type{array<i64>{}}, 129, placeholder_arg_base::calc_identity<array<i64>, 129>()};
-static inline placeholder const a_i64_3 = placeholder_arg_3{placeholder_value_type{array<i64>{}}, 130, placeholder_arg_base::calc_identity<array<i64>, 130>()};
-static inline placeholder const a_i64_4 = placeholder_arg_4{placeholder_value_type{array<i64>{}}, 131, placeholder_arg_base::calc_identity<array<i64>, 131>()};
-static inline placeholder const a_i64_5 = placeholder_arg_5{placeholder_value_type{array<i64>{}}, 132, placeholder_arg_base::calc_identity<array<i64>, 132>()};
-static inline placeholder const a_i64_6 = placeholder_arg_6{placeholder_value_type{array<i64>{}}, 133, placeholder_arg_base::calc_identity<array<i64>, 133>()};
-static inline placeholder const a_i64_7 = placeholder_arg_7{placeholder_value_type{array<i64>{}}, 134, placeholder_arg_base::calc_identity<array<i64>, 134>()};
-static inline placeholder const a_i64_8 = placeholder_arg_8{placeholder_value_type{array<i64>{}}, 135, placeholder_arg_base::calc_identity<array<i64>, 135>()};
-
-static inline placeholder const a_u8_1 = placeholder_arg_1{placeholder_value_type{array<u8>{}}, 136, placeholder_arg_base::calc_identity<array<u8>, 136>()};
-static inline placeholder const a_u8_2 = placeholder_arg_2{placeholder_value_type{array<u8>{}}, 137, placeholder_arg_base::calc_identity<array<u8>, 137>()};
-static inline placeholder const a_u8_3 = placeholder_arg_3{placeholder_value_type{array<u8>{}}, 138, placeholder_arg_base::calc_identity<array<u8>, 138>()};
-static inline placeholder const a_u8_4 = placeholder_arg_4{placeholder_value_type{array<u8>{}}, 139, placeholder_arg_base::calc_identity<array<u8>, 139>()};
-static inline placeholder const a_u8_5 = placeholder_arg_5{placeholder_value_type{array<u8>{}}, 140, placeholder_arg_base::calc_identity<array<u8>, 140>()};
-static inline placeholder const a_u8_6 = placeholder_arg_6{placeholder_value_type{array<u8>{}}, 141, placeholder_arg_base::calc_identity<array<u8>, 141>()};
-static inline placeholder const a_u8_7 = placeholder_arg_7{placeholder_value_type{array<u8>{}}, 142, placeholder_arg_base::calc_identity<array<u8>, 142>()};
-static inline placeholder const a_u8_8 = placeholder_arg_8{placeholder_value_type{array<u8>{}}, 143, placeholder_arg_base::calc_identity<array<u8>, 143>()};
-
-static inline placeholder const a_u16_1 = placeholder_arg_1{placeholder_value_type{array<u16>{}}, 144, placeholder_arg_base::calc_identity<array<u16>, 144>()};
-static inline placeholder const a_u16_2 = placeholder_arg_2{placeholder_value_type{array<u16>{}}, 145, placeholder_arg_base::calc_identity<array<u16>, 145>()};
-static inline placeholder const a_u16_3 = placeholder_arg_3{placeholder_value_type{array<u16>{}}, 146, placeholder_arg_base::calc_identity<array<u16>, 146>()};
-static inline placeholder const a_u16_4 = placeholder_arg_4{placeholder_value_type{array<u16>{}}, 147, placeholder_arg_base::calc_identity<array<u16>, 147>()};
-static inline placeholder const a_u16_5 = placeholder_arg_5{placeholder_value_type{array<u16>{}}, 148, placeholder_arg_base::calc_identity<array<u16>, 148>()};
-static inline placeholder const a_u16_6 = placeholder_arg_6{placeholder_value_type{array<u16>{}}, 149, placeholder_arg_base::calc_identity<array<u16>, 149>()};
-static inline placeholder const a_u16_7 = placeholder_arg_7{placeholder_value_type{array<u16>{}}, 150, placeholder_arg_base::calc_identity<array<u16>, 150>()};
-static inline placeholder const a_u16_8 = placeholder_arg_8{placeholder_value_type{array<u16>{}}, 151, placeholder_arg_base::calc_identity<array<u16>, 151>()};
-
-static inline placeholder const a_u32_1 = placeholder_arg_1{placeholder_value_type{array<u32>{}}, 152, placeholder_arg_base::calc_identity<array<i32>, 152>()};
-static inline placeholder const a_u32_2 = placeholder_arg_2{placeholder_value_type{array<u32>{}}, 153, placeholder_arg_base::calc_identity<array<i32>, 153>()};
-static inline placeholder const a_u32_3 = placeholder_arg_3{placeholder_value_type{array<u32>{}}, 154, placeholder_arg_base::calc_identity<array<i32>, 154>()};
-static inline placeholder const a_u32_4 = placeholder_arg_4{placeholder_value_type{array<u32>{}}, 155, placeholder_arg_base::calc_identity<array<i32>, 155>()};
-static inline placeholder const a_u32_5 = placeholder_arg_5{placeholder_value_type{array<u32>{}}, 156, placeholder_arg_base::calc_identity<array<i32>, 156>()};
-static inline placeholder const a_u32_6 = placeholder_arg_6{placeholder_value_type{array<u32>{}}, 157, placeholder_arg_base::calc_identity<array<i32>, 157>()};
-static inline placeholder const a_u32_7 = placeholder_arg_7{placeholder_value_type{array<u32>{}}, 158, placeholder_arg_base::calc_identity<array<i32>, 158>()};
-static inline placeholder const a_u32_8 = placeholder_arg_8{placeholder_value_type{array<u32>{}}, 159, placeholder_arg_base::calc_identity<array<i32>, 159>()};
-
-static inline placeholder const a_u64_1 = placeholder_arg_1{placeholder_value_type{array<u64>{}}, 160, placeholder_arg_base::calc_identity<array<i64>, 160>()};
-static inline placeholder const a_u64_2 = placeholder_arg_2{placeholder_value_type{array<u64>{}}, 161, placeholder_arg_base::calc_identity<array<i64>, 161>()};
-static inline placeholder const a_u64_3 = placeholder_arg_3{placeholder_value_type{array<u64>{}}, 162, placeholder_arg_base::calc_identity<array<i64>, 162>()};
-static inline placeholder const a_u64_4 = placeholder_arg_4{placeholder_value_type{array<u64>{}}, 163, placeholder_arg_base::calc_identity<array<i64>, 163>()};
-static inline placeholder const a_u64_5 = placeholder_arg_5{placeholder_value_type{array<u64>{}}, 164, placeholder_arg_base::calc_identity<array<i64>, 164>()};
-static inline placeholder const a_u64_6 = placeholder_arg_6{placeholder_value_type{array<u64>{}}, 165, placeholder_arg_base::calc_identity<array<i64>, 165>()};
-static inline placeholder const a_u64_7 = placeholder_arg_7{placeholder_value_type{array<u64>{}}, 166, placeholder_arg_base::calc_identity<array<i64>, 166>()};
-static inline placeholder const a_u64_8 = placeholder_arg_8{placeholder_value_type{array<u64>{}}, 167, placeholder_arg_base::calc_identity<array<i64>, 167>()};
-
-static inline placeholder const a_fp16a_1 = placeholder_arg_1{placeholder_value_type{array<fp16a>{}}, 168, placeholder_arg_base::calc_identity<array<fp16a>, 168>()};
-static inline placeholder const a_fp16a_2 = placeholder_arg_2{placeholder_value_type{array<fp16a>{}}, 169, placeholder_arg_base::calc_identity<array<fp16a>, 169>()};
-static inline placeholder const a_fp16a_3 = placeholder_arg_3{placeholder_value_type{array<fp16a>{}}, 170, placeholder_arg_base::calc_identity<array<fp16a>, 170>()};
-static inline placeholder const a_fp16a_4 = placeholder_arg_4{placeholder_value_type{array<fp16a>{}}, 171, placeholder_arg_base::calc_identity<array<fp16a>, 171>()};
-static inline placeholder const a_fp16a_5 = placeholder_arg_5{placeholder_value_type{array<fp16a>{}}, 172, placeholder_arg_base::calc_identity<array<fp16a>, 172>()};
-static inline placeholder const a_fp16a_6 = placeholder_arg_6{placeholder_value_type{array<fp16a>{}}, 173, placeholder_arg_base::calc_identity<array<fp16a>, 173>()};
-static inline placeholder const a_fp16a_7 = placeholder_arg_7{placeholder_value_type{array<fp16a>{}}, 174, placeholder_arg_base::calc_identity<array<fp16a>, 174>()};
-static inline placeholder const a_fp16a_8 = placeholder_arg_8{placeholder_value_type{array<fp16a>{}}, 175, placeholder_arg_base::calc_identity<array<fp16a>, 175>()};
-
-static inline placeholder const a_fp16b_1 = placeholder_arg_1{placeholder_value_type{array<fp16b>{}}, 176, placeholder_arg_base::calc_identity<array<fp16b>, 176>()};
-static inline placeholder const a_fp16b_2 = placeholder_arg_2{placeholder_value_type{array<fp16b>{}}, 177, placeholder_arg_base::calc_identity<array<fp16b>, 177>()};
-static inline placeholder const a_fp16b_3 = placeholder_arg_3{placeholder_value_type{array<fp16b>{}}, 178, placeholder_arg_base::calc_identity<array<fp16b>, 178>()};
-static inline placeholder const a_fp16b_4 = placeholder_arg_4{placeholder_value_type{array<fp16b>{}}, 179, placeholder_arg_base::calc_identity<array<fp16b>, 179>()};
-static inline placeholder const a_fp16b_5 = placeholder_arg_5{placeholder_value_type{array<fp16b>{}}, 180, placeholder_arg_base::calc_identity<array<fp16b>, 180>()};
-static inline placeholder const a_fp16b_6 = placeholder_arg_6{placeholder_value_type{array<fp16b>{}}, 181, placeholder_arg_base::calc_identity<array<fp16b>, 181>()};
-static inline placeholder const a_fp16b_7 = placeholder_arg_7{placeholder_value_type{array<fp16b>{}}, 182, placeholder_arg_base::calc_identity<array<fp16b>, 182>()};
-static inline placeholder const a_fp16b_8 = placeholder_arg_8{placeholder_value_type{array<fp16b>{}}, 183, placeholder_arg_base::calc_identity<array<fp16b>, 183>()};
-
-static inline placeholder const a_fp32_1 = placeholder_arg_1{placeholder_value_type{array<fp32>{}}, 184, placeholder_arg_base::calc_identity<array<fp32>, 184>()};
-static inline placeholder const a_fp32_2 = placeholder_arg_2{placeholder_value_type{array<fp32>{}}, 185, placeholder_arg_base::calc_identity<array<fp32>, 185>()};
-static inline placeholder const a_fp32_3 = placeholder_arg_3{placeholder_value_type{array<fp32>{}}, 186, placeholder_arg_base::calc_identity<array<fp32>, 186>()};
-static inline placeholder const a_fp32_4 = placeholder_arg_4{placeholder_value_type{array<fp32>{}}, 187, placeholder_arg_base::calc_identity<array<fp32>, 187>()};
-static inline placeholder const a_fp32_5 = placeholder_arg_5{placeholder_value_type{array<fp32>{}}, 188, placeholder_arg_base::calc_identity<array<fp32>, 188>()};
-static inline placeholder const a_fp32_6 = placeholder_arg_6{placeholder_value_type{array<fp32>{}}, 189, placeholder_arg_base::calc_identity<array<fp32>, 189>()};
-static inline placeholder const a_fp32_7 = placeholder_arg_7{placeholder_value_type{array<fp32>{}}, 190, placeholder_arg_base::calc_identity<array<fp32>, 190>()};
-static inline placeholder const a_fp32_8 = placeholder_arg_8{placeholder_value_type{array<fp32>{}}, 191, placeholder_arg_base::calc_identity<array<fp32>, 191>()};
-
-static inline placeholder const a_fp64_1 = placeholder_arg_1{placeholder_value_type{array<fp64>{}}, 192, placeholder_arg_base::calc_identity<array<fp64>, 192>()};
-static inline placeholder const a_fp64_2 = placeholder_arg_2{placeholder_value_type{array<fp64>{}}, 193, placeholder_arg_base::calc_identity<array<fp64>, 193>()};
-static inline placeholder const a_fp64_3 = placeholder_arg_3{placeholder_value_type{array<fp64>{}}, 194, placeholder_arg_base::calc_identity<array<fp64>, 194>()};
-static inline placeholder const a_fp64_4 = placeholder_arg_4{placeholder_value_type{array<fp64>{}}, 195, placeholder_arg_base::calc_identity<array<fp64>, 195>()};
-static inline placeholder const a_fp64_5 = placeholder_arg_5{placeholder_value_type{array<fp64>{}}, 196, placeholder_arg_base::calc_identity<array<fp64>, 196>()};
-static inline placeholder const a_fp64_6 = placeholder_arg_6{placeholder_value_type{array<fp64>{}}, 197, placeholder_arg_base::calc_identity<array<fp64>, 197>()};
-static inline placeholder const a_fp64_7 = placeholder_arg_7{placeholder_value_type{array<fp64>{}}, 198, placeholder_arg_base::calc_identity<array<fp64>, 198>()};
-static inline placeholder const a_fp64_8 = placeholder_arg_8{placeholder_value_type{array<fp64>{}}, 199, placeholder_arg_base::calc_identity<array<fp64>, 199>()};
-
-static inline placeholder const a_bool_1 = placeholder_arg_1{placeholder_value_type{array<boolean>{}}, 200, placeholder_arg_base::calc_identity<array<boolean>, 200>()};
-static inline placeholder const a_bool_2 = placeholder_arg_2{placeholder_value_type{array<boolean>{}}, 201, placeholder_arg_base::calc_identity<array<boolean>, 201>()};
-static inline placeholder const a_bool_3 = placeholder_arg_3{placeholder_value_type{array<boolean>{}}, 202, placeholder_arg_base::calc_identity<array<boolean>, 202>()};
-static inline placeholder const a_bool_4 = placeholder_arg_4{placeholder_value_type{array<boolean>{}}, 203, placeholder_arg_base::calc_identity<array<boolean>, 203>()};
-static inline placeholder const a_bool_5 = placeholder_arg_5{placeholder_value_type{array<boolean>{}}, 204, placeholder_arg_base::calc_identity<array<boolean>, 204>()};
-static inline placeholder const a_bool_6 = placeholder_arg_6{placeholder_value_type{array<boolean>{}}, 205, placeholder_arg_base::calc_identity<array<boolean>, 205>()};
-static inline placeholder const a_bool_7 = placeholder_arg_7{placeholder_value_type{array<boolean>{}}, 206, placeholder_arg_base::calc_identity<array<boolean>, 206>()};
-static inline placeholder const a_bool_8 = placeholder_arg_8{placeholder_value_type{array<boolean>{}}, 207, placeholder_arg_base::calc_identity<array<boolean>, 207>()};
-
-static inline placeholder const m_i8_1 = placeholder_arg_1{placeholder_value_type{matrix<i8>{}}, 208, placeholder_arg_base::calc_identity<matrix<i8>, 208>()};
-static inline placeholder const m_i8_2 = placeholder_arg_2{placeholder_value_type{matrix<i8>{}}, 209, placeholder_arg_base::calc_identity<matrix<i8>, 209>()};
-static inline placeholder const m_i8_3 = placeholder_arg_3{placeholder_value_type{matrix<i8>{}}, 210, placeholder_arg_base::calc_identity<matrix<i8>, 210>()};
-static inline placeholder const m_i8_4 = placeholder_arg_4{placeholder_value_type{matrix<i8>{}}, 211, placeholder_arg_base::calc_identity<matrix<i8>, 211>()};
-static inline placeholder const m_i8_5 = placeholder_arg_5{placeholder_value_type{matrix<i8>{}}, 212, placeholder_arg_base::calc_identity<matrix<i8>, 212>()};
-static inline placeholder const m_i8_6 = placeholder_arg_6{placeholder_value_type{matrix<i8>{}}, 213, placeholder_arg_base::calc_identity<matrix<i8>, 213>()};
-static inline placeholder const m_i8_7 = placeholder_arg_7{placeholder_value_type{matrix<i8>{}}, 214, placeholder_arg_base::calc_identity<matrix<i8>, 214>()};
-static inline placeholder const m_i8_8 = placeholder_arg_8{placeholder_value_type{matrix<i8>{}}, 215, placeholder_arg_base::calc_identity<matrix<i8>, 215>()};
-
-static inline placeholder const m_i16_1 = placeholder_arg_1{placeholder_value_type{matrix<i16>{}}, 216, placeholder_arg_base::calc_identity<matrix<i16>, 216>()};
-static inline placeholder const m_i16_2 = placeholder_arg_2{placeholder_value_type{matrix<i16>{}}, 217, placeholder_arg_base::calc_identity<matrix<i16>, 217>()};
-static inline placeholder const m_i16_3 = placeholder_arg_3{placeholder_value_type{matrix<i16>{}}, 218, placeholder_arg_base::calc_identity<matrix<i16>, 218>()};
-static inline placeholder const m_i16_4 = placeholder_arg_4{placeholder_value_type{matrix<i16>{}}, 219, placeholder_arg_base::calc_identity<matrix<i16>, 219>()};
-static inline placeholder const m_i16_5 = placeholder_arg_5{placeholder_value_type{matrix<i16>{}}, 220, placeholder_arg_base::calc_identity<matrix<i16>, 220>()};
-static inline placeholder const m_i16_6 = placeholder_arg_6{placeholder_value_type{matrix<i16>{}}, 221, placeholder_arg_base::calc_identity<matrix<i16>, 221>()};
-static inline placeholder const m_i16_7 = placeholder_arg_7{placeholder_value_type{matrix<i16>{}}, 222, placeholder_arg_base::calc_identity<matrix<i16>, 222>()};
-static inline placeholder const m_i16_8 = placeholder_arg_8{placeholder_value_type{matrix<i16>{}}, 223, placeholder_arg_base::calc_identity<matrix<i16>, 223>()};
-
-static inline placeholder const m_i32_1 = placeholder_arg_1{placeholder_value_type{matrix<i32>{}}, 224, placeholder_arg_base::calc_identity<matrix<i32>, 224>()};
-static inline placeholder const m_i32_2 = placeholder_arg_2{placeholder_value_type{matrix<i32>{}}, 225, placeholder_arg_base::calc_identity<matrix<i32>, 225>()};
-static inline placeholder const m_i32_3 = placeholder_arg_3{placeholder_value_type{matrix<i32>{}}, 226, placeholder_arg_base::calc_identity<matrix<i32>, 226>()};
-static inline placeholder const m_i32_4 = placeholder_arg_4{placeholder_value_type{matrix<i32>{}}, 227, placeholder_arg_base::calc_identity<matrix<i32>, 227>()};
-static inline placeholder const m_i32_5 = placeholder_arg_5{placeholder_value_type{matrix<i32>{}}, 228, placeholder_arg_base::calc_identity<matrix<i32>, 228>()};
-static inline placeholder const m_i32_6 = placeholder_arg_6{placeholder_value_type{matrix<i32>{}}, 229, placeholder_arg_base::calc_identity<matrix<i32>, 229>()};
-static inline placeholder const m_i32_7 = placeholder_arg_7{placeholder_value_type{matrix<i32>{}}, 230, placeholder_arg_base::calc_identity<matrix<i32>, 230>()};
-static inline placeholder const m_i32_8 = placeholder_arg_8{placeholder_value_type{matrix<i32>{}}, 231, placeholder_arg_base::calc_identity<matrix<i32>, 231>()};
-
-static inline placeholder const m_i64_1 = placeholder_arg_1{placeholder_value_type{matrix<i64>{}}, 232, placeholder_arg_base::calc_identity<matrix<i64>, 232>()};
-static inline placeholder const m_i64_2 = placeholder_arg_2{placeholder_value_type{matrix<i64>{}}, 233, placeholder_arg_base::calc_identity<matrix<i64>, 233>()};
-static inline placeholder const m_i64_3 = placeholder_arg_3{placeholder_value_type{matrix<i64>{}}, 234, placeholder_arg_base::calc_identity<matrix<i64>, 234>()};
-static inline placeholder const m_i64_4 = placeholder_arg_4{placeholder_value_type{matrix<i64>{}}, 235, placeholder_arg_base::calc_identity<matrix<i64>, 235>()};
-static inline placeholder const m_i64_5 = placeholder_arg_5{placeholder_value_type{matrix<i64>{}}, 236, placeholder_arg_base::calc_identity<matrix<i64>, 236>()};
-static inline placeholder const m_i64_6 = placeholder_arg_6{placeholder_value_type{matrix<i64>{}}, 237, placeholder_arg_base::calc_identity<matrix<i64>, 237>()};
-static inline placeholder const m_i64_7 = placeholder_arg_7{placeholder_value_type{matrix<i64>{}}, 238, placeholder_arg_base::calc_identity<matrix<i64>, 238>()};
-static inline placeholder const m_i64_8 = placeholder_arg_8{placeholder_value_type{matrix<i64>{}}, 239, placeholder_arg_base::calc_identity<matrix<i64>, 239>()};
-
-static inline placeholder const m_u8_1 = placeholder_arg_1{placeholder_value_type{matrix<u8>{}}, 240, placeholder_arg_base::calc_identity<matrix<u8>, 240>()};
-static inline placeholder const m_u8_2 = placeholder_arg_2{placeholder_value_type{matrix<u8>{}}, 241, placeholder_arg_base::calc_identity<matrix<u8>, 241>()};
-static inline placeholder const m_u8_3 = placeholder_arg_3{placeholder_value_type{matrix<u8>{}}, 242, placeholder_arg_base::calc_identity<matrix<u8>, 242>()};
-static inline placeholder const m_u8_4 = placeholder_arg_4{placeholder_value_type{matrix<u8>{}}, 243, placeholder_arg_base::calc_identity<matrix<u8>, 243>()};
-static inline placeholder const m_u8_5 = placeholder_arg_5{placeholder_value_type{matrix<u8>{}}, 244, placeholder_arg_base::calc_identity<matrix<u8>, 244>()};
-static inline placeholder const m_u8_6 = placeholder_arg_6{placeholder_value_type{matrix<u8>{}}, 245, placeholder_arg_base::calc_identity<matrix<u8>, 245>()};
-static inline placeholder const m_u8_7 = placeholder_arg_7{placeholder_value_type{matrix<u8>{}}, 246, placeholder_arg_base::calc_identity<matrix<u8>, 246>()};
-static inline placeholder const m_u8_8 = placeholder_arg_8{placeholder_value_type{matrix<u8>{}}, 247, placeholder_arg_base::calc_identity<matrix<u8>, 247>()};
-
-static inline placeholder const m_u16_1 = placeholder_arg_1{placeholder_value_type{matrix<u16>{}}, 248, placeholder_arg_base::calc_identity<matrix<u16>, 248>()};
-static inline placeholder const m_u16_2 = placeholder_arg_2{placeholder_value_type{matrix<u16>{}}, 249, placeholder_arg_base::calc_identity<matrix<u16>, 249>()};
-static inline placeholder const m_u16_3 = placeholder_arg_3{placeholder_value_type{matrix<u16>{}}, 250, placeholder_arg_base::calc_identity<matrix<u16>, 250>()};
-static inline placeholder const m_u16_4 = placeholder_arg_4{placeholder_value_type{matrix<u16>{}}, 251, placeholder_arg_base::calc_identity<matrix<u16>, 251>()};
-static inline placeholder const m_u16_5 = placeholder_arg_5{placeholder_value_type{matrix<u16>{}}, 252, placeholder_arg_base::calc_identity<matrix<u16>, 252>()};
-static inline placeholder const m_u16_6 = placeholder_arg_6{placeholder_value_type{matrix<u16>{}}, 253, placeholder_arg_base::calc_identity<matrix<u16>, 253>()};
-static inline placeholder const m_u16_7 = placeholder_arg_7{placeholder_value_type{matrix<u16>{}}, 254, placeholder_arg_base::calc_identity<matrix<u16>, 254>()};
-static inline placeholder const m_u16_8 = placeholder_arg_8{placeholder_value_type{matrix<u16>{}}, 255, placeholder_arg_base::calc_identity<matrix<u16>, 255>()};
-
-static inline placeholder const m_u32_1 = placeholder_arg_1{placeholder_value_type{matrix<u32>{}}, 256, placeholder_arg_base::calc_identity<matrix<u32>, 256>()};
-static inline placeholder const m_u32_2 = placeholder_arg_2{placeholder_value_type{matrix<u32>{}}, 257, placeholder_arg_base::calc_identity<matrix<u32>, 257>()};
-static inline placeholder const m_u32_3 = placeholder_arg_3{placeholder_value_type{matrix<u32>{}}, 258, placeholder_arg_base::calc_identity<matrix<u32>, 258>()};
-static inline placeholder const m_u32_4 = placeholder_arg_4{placeholder_value_type{matrix<u32>{}}, 259, placeholder_arg_base::calc_identity<matrix<u32>, 259>()};
-static inline placeholder const m_u32_5 = placeholder_arg_5{placeholder_value_type{matrix<u32>{}}, 260, placeholder_arg_base::calc_identity<matrix<u32>, 260>()};
-static inline placeholder const m_u32_6 = placeholder_arg_6{placeholder_value_type{matrix<u32>{}}, 261, placeholder_arg_base::calc_identity<matrix<u32>, 261>()};
-static inline placeholder const m_u32_7 = placeholder_arg_7{placeholder_value_type{matrix<u32>{}}, 262, placeholder_arg_base::calc_identity<matrix<u32>, 262>()};
-static inline placeholder const m_u32_8 = placeholder_arg_8{placeholder_value_type{matrix<u32>{}}, 263, placeholder_arg_base::calc_identity<matrix<u32>, 263>()};
-
-static inline placeholder const m_u64_1 = placeholder_arg_1{placeholder_value_type{matrix<u64>{}}, 264, placeholder_arg_base::calc_identity<matrix<u64>, 264>()};
-static inline placeholder const m_u64_2 = placeholder_arg_2{placeholder_value_type{matrix<u64>{}}, 265, placeholder_arg_base::calc_identity<matrix<u64>, 265>()};
-static inline placeholder const m_u64_3 = placeholder_arg_3{placeholder_value_type{matrix<u64>{}}, 266, placeholder_arg_base::calc_identity<matrix<u64>, 266>()};
-static inline placeholder const m_u64_4 = placeholder_arg_4{placeholder_value_type{matrix<u64>{}}, 267, placeholder_arg_base::calc_identity<matrix<u64>, 267>()};
-static inline placeholder const m_u64_5 = placeholder_arg_5{placeholder_value_type{matrix<u64>{}}, 268, placeholder_arg_base::calc_identity<matrix<u64>, 268>()};
-static inline placeholder const m_u64_6 = placeholder_arg_6{placeholder_value_type{matrix<u64>{}}, 269, placeholder_arg_base::calc_identity<matrix<u64>, 269>()};
-static inline placeholder const m_u64_7 = placeholder_arg_7{placeholder_value_type{matrix<u64>{}}, 270, placeholder_arg_base::calc_identity<matrix<u64>, 270>()};
-static inline placeholder const m_u64_8 = placeholder_arg_8{placeholder_value_type{matrix<u64>{}}, 271, placeholder_arg_base::calc_identity<matrix<u64>, 271>()};
-
-static inline placeholder const m_fp16a_1 = placeholder_arg_1{placeholder_value_type{matrix<fp16a>{}}, 272, placeholder_arg_base::calc_identity<matrix<fp16a>, 272>()};
-static inline placeholder const m_fp16a_2 = placeholder_arg_2{placeholder_value_type{matrix<fp16a>{}}, 273, placeholder_arg_base::calc_identity<matrix<fp16a>, 273>()};
-static inline placeholder const m_fp16a_3 = placeholder_arg_3{placeholder_value_type{matrix<fp16a>{}}, 274, placeholder_arg_base::calc_identity<matrix<fp16a>, 274>()};
-static inline placeholder const m_fp16a_4 = placeholder_arg_4{placeholder_value_type{matrix<fp16a>{}}, 275, placeholder_arg_base::calc_identity<matrix<fp16a>, 275>()};
-static inline placeholder const m_fp16a_5 = placeholder_arg_5{placeholder_value_type{matrix<fp16a>{}}, 276, placeholder_arg_base::calc_identity<matrix<fp16a>, 276>()};
-static inline placeholder const m_fp16a_6 = placeholder_arg_6{placeholder_value_type{matrix<fp16a>{}}, 277, placeholder_arg_base::calc_identity<matrix<fp16a>, 277>()};
-static inline placeholder const m_fp16a_7 = placeholder_arg_7{placeholder_value_type{matrix<fp16a>{}}, 278, placeholder_arg_base::calc_identity<matrix<fp16a>, 278>()};
-static inline placeholder const m_fp16a_8 = placeholder_arg_8{placeholder_value_type{matrix<fp16a>{}}, 279, placeholder_arg_base::calc_identity<matrix<fp16a>, 279>()};
-
-static inline placeholder const m_fp16b_1 = placeholder_arg_1{placeholder_value_type{matrix<fp16b>{}}, 280, placeholder_arg_base::calc_identity<matrix<fp16b>, 280>()};
-static inline placeholder const m_fp16b_2 = placeholder_arg_2{placeholder_value_type{matrix<fp16b>{}}, 281, placeholder_arg_base::calc_identity<matrix<fp16b>, 281>()};
-static inline placeholder const m_fp16b_3 = placeholder_arg_3{placeholder_value_type{matrix<fp16b>{}}, 282, placeholder_arg_base::calc_identity<matrix<fp16b>, 282>()};
-static inline placeholder const m_fp16b_4 = placeholder_arg_4{placeholder_value_type{matrix<fp16b>{}}, 283, placeholder_arg_base::calc_identity<matrix<fp16b>, 283>()};
-static inline placeholder const m_fp16b_5 = placeholder_arg_5{placeholder_value_type{matrix<fp16b>{}}, 284, placeholder_arg_base::calc_identity<matrix<fp16b>, 284>()};
-static inline placeholder const m_fp16b_6 = placeholder_arg_6{placeholder_value_type{matrix<fp16b>{}}, 285, placeholder_arg_base::calc_identity<matrix<fp16b>, 285>()};
-static inline placeholder const m_fp16b_7 = placeholder_arg_7{placeholder_value_type{matrix<fp16b>{}}, 286, placeholder_arg_base::calc_identity<matrix<fp16b>, 286>()};
-static inline placeholder const m_fp16b_8 = placeholder_arg_8{placeholder_value_type{matrix<fp16b>{}}, 287, placeholder_arg_base::calc_identity<matrix<fp16b>, 287>()};
-
-static inline placeholder const m_fp32_1 = placeholder_arg_1{placeholder_value_type{matrix<fp32>{}}, 288, placeholder_arg_base::calc_identity<matrix<fp32>, 288>()};
-static inline placeholder const m_fp32_2 = placeholder_arg_2{placeholder_value_type{matrix<fp32>{}}, 289, placeholder_arg_base::calc_identity<matrix<fp32>, 289>()};
-static inline placeholder const m_fp32_3 = placeholder_arg_3{placeholder_value_type{matrix<fp32>{}}, 290, placeholder_arg_base::calc_identity<matrix<fp32>, 290>()};
-static inline placeholder const m_fp32_4 = placeholder_arg_4{placeholder_value_type{matrix<fp32>{}}, 291, placeholder_arg_base::calc_identity<matrix<fp32>, 291>()};
-static inline placeholder const m_fp32_5 = placeholder_arg_5{placeholder_value_type{matrix<fp32>{}}, 292, placeholder_arg_base::calc_identity<matrix<fp32>, 292>()};
-static inline placeholder const m_fp32_6 = placeholder_arg_6{placeholder_value_type{matrix<fp32>{}}, 293, placeholder_arg_base::calc_identity<matrix<fp32>, 293>()};
-static inline placeholder const m_fp32_7 = placeholder_arg_7{placeholder_value_type{matrix<fp32>{}}, 294, placeholder_arg_base::calc_identity<matrix<fp32>, 294>()};
-static inline placeholder const m_fp32_8 = placeholder_arg_8{placeholder_value_type{matrix<fp32>{}}, 295, placeholder_arg_base::calc_identity<matrix<fp32>, 295>()};
-
-static inline placeholder const m_fp64_1 = placeholder_arg_1{placeholder_value_type{matrix<fp64>{}}, 296, placeholder_arg_base::calc_identity<matrix<fp64>, 296>()};
-static inline placeholder const m_fp64_2 = placeholder_arg_2{placeholder_value_type{matrix<fp64>{}}, 297, placeholder_arg_base::calc_identity<matrix<fp64>, 297>()};
-static inline placeholder const m_fp64_3 = placeholder_arg_3{placeholder_value_type{matrix<fp64>{}}, 298, placeholder_arg_base::calc_identity<matrix<fp64>, 298>()};
-static inline placeholder const m_fp64_4 = placeholder_arg_4{placeholder_value_type{matrix<fp64>{}}, 299, placeholder_arg_base::calc_identity<matrix<fp64>, 299>()};
-static inline placeholder const m_fp64_5 = placeholder_arg_5{placeholder_value_type{matrix<fp64>{}}, 300, placeholder_arg_base::calc_identity<matrix<fp64>, 300>()};
-static inline placeholder const m_fp64_6 = placeholder_arg_6{placeholder_value_type{matrix<fp64>{}}, 301, placeholder_arg_base::calc_identity<matrix<fp64>, 301>()};
-static inline placeholder const m_fp64_7 = placeholder_arg_7{placeholder_value_type{matrix<fp64>{}}, 302, placeholder_arg_base::calc_identity<matrix<fp64>, 302>()};
-static inline placeholder const m_fp64_8 = placeholder_arg_8{placeholder_value_type{matrix<fp64>{}}, 303, placeholder_arg_base::calc_identity<matrix<fp64>, 303>()};
-
-static inline placeholder const m_bool_1 = placeholder_arg_1{placeholder_value_type{matrix<boolean>{}}, 304, placeholder_arg_base::calc_identity<matrix<boolean>, 304>()};
-static inline placeholder const m_bool_2 = placeholder_arg_2{placeholder_value_type{matrix<boolean>{}}, 305, placeholder_arg_base::calc_identity<matrix<boolean>, 305>()};
-static inline placeholder const m_bool_3 = placeholder_arg_3{placeholder_value_type{matrix<boolean>{}}, 306, placeholder_arg_base::calc_identity<matrix<boolean>, 306>()};
-static inline placeholder const m_bool_4 = placeholder_arg_4{placeholder_value_type{matrix<boolean>{}}, 307, placeholder_arg_base::calc_identity<matrix<boolean>, 307>()};
-static inline placeholder const m_bool_5 = placeholder_arg_5{placeholder_value_type{matrix<boolean>{}}, 308, placeholder_arg_base::calc_identity<matrix<boolean>, 308>()};
-static inline placeholder const m_bool_6 = placeholder_arg_6{placeholder_value_type{matrix<boolean>{}}, 309, placeholder_arg_base::calc_identity<matrix<boolean>, 309>()};
-static inline placeholder const m_bool_7 = placeholder_arg_7{placeholder_value_type{matrix<boolean>{}}, 310, placeholder_arg_base::calc_identity<matrix<boolean>, 310>()};
-static inline placeholder const m_bool_8 = placeholder_arg_8{placeholder_value_type{matrix<boolean>{}}, 311, placeholder_arg_base::calc_identity<matrix<boolean>, 311>()};
+inline constexpr placeholder s_i8_1 = placeholder_arg_1::make<scalar<i8>, 0>();
+inline constexpr placeholder s_i8_2 = placeholder_arg_2::make<scalar<i8>, 1>();
+inline constexpr placeholder s_i8_3 = placeholder_arg_3::make<scalar<i8>, 2>();
+inline constexpr placeholder s_i8_4 = placeholder_arg_4::make<scalar<i8>, 3>();
+inline constexpr placeholder s_i8_5 = placeholder_arg_5::make<scalar<i8>, 4>();
+inline constexpr placeholder s_i8_6 = placeholder_arg_6::make<scalar<i8>, 5>();
+inline constexpr placeholder s_i8_7 = placeholder_arg_7::make<scalar<i8>, 6>();
+inline constexpr placeholder s_i8_8 = placeholder_arg_8::make<scalar<i8>, 7>();
+
+inline constexpr placeholder s_i16_1 = placeholder_arg_1::make<scalar<i16>, 8>();
+inline constexpr placeholder s_i16_2 = placeholder_arg_2::make<scalar<i16>, 9>();
+inline constexpr placeholder s_i16_3 = placeholder_arg_3::make<scalar<i16>, 10>();
+inline constexpr placeholder s_i16_4 = placeholder_arg_4::make<scalar<i16>, 11>();
+inline constexpr placeholder s_i16_5 = placeholder_arg_5::make<scalar<i16>, 12>();
+inline constexpr placeholder s_i16_6 = placeholder_arg_6::make<scalar<i16>, 13>();
+inline constexpr placeholder s_i16_7 = placeholder_arg_7::make<scalar<i16>, 14>();
+inline constexpr placeholder s_i16_8 = placeholder_arg_8::make<scalar<i16>, 15>();
+
+inline constexpr placeholder s_i32_1 = placeholder_arg_1::make<scalar<i32>, 16>();
+inline constexpr placeholder s_i32_2 = placeholder_arg_2::make<scalar<i32>, 17>();
+inline constexpr placeholder s_i32_3 = placeholder_arg_3::make<scalar<i32>, 18>();
+inline constexpr placeholder s_i32_4 = placeholder_arg_4::make<scalar<i32>, 19>();
+inline constexpr placeholder s_i32_5 = placeholder_arg_5::make<scalar<i32>, 20>();
+inline constexpr placeholder s_i32_6 = placeholder_arg_6::make<scalar<i32>, 21>();
+inline constexpr placeholder s_i32_7 = placeholder_arg_7::make<scalar<i32>, 22>();
+inline constexpr placeholder s_i32_8 = placeholder_arg_8::make<scalar<i32>, 23>();
+
+inline constexpr placeholder s_i64_1 = placeholder_arg_1::make<scalar<i64>, 24>();
+inline constexpr placeholder s_i64_2 = placeholder_arg_2::make<scalar<i64>, 25>();
+inline constexpr placeholder s_i64_3 = placeholder_arg_3::make<scalar<i64>, 26>();
+inline constexpr placeholder s_i64_4 = placeholder_arg_4::make<scalar<i64>, 27>();
+inline constexpr placeholder s_i64_5 = placeholder_arg_5::make<scalar<i64>, 28>();
+inline constexpr placeholder s_i64_6 = placeholder_arg_6::make<scalar<i64>, 29>();
+inline constexpr placeholder s_i64_7 = placeholder_arg_7::make<scalar<i64>, 30>();
+inline constexpr placeholder s_i64_8 = placeholder_arg_8::make<scalar<i64>, 31>();
+
+inline constexpr placeholder s_u8_1 = placeholder_arg_1::make<scalar<u8>, 32>();
+inline constexpr placeholder s_u8_2 = placeholder_arg_2::make<scalar<u8>, 33>();
+inline constexpr placeholder s_u8_3 = placeholder_arg_3::make<scalar<u8>, 34>();
+inline constexpr placeholder s_u8_4 = placeholder_arg_4::make<scalar<u8>, 35>();
+inline constexpr placeholder s_u8_5 = placeholder_arg_5::make<scalar<u8>, 36>();
+inline constexpr placeholder s_u8_6 = placeholder_arg_6::make<scalar<u8>, 37>();
+inline constexpr placeholder s_u8_7 = placeholder_arg_7::make<scalar<u8>, 38>();
+inline constexpr placeholder s_u8_8 = placeholder_arg_8::make<scalar<u8>, 39>();
+
+inline constexpr placeholder s_u16_1 = placeholder_arg_1::make<scalar<u16>, 40>();
+inline constexpr placeholder s_u16_2 = placeholder_arg_2::make<scalar<u16>, 41>();
+inline constexpr placeholder s_u16_3 = placeholder_arg_3::make<scalar<u16>, 42>();
+inline constexpr placeholder s_u16_4 = placeholder_arg_4::make<scalar<u16>, 43>();
+inline constexpr placeholder s_u16_5 = placeholder_arg_5::make<scalar<u16>, 44>();
+inline constexpr placeholder s_u16_6 = placeholder_arg_6::make<scalar<u16>, 45>();
+inline constexpr placeholder s_u16_7 = placeholder_arg_7::make<scalar<u16>, 46>();
+inline constexpr placeholder s_u16_8 = placeholder_arg_8::make<scalar<u16>, 47>();
+
+inline constexpr placeholder s_u32_1 = placeholder_arg_1::make<scalar<u32>, 48>();
+inline constexpr placeholder s_u32_2 = placeholder_arg_2::make<scalar<u32>, 49>();
+inline constexpr placeholder s_u32_3 = placeholder_arg_3::make<scalar<u32>, 50>();
+inline constexpr placeholder s_u32_4 = placeholder_arg_4::make<scalar<u32>, 51>();
+inline constexpr placeholder s_u32_5 = placeholder_arg_5::make<scalar<u32>, 52>();
+inline constexpr placeholder s_u32_6 = placeholder_arg_6::make<scalar<u32>, 53>();
+inline constexpr placeholder s_u32_7 = placeholder_arg_7::make<scalar<u32>, 54>();
+inline constexpr placeholder s_u32_8 = placeholder_arg_8::make<scalar<u32>, 55>();
+
+inline constexpr placeholder s_u64_1 = placeholder_arg_1::make<scalar<u64>, 56>();
+inline constexpr placeholder s_u64_2 = placeholder_arg_2::make<scalar<u64>, 57>();
+inline constexpr placeholder s_u64_3 = placeholder_arg_3::make<scalar<u64>, 58>();
+inline constexpr placeholder s_u64_4 = placeholder_arg_4::make<scalar<u64>, 59>();
+inline constexpr placeholder s_u64_5 = placeholder_arg_5::make<scalar<u64>, 60>();
+inline constexpr placeholder s_u64_6 = placeholder_arg_6::make<scalar<u64>, 61>();
+inline constexpr placeholder s_u64_7 = placeholder_arg_7::make<scalar<u64>, 62>();
+inline constexpr placeholder s_u64_8 = placeholder_arg_8::make<scalar<u64>, 63>();
+
+inline constexpr placeholder s_fp16a_1 = placeholder_arg_1::make<scalar<fp16a>, 64>();
+inline constexpr placeholder s_fp16a_2 = placeholder_arg_2::make<scalar<fp16a>, 65>();
+inline constexpr placeholder s_fp16a_3 = placeholder_arg_3::make<scalar<fp16a>, 66>();
+inline constexpr placeholder s_fp16a_4 = placeholder_arg_4::make<scalar<fp16a>, 67>();
+inline constexpr placeholder s_fp16a_5 = placeholder_arg_5::make<scalar<fp16a>, 68>();
+inline constexpr placeholder s_fp16a_6 = placeholder_arg_6::make<scalar<fp16a>, 69>();
+inline constexpr placeholder s_fp16a_7 = placeholder_arg_7::make<scalar<fp16a>, 70>();
+inline constexpr placeholder s_fp16a_8 = placeholder_arg_8::make<scalar<fp16a>, 71>();
+
+inline constexpr placeholder s_fp16b_1 = placeholder_arg_1::make<scalar<fp16b>, 72>();
+inline constexpr placeholder s_fp16b_2 = placeholder_arg_2::make<scalar<fp16b>, 73>();
+inline constexpr placeholder s_fp16b_3 = placeholder_arg_3::make<scalar<fp16b>, 74>();
+inline constexpr placeholder s_fp16b_4 = placeholder_arg_4::make<scalar<fp16b>, 75>();
+inline constexpr placeholder s_fp16b_5 = placeholder_arg_5::make<scalar<fp16b>, 76>();
+inline constexpr placeholder s_fp16b_6 = placeholder_arg_6::make<scalar<fp16b>, 77>();
+inline constexpr placeholder s_fp16b_7 = placeholder_arg_7::make<scalar<fp16b>, 78>();
+inline constexpr placeholder s_fp16b_8 = placeholder_arg_8::make<scalar<fp16b>, 79>();
+
+inline constexpr placeholder s_fp32_1 = placeholder_arg_1::make<scalar<fp32>, 80>();
+inline constexpr placeholder s_fp32_2 = placeholder_arg_2::make<scalar<fp32>, 81>();
+inline constexpr placeholder s_fp32_3 = placeholder_arg_3::make<scalar<fp32>, 82>();
+inline constexpr placeholder s_fp32_4 = placeholder_arg_4::make<scalar<fp32>, 83>();
+inline constexpr placeholder s_fp32_5 = placeholder_arg_5::make<scalar<fp32>, 84>();
+inline constexpr placeholder s_fp32_6 = placeholder_arg_6::make<scalar<fp32>, 85>();
+inline constexpr placeholder s_fp32_7 = placeholder_arg_7::make<scalar<fp32>, 86>();
+inline constexpr placeholder s_fp32_8 = placeholder_arg_8::make<scalar<fp32>, 87>();
+
+inline constexpr placeholder s_fp64_1 = placeholder_arg_1::make<scalar<fp64>, 88>();
+inline constexpr placeholder s_fp64_2 = placeholder_arg_2::make<scalar<fp64>, 89>();
+inline constexpr placeholder s_fp64_3 = placeholder_arg_3::make<scalar<fp64>, 90>();
+inline constexpr placeholder s_fp64_4 = placeholder_arg_4::make<scalar<fp64>, 91>();
+inline constexpr placeholder s_fp64_5 = placeholder_arg_5::make<scalar<fp64>, 92>();
+inline constexpr placeholder s_fp64_6 = placeholder_arg_6::make<scalar<fp64>, 93>();
+inline constexpr placeholder s_fp64_7 = placeholder_arg_7::make<scalar<fp64>, 94>();
+inline constexpr placeholder s_fp64_8 = placeholder_arg_8::make<scalar<fp64>, 95>();
+
+inline constexpr placeholder s_bool_1 = placeholder_arg_1::make<scalar<boolean>, 96>();
+inline constexpr placeholder s_bool_2 = placeholder_arg_2::make<scalar<boolean>, 97>();
+inline constexpr placeholder s_bool_3 = placeholder_arg_3::make<scalar<boolean>, 98>();
+inline constexpr placeholder s_bool_4 = placeholder_arg_4::make<scalar<boolean>, 99>();
+inline constexpr placeholder s_bool_5 = placeholder_arg_5::make<scalar<boolean>, 100>();
+inline constexpr placeholder s_bool_6 = placeholder_arg_6::make<scalar<boolean>, 101>();
+inline constexpr placeholder s_bool_7 = placeholder_arg_7::make<scalar<boolean>, 102>();
+inline constexpr placeholder s_bool_8 = placeholder_arg_8::make<scalar<boolean>, 103>();
+
+inline constexpr placeholder a_i8_1 = placeholder_arg_1::make<array<i8>, 104>();
+inline constexpr placeholder a_i8_2 = placeholder_arg_2::make<array<i8>, 105>();
+inline constexpr placeholder a_i8_3 = placeholder_arg_3::make<array<i8>, 106>();
+inline constexpr placeholder a_i8_4 = placeholder_arg_4::make<array<i8>, 107>();
+inline constexpr placeholder a_i8_5 = placeholder_arg_5::make<array<i8>, 108>();
+inline constexpr placeholder a_i8_6 = placeholder_arg_6::make<array<i8>, 109>();
+inline constexpr placeholder a_i8_7 = placeholder_arg_7::make<array<i8>, 110>();
+inline constexpr placeholder a_i8_8 = placeholder_arg_8::make<array<i8>, 111>();
+
+inline constexpr placeholder a_i16_1 = placeholder_arg_1::make<array<i16>, 112>();
+inline constexpr placeholder a_i16_2 = placeholder_arg_2::make<array<i16>, 113>();
+inline constexpr placeholder a_i16_3 = placeholder_arg_3::make<array<i16>, 114>();
+inline constexpr placeholder a_i16_4 = placeholder_arg_4::make<array<i16>, 115>();
+inline constexpr placeholder a_i16_5 = placeholder_arg_5::make<array<i16>, 116>();
+inline constexpr placeholder a_i16_6 = placeholder_arg_6::make<array<i16>, 117>();
+inline constexpr placeholder a_i16_7 = placeholder_arg_7::make<array<i16>, 118>();
+inline constexpr placeholder a_i16_8 = placeholder_arg_8::make<array<i16>, 119>();
+
+inline constexpr placeholder a_i32_1 = placeholder_arg_1::make<array<i32>, 120>();
+inline constexpr placeholder a_i32_2 = placeholder_arg_2::make<array<i32>, 121>();
+inline constexpr placeholder a_i32_3 = placeholder_arg_3::make<array<i32>, 122>();
+inline constexpr placeholder a_i32_4 = placeholder_arg_4::make<array<i32>, 123>();
+inline constexpr placeholder a_i32_5 = placeholder_arg_5::make<array<i32>, 124>();
+inline constexpr placeholder a_i32_6 = placeholder_arg_6::make<array<i32>, 125>();
+inline constexpr placeholder a_i32_7 = placeholder_arg_7::make<array<i32>, 126>();
+inline constexpr placeholder a_i32_8 = placeholder_arg_8::make<array<i32>, 127>();
+
+inline constexpr placeholder a_i64_1 = placeholder_arg_1::make<array<i64>, 128>();
+inline constexpr placeholder a_i64_2 = placeholder_arg_2::make<array<i64>, 129>();
+inline constexpr placeholder a_i64_3 = placeholder_arg_3::make<array<i64>, 130>();
+inline constexpr placeholder a_i64_4 = placeholder_arg_4::make<array<i64>, 131>();
+inline constexpr placeholder a_i64_5 = placeholder_arg_5::make<array<i64>, 132>();
+inline constexpr placeholder a_i64_6 = placeholder_arg_6::make<array<i64>, 133>();
+inline constexpr placeholder a_i64_7 = placeholder_arg_7::make<array<i64>, 134>();
+inline constexpr placeholder a_i64_8 = placeholder_arg_8::make<array<i64>, 135>();
+
+inline constexpr placeholder a_u8_1 = placeholder_arg_1::make<array<u8>, 136>();
+inline constexpr placeholder a_u8_2 = placeholder_arg_2::make<array<u8>, 137>();
+inline constexpr placeholder a_u8_3 = placeholder_arg_3::make<array<u8>, 138>();
+inline constexpr placeholder a_u8_4 = placeholder_arg_4::make<array<u8>, 139>();
+inline constexpr placeholder a_u8_5 = placeholder_arg_5::make<array<u8>, 140>();
+inline constexpr placeholder a_u8_6 = placeholder_arg_6::make<array<u8>, 141>();
+inline constexpr placeholder a_u8_7 = placeholder_arg_7::make<array<u8>, 142>();
+inline constexpr placeholder a_u8_8 = placeholder_arg_8::make<array<u8>, 143>();
+
+inline constexpr placeholder a_u16_1 = placeholder_arg_1::make<array<u16>, 144>();
+inline constexpr placeholder a_u16_2 = placeholder_arg_2::make<array<u16>, 145>();
+inline constexpr placeholder a_u16_3 = placeholder_arg_3::make<array<u16>, 146>();
+inline constexpr placeholder a_u16_4 = placeholder_arg_4::make<array<u16>, 147>();
+inline constexpr placeholder a_u16_5 = placeholder_arg_5::make<array<u16>, 148>();
+inline constexpr placeholder a_u16_6 = placeholder_arg_6::make<array<u16>, 149>();
+inline constexpr placeholder a_u16_7 = placeholder_arg_7::make<array<u16>, 150>();
+inline constexpr placeholder a_u16_8 = placeholder_arg_8::make<array<u16>, 151>();
+
+inline constexpr placeholder a_u32_1 = placeholder_arg_1::make<array<u32>, 152>();
+inline constexpr placeholder a_u32_2 = placeholder_arg_2::make<array<u32>, 153>();
+inline constexpr placeholder a_u32_3 = placeholder_arg_3::make<array<u32>, 154>();
+inline constexpr placeholder a_u32_4 = placeholder_arg_4::make<array<u32>, 155>();
+inline constexpr placeholder a_u32_5 = placeholder_arg_5::make<array<u32>, 156>();
+inline constexpr placeholder a_u32_6 = placeholder_arg_6::make<array<u32>, 157>();
+inline constexpr placeholder a_u32_7 = placeholder_arg_7::make<array<u32>, 158>();
+inline constexpr placeholder a_u32_8 = placeholder_arg_8::make<array<u32>, 159>();
+
+inline constexpr placeholder a_u64_1 = placeholder_arg_1::make<array<u64>, 160>();
+inline constexpr placeholder a_u64_2 = placeholder_arg_2::make<array<u64>, 161>();
+inline constexpr placeholder a_u64_3 = placeholder_arg_3::make<array<u64>, 162>();
+inline constexpr placeholder a_u64_4 = placeholder_arg_4::make<array<u64>, 163>();
+inline constexpr placeholder a_u64_5 = placeholder_arg_5::make<array<u64>, 164>();
+inline constexpr placeholder a_u64_6 = placeholder_arg_6::make<array<u64>, 165>();
+inline constexpr placeholder a_u64_7 = placeholder_arg_7::make<array<u64>, 166>();
+inline constexpr placeholder a_u64_8 = placeholder_arg_8::make<array<u64>, 167>();
+
+inline constexpr placeholder a_fp16a_1 = placeholder_arg_1::make<array<fp16a>, 168>();
+inline constexpr placeholder a_fp16a_2 = placeholder_arg_2::make<array<fp16a>, 169>();
+inline constexpr placeholder a_fp16a_3 = placeholder_arg_3::make<array<fp16a>, 170>();
+inline constexpr placeholder a_fp16a_4 = placeholder_arg_4::make<array<fp16a>, 171>();
+inline constexpr placeholder a_fp16a_5 = placeholder_arg_5::make<array<fp16a>, 172>();
+inline constexpr placeholder a_fp16a_6 = placeholder_arg_6::make<array<fp16a>, 173>();
+inline constexpr placeholder a_fp16a_7 = placeholder_arg_7::make<array<fp16a>, 174>();
+inline constexpr placeholder a_fp16a_8 = placeholder_arg_8::make<array<fp16a>, 175>();
+
+inline constexpr placeholder a_fp16b_1 = placeholder_arg_1::make<array<fp16b>, 176>();
+inline constexpr placeholder a_fp16b_2 = placeholder_arg_2::make<array<fp16b>, 177>();
+inline constexpr placeholder a_fp16b_3 = placeholder_arg_3::make<array<fp16b>, 178>();
+inline constexpr placeholder a_fp16b_4 = placeholder_arg_4::make<array<fp16b>, 179>();
+inline constexpr placeholder a_fp16b_5 = placeholder_arg_5::make<array<fp16b>, 180>();
+inline constexpr placeholder a_fp16b_6 = placeholder_arg_6::make<array<fp16b>, 181>();
+inline constexpr placeholder a_fp16b_7 = placeholder_arg_7::make<array<fp16b>, 182>();
+inline constexpr placeholder a_fp16b_8 = placeholder_arg_8::make<array<fp16b>, 183>();
+
+inline constexpr placeholder a_fp32_1 = placeholder_arg_1::make<array<fp32>, 184>();
+inline constexpr placeholder a_fp32_2 = placeholder_arg_2::make<array<fp32>, 185>();
+inline constexpr placeholder a_fp32_3 = placeholder_arg_3::make<array<fp32>, 186>();
+inline constexpr placeholder a_fp32_4 = placeholder_arg_4::make<array<fp32>, 187>();
+inline constexpr placeholder a_fp32_5 = placeholder_arg_5::make<array<fp32>, 188>();
+inline constexpr placeholder a_fp32_6 = placeholder_arg_6::make<array<fp32>, 189>();
+inline constexpr placeholder a_fp32_7 = placeholder_arg_7::make<array<fp32>, 190>();
+inline constexpr placeholder a_fp32_8 = placeholder_arg_8::make<array<fp32>, 191>();
+
+inline constexpr placeholder a_fp64_1 = placeholder_arg_1::make<array<fp64>, 192>();
+inline constexpr placeholder a_fp64_2 = placeholder_arg_2::make<array<fp64>, 193>();
+inline constexpr placeholder a_fp64_3 = placeholder_arg_3::make<array<fp64>, 194>();
+inline constexpr placeholder a_fp64_4 = placeholder_arg_4::make<array<fp64>, 195>();
+inline constexpr placeholder a_fp64_5 = placeholder_arg_5::make<array<fp64>, 196>();
+inline constexpr placeholder a_fp64_6 = placeholder_arg_6::make<array<fp64>, 197>();
+inline constexpr placeholder a_fp64_7 = placeholder_arg_7::make<array<fp64>, 198>();
+inline constexpr placeholder a_fp64_8 = placeholder_arg_8::make<array<fp64>, 199>();
+
+inline constexpr placeholder a_bool_1 = placeholder_arg_1::make<array<boolean>, 200>();
+inline constexpr placeholder a_bool_2 = placeholder_arg_2::make<array<boolean>, 201>();
+inline constexpr placeholder a_bool_3 = placeholder_arg_3::make<array<boolean>, 202>();
+inline constexpr placeholder a_bool_4 = placeholder_arg_4::make<array<boolean>, 203>();
+inline constexpr placeholder a_bool_5 = placeholder_arg_5::make<array<boolean>, 204>();
+inline constexpr placeholder a_bool_6 = placeholder_arg_6::make<array<boolean>, 205>();
+inline constexpr placeholder a_bool_7 = placeholder_arg_7::make<array<boolean>, 206>();
+inline constexpr placeholder a_bool_8 = placeholder_arg_8::make<array<boolean>, 207>();
+
+inline constexpr placeholder m_i8_1 = placeholder_arg_1::make<matrix<i8>, 208>();
+inline constexpr placeholder m_i8_2 = placeholder_arg_2::make<matrix<i8>, 209>();
+inline constexpr placeholder m_i8_3 = placeholder_arg_3::make<matrix<i8>, 210>();
+inline constexpr placeholder m_i8_4 = placeholder_arg_4::make<matrix<i8>, 211>();
+inline constexpr placeholder m_i8_5 = placeholder_arg_5::make<matrix<i8>, 212>();
+inline constexpr placeholder m_i8_6 = placeholder_arg_6::make<matrix<i8>, 213>();
+inline constexpr placeholder m_i8_7 = placeholder_arg_7::make<matrix<i8>, 214>();
+inline constexpr placeholder m_i8_8 = placeholder_arg_8::make<matrix<i8>, 215>();
+
+inline constexpr placeholder m_i16_1 = placeholder_arg_1::make<matrix<i16>, 216>();
+inline constexpr placeholder m_i16_2 = placeholder_arg_2::make<matrix<i16>, 217>();
+inline constexpr placeholder m_i16_3 = placeholder_arg_3::make<matrix<i16>, 218>();
+inline constexpr placeholder m_i16_4 = placeholder_arg_4::make<matrix<i16>, 219>();
+inline constexpr placeholder m_i16_5 = placeholder_arg_5::make<matrix<i16>, 220>();
+inline constexpr placeholder m_i16_6 = placeholder_arg_6::make<matrix<i16>, 221>();
+inline constexpr placeholder m_i16_7 = placeholder_arg_7::make<matrix<i16>, 222>();
+inline constexpr placeholder m_i16_8 = placeholder_arg_8::make<matrix<i16>, 223>();
+
+inline constexpr placeholder m_i32_1 = placeholder_arg_1::make<matrix<i32>, 224>();
+inline constexpr placeholder m_i32_2 = placeholder_arg_2::make<matrix<i32>, 225>();
+inline constexpr placeholder m_i32_3 = placeholder_arg_3::make<matrix<i32>, 226>();
+inline constexpr placeholder m_i32_4 = placeholder_arg_4::make<matrix<i32>, 227>();
+inline constexpr placeholder m_i32_5 = placeholder_arg_5::make<matrix<i32>, 228>();
+inline constexpr placeholder m_i32_6 = placeholder_arg_6::make<matrix<i32>, 229>();
+inline constexpr placeholder m_i32_7 = placeholder_arg_7::make<matrix<i32>, 230>();
+inline constexpr placeholder m_i32_8 = placeholder_arg_8::make<matrix<i32>, 231>();
+
+inline constexpr placeholder m_i64_1 = placeholder_arg_1::make<matrix<i64>, 232>();
+inline constexpr placeholder m_i64_2 = placeholder_arg_2::make<matrix<i64>, 233>();
+inline constexpr placeholder m_i64_3 = placeholder_arg_3::make<matrix<i64>, 234>();
+inline constexpr placeholder m_i64_4 = placeholder_arg_4::make<matrix<i64>, 235>();
+inline constexpr placeholder m_i64_5 = placeholder_arg_5::make<matrix<i64>, 236>();
+inline constexpr placeholder m_i64_6 = placeholder_arg_6::make<matrix<i64>, 237>();
+inline constexpr placeholder m_i64_7 = placeholder_arg_7::make<matrix<i64>, 238>();
+inline constexpr placeholder m_i64_8 = placeholder_arg_8::make<matrix<i64>, 239>();
+
+inline constexpr placeholder m_u8_1 = placeholder_arg_1::make<matrix<u8>, 240>();
+inline constexpr placeholder m_u8_2 = placeholder_arg_2::make<matrix<u8>, 241>();
+inline constexpr placeholder m_u8_3 = placeholder_arg_3::make<matrix<u8>, 242>();
+inline constexpr placeholder m_u8_4 = placeholder_arg_4::make<matrix<u8>, 243>();
+inline constexpr placeholder m_u8_5 = placeholder_arg_5::make<matrix<u8>, 244>();
+inline constexpr placeholder m_u8_6 = placeholder_arg_6::make<matrix<u8>, 245>();
+inline constexpr placeholder m_u8_7 = placeholder_arg_7::make<matrix<u8>, 246>();
+inline constexpr placeholder m_u8_8 = placeholder_arg_8::make<matrix<u8>, 247>();
+
+inline constexpr placeholder m_u16_1 = placeholder_arg_1::make<matrix<u16>, 248>();
+inline constexpr placeholder m_u16_2 = placeholder_arg_2::make<matrix<u16>, 249>();
+inline constexpr placeholder m_u16_3 = placeholder_arg_3::make<matrix<u16>, 250>();
+inline constexpr placeholder m_u16_4 = placeholder_arg_4::make<matrix<u16>, 251>();
+inline constexpr placeholder m_u16_5 = placeholder_arg_5::make<matrix<u16>, 252>();
+inline constexpr placeholder m_u16_6 = placeholder_arg_6::make<matrix<u16>, 253>();
+inline constexpr placeholder m_u16_7 = placeholder_arg_7::make<matrix<u16>, 254>();
+inline constexpr placeholder m_u16_8 = placeholder_arg_8::make<matrix<u16>, 255>();
+
+inline constexpr placeholder m_u32_1 = placeholder_arg_1::make<matrix<u32>, 256>();
+inline constexpr placeholder m_u32_2 = placeholder_arg_2::make<matrix<u32>, 257>();
+inline constexpr placeholder m_u32_3 = placeholder_arg_3::make<matrix<u32>, 258>();
+inline constexpr placeholder m_u32_4 = placeholder_arg_4::make<matrix<u32>, 259>();
+inline constexpr placeholder m_u32_5 = placeholder_arg_5::make<matrix<u32>, 260>();
+inline constexpr placeholder m_u32_6 = placeholder_arg_6::make<matrix<u32>, 261>();
+inline constexpr placeholder m_u32_7 = placeholder_arg_7::make<matrix<u32>, 262>();
+inline constexpr placeholder m_u32_8 = placeholder_arg_8::make<matrix<u32>, 263>();
+
+inline constexpr placeholder m_u64_1 = placeholder_arg_1::make<matrix<u64>, 264>();
+inline constexpr placeholder m_u64_2 = placeholder_arg_2::make<matrix<u64>, 265>();
+inline constexpr placeholder m_u64_3 = placeholder_arg_3::make<matrix<u64>, 266>();
+inline constexpr placeholder m_u64_4 = placeholder_arg_4::make<matrix<u64>, 267>();
+inline constexpr placeholder m_u64_5 = placeholder_arg_5::make<matrix<u64>, 268>();
+inline constexpr placeholder m_u64_6 = placeholder_arg_6::make<matrix<u64>, 269>();
+inline constexpr placeholder m_u64_7 = placeholder_arg_7::make<matrix<u64>, 270>();
+inline constexpr placeholder m_u64_8 = placeholder_arg_8::make<matrix<u64>, 271>();
+
+inline constexpr placeholder m_fp16a_1 = placeholder_arg_1::make<matrix<fp16a>, 272>();
+inline constexpr placeholder m_fp16a_2 = placeholder_arg_2::make<matrix<fp16a>, 273>();
+inline constexpr placeholder m_fp16a_3 = placeholder_arg_3::make<matrix<fp16a>, 274>();
+inline constexpr placeholder m_fp16a_4 = placeholder_arg_4::make<matrix<fp16a>, 275>();
+inline constexpr placeholder m_fp16a_5 = placeholder_arg_5::make<matrix<fp16a>, 276>();
+inline constexpr placeholder m_fp16a_6 = placeholder_arg_6::make<matrix<fp16a>, 277>();
+inline constexpr placeholder m_fp16a_7 = placeholder_arg_7::make<matrix<fp16a>, 278>();
+inline constexpr placeholder m_fp16a_8 = placeholder_arg_8::make<matrix<fp16a>, 279>();
+
+inline constexpr placeholder m_fp16b_1 = placeholder_arg_1::make<matrix<fp16b>, 280>();
+inline constexpr placeholder m_fp16b_2 = placeholder_arg_2::make<matrix<fp16b>, 281>();
+inline constexpr placeholder m_fp16b_3 = placeholder_arg_3::make<matrix<fp16b>, 282>();
+inline constexpr placeholder m_fp16b_4 = placeholder_arg_4::make<matrix<fp16b>, 283>();
+inline constexpr placeholder m_fp16b_5 = placeholder_arg_5::make<matrix<fp16b>, 284>();
+inline constexpr placeholder m_fp16b_6 = placeholder_arg_6::make<matrix<fp16b>, 285>();
+inline constexpr placeholder m_fp16b_7 = placeholder_arg_7::make<matrix<fp16b>, 286>();
+inline constexpr placeholder m_fp16b_8 = placeholder_arg_8::make<matrix<fp16b>, 287>();
+
+inline constexpr placeholder m_fp32_1 = placeholder_arg_1::make<matrix<fp32>, 288>();
+inline constexpr placeholder m_fp32_2 = placeholder_arg_2::make<matrix<fp32>, 289>();
+inline constexpr placeholder m_fp32_3 = placeholder_arg_3::make<matrix<fp32>, 290>();
+inline constexpr placeholder m_fp32_4 = placeholder_arg_4::make<matrix<fp32>, 291>();
+inline constexpr placeholder m_fp32_5 = placeholder_arg_5::make<matrix<fp32>, 292>();
+inline constexpr placeholder m_fp32_6 = placeholder_arg_6::make<matrix<fp32>, 293>();
+inline constexpr placeholder m_fp32_7 = placeholder_arg_7::make<matrix<fp32>, 294>();
+inline constexpr placeholder m_fp32_8 = placeholder_arg_8::make<matrix<fp32>, 295>();
+
+inline constexpr placeholder m_fp64_1 = placeholder_arg_1::make<matrix<fp64>, 296>();
+inline constexpr placeholder m_fp64_2 = placeholder_arg_2::make<matrix<fp64>, 297>();
+inline constexpr placeholder m_fp64_3 = placeholder_arg_3::make<matrix<fp64>, 298>();
+inline constexpr placeholder m_fp64_4 = placeholder_arg_4::make<matrix<fp64>, 299>();
+inline constexpr placeholder m_fp64_5 = placeholder_arg_5::make<matrix<fp64>, 300>();
+inline constexpr placeholder m_fp64_6 = placeholder_arg_6::make<matrix<fp64>, 301>();
+inline constexpr placeholder m_fp64_7 = placeholder_arg_7::make<matrix<fp64>, 302>();
+inline constexpr placeholder m_fp64_8 = placeholder_arg_8::make<matrix<fp64>, 303>();
+
+inline constexpr placeholder m_bool_1 = placeholder_arg_1::make<matrix<boolean>, 304>();
+inline constexpr placeholder m_bool_2 = placeholder_arg_2::make<matrix<boolean>, 305>();
+inline constexpr placeholder m_bool_3 = placeholder_arg_3::make<matrix<boolean>, 306>();
+inline constexpr placeholder m_bool_4 = placeholder_arg_4::make<matrix<boolean>, 307>();
+inline constexpr placeholder m_bool_5 = placeholder_arg_5::make<matrix<boolean>, 308>();
+inline constexpr placeholder m_bool_6 = placeholder_arg_6::make<matrix<boolean>, 309>();
+inline constexpr placeholder m_bool_7 = placeholder_arg_7::make<matrix<boolean>, 310>();
+inline constexpr placeholder m_bool_8 = placeholder_arg_8::make<matrix<boolean>, 311>();
 
 template<typename T>
 using is_placeholder_type = std::conditional<
@@ -1368,9 +1257,9 @@ using is_placeholder_type = std::conditional<
 
 struct PlaceholderVisitor {
 
-   std::string & buf;
+   emitter & buf;
 
-   PlaceholderVisitor(std::string & b) : buf(b) {}
+   PlaceholderVisitor(emitter & b) : buf(b) {}
 
    template<typename T>
    void operator()(T const& t) {
@@ -1791,13 +1680,23 @@ bool is_expression(T const& t) { return is_expression_type<T>::type::value; }
 struct expression_data {
    expression_type node;
 
+   expression_data() : node() {}
+   expression_data(expression_type const& n) : node(n) {}
+   expression_data(expression_type && n) : node(std::move(n)) {}
+
+   // operator= below builds an assign_op, declaring the move
+   // constructor keeps temporaries from being deep copied
+   //
+   expression_data(expression_data const& other) = default;
+   expression_data(expression_data && other) = default;
+
    expression_data operator=(function_call t);
 
    expression_data operator=(expression_data t) {
       return expression_data{expression_type{
          assign_op{
             std::pair< recursive_wrapper<expression_data>, recursive_wrapper<expression_data> >{
-               *this, t
+               *this, std::move(t)
             }
          }
       }};
@@ -1839,7 +1738,7 @@ struct expression_data {
       else {
          return expression_data{expression_type{assign_op{
             std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
+               *this, std::move(t)
             }
          }}};
       }
@@ -1849,7 +1748,7 @@ struct expression_data {
    expression_data operator=(expression_data t) {
       return expression_data{expression_type{assign_op{
          std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-            *this, t
+            *this, std::move(t)
          }
       }}};
    }
@@ -1906,536 +1805,182 @@ struct expression_data {
    expression_data operator()(T t) {
       return expression_data{expression_type{paren_op{
          recursive_wrapper<expression_data>{
-            t
+            std::move(t)
          }
       }}};
    }
 
-   template<typename T>
-   expression_data operator[](T t) {
-      if constexpr(std::is_integral<T>::value) {
+   // builds Op{lhs, t}; integral values are wrapped as literals
+   //
+   template<typename Op, typename T>
+   expression_data binary(expression_data && lhs, T && t) {
+      using value_type = typename std::decay<T>::type;
+
+      if constexpr(std::is_integral<value_type>::value) {
          expression_data val;
-         wrap_literal(val, t);
+         wrap_literal(val, static_cast<value_type>(t));
 
-         return expression_data{expression_type{index_op{
+         return expression_data{expression_type{Op{
             std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
+               std::move(lhs), std::move(val)
             }
          }}};
       }
-      else{
-         return expression_data{expression_type{index_op{
+      else {
+         return expression_data{expression_type{Op{
             std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
+               std::move(lhs), std::forward<T>(t)
             }
          }}};
       }
    }
 
    template<typename T>
-   expression_data operator+(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator[](T t) & {
+      return binary<index_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{add_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{add_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   // temporaries on the left hand side (ie: `a + b + c`) are
+   // moved into the new node instead of deep copied
+   //
+   template<typename T>
+   expression_data operator[](T t) && {
+      return binary<index_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator-(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator+(T t) & {
+      return binary<add_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{sub_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{sub_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator+(T t) && {
+      return binary<add_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator*(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator-(T t) & {
+      return binary<sub_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{mul_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{mul_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator-(T t) && {
+      return binary<sub_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator/(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator*(T t) & {
+      return binary<mul_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{div_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{div_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator*(T t) && {
+      return binary<mul_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator%(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator/(T t) & {
+      return binary<div_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{mod_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{mod_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator/(T t) && {
+      return binary<div_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator<(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator%(T t) & {
+      return binary<mod_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{lt_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{lt_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator%(T t) && {
+      return binary<mod_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator<=(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator<(T t) & {
+      return binary<lt_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{lte_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{lte_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator<(T t) && {
+      return binary<lt_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator>(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator<=(T t) & {
+      return binary<lte_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{gt_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{gt_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator<=(T t) && {
+      return binary<lte_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator>=(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator>(T t) & {
+      return binary<gt_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{gte_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{gte_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator>(T t) && {
+      return binary<gt_op>(std::move(*this), std::move(t));
    }
 
    template<typename T>
-   expression_data operator==(T t) {
-      if constexpr(std::is_integral<T>::value) {
-         expression_data val;
-         wrap_literal(val, t);
+   expression_data operator>=(T t) & {
+      return binary<gte_op>(expression_data{*this}, std::move(t));
+   }
 
-         return expression_data{expression_type{eq_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, val
-            }
-         }}};
-      }
-      else{
-         return expression_data{expression_type{eq_op{
-            std::pair<recursive_wrapper<expression_data>, recursive_wrapper<expression_data>>{
-               *this, t
-            }
-         }}};
-      }
+   template<typename T>
+   expression_data operator>=(T t) && {
+      return binary<gte_op>(std::move(*this), std::move(t));
+   }
+
+   template<typename T>
+   expression_data operator==(T t) & {
+      return binary<eq_op>(expression_data{*this}, std::move(t));
+   }
+
+   template<typename T>
+   expression_data operator==(T t) && {
+      return binary<eq_op>(std::move(*this), std::move(t));
    }
 
    static void copy(expression_data & ret, expression_data & t) {
-     if(mpark::holds_alternative<variable_type>(t.node)) {
-        variable_type & v = mpark::get<variable_type>(t.node);
-        if(mpark::holds_alternative<none>(v)) {
-           ret.node.emplace<variable_type>(variable_type{none{}});
-        }
-        else if(mpark::holds_alternative<scalar<i8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<i8>{mpark::get<scalar<i8>>(v).identity}});
-        }
-        else if(mpark::holds_alternative<scalar<i16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<i16>{mpark::get<scalar<i16>>(v).identity}});
-        }
-        else if(mpark::holds_alternative<scalar<i32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<i32>{mpark::get<scalar<i32>>(v).identity}});
-        }
-        else if(mpark::holds_alternative<scalar<i64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<i64>{mpark::get<scalar<i64>>(v).identity}});
-        }
-        else if(mpark::holds_alternative<scalar<u8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<u8>{mpark::get<scalar<u8>>(v).identity}});
-        }
-        else if(mpark::holds_alternative<scalar<u16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<u16>{mpark::get<scalar<u16>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<u32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<u32>{mpark::get<scalar<u32>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<u64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<u64>{mpark::get<scalar<u64>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<fp16a>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<fp16a>{mpark::get<scalar<fp16a>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<fp16b>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<fp16b>{mpark::get<scalar<fp16b>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<fp32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<fp32>{mpark::get<scalar<fp32>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<fp64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<fp64>{mpark::get<scalar<fp64>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<scalar<boolean>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{scalar<boolean>{mpark::get<scalar<boolean>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<literal<i8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<i8>{mpark::get<literal<i8>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<i16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<i16>{mpark::get<literal<i16>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<i32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<i32>{mpark::get<literal<i32>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<i64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<i64>{mpark::get<literal<i64>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<u8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<u8>{mpark::get<literal<u8>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<u16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<u16>{mpark::get<literal<u16>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<u32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<u32>{mpark::get<literal<u32>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<u64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<u64>{mpark::get<literal<u64>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<fp16a>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<fp16a>{mpark::get<literal<fp16a>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<fp16b>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<fp16b>{mpark::get<literal<fp16b>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<fp32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<fp32>{mpark::get<literal<fp32>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<fp64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<fp64>{mpark::get<literal<fp64>>(v).value}});
-       }
-       else if(mpark::holds_alternative<literal<boolean>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{literal<boolean>{mpark::get<literal<boolean>>(v).value}});
-       }
-       else if(mpark::holds_alternative<array<i8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<i8>{mpark::get<array<i8>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<i16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<i16>{mpark::get<array<i16>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<i32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<i32>{mpark::get<array<i32>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<i64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<i64>{mpark::get<array<i64>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<u8>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<u8>{mpark::get<array<u8>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<u16>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<u16>{mpark::get<array<u16>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<u32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<u32>{mpark::get<array<u32>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<u64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<u64>{mpark::get<array<u64>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<fp16a>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<fp16a>{mpark::get<array<fp16a>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<fp16b>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<fp16b>{mpark::get<array<fp16b>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<fp32>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<fp32>{mpark::get<array<fp32>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<fp64>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<fp64>{mpark::get<array<fp64>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<array<boolean>>(v)) {
-           ret.node.emplace<variable_type>(variable_type{array<boolean>{mpark::get<array<boolean>>(v).identity}});
-       }
-       else if(mpark::holds_alternative<matrix<i8>>(v)) {
-           auto & a = mpark::get<matrix<i8>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<i8>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<i16>>(v)) {
-           auto & a = mpark::get<matrix<i16>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<i16>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<i32>>(v)) {
-           auto & a = mpark::get<matrix<i32>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<i32>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<i64>>(v)) {
-           auto & a = mpark::get<matrix<i64>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<i64>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<u8>>(v)) {
-           auto & a = mpark::get<matrix<u8>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<u8>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<u16>>(v)) {
-           auto & a = mpark::get<matrix<u16>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<u16>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<u32>>(v)) {
-           auto & a = mpark::get<matrix<u32>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<u32>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<u64>>(v)) {
-           auto & a = mpark::get<matrix<u64>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<u64>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<fp16a>>(v)) {
-           auto & a = mpark::get<matrix<fp16a>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<fp16a>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<fp16b>>(v)) {
-           auto & a = mpark::get<matrix<fp16b>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<fp16b>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<fp32>>(v)) {
-           auto & a = mpark::get<matrix<fp32>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<fp32>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<fp64>>(v)) {
-           auto & a = mpark::get<matrix<fp64>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<fp64>{a.identity, a.dimensions}});
-       }
-       else if(mpark::holds_alternative<matrix<boolean>>(v)) {
-           auto & a = mpark::get<matrix<boolean>>(v);
-           ret.node.emplace<variable_type>(variable_type{matrix<boolean>{a.identity, a.dimensions}});
-       }
-
-       return;
-     }
-     else if(mpark::holds_alternative<decl_expr>(t.node)) {
-        //auto & v = mpark::get<decl_expr>(t.node);
-     }
-     else if(mpark::holds_alternative<assign_op>(t.node)) {
-        auto & a = mpark::get<assign_op>(t.node);
-        ret.node.emplace<assign_op>(assign_op{a.args});
-     }
-     else if(mpark::holds_alternative<index_op>(t.node)) {
-        auto & a = mpark::get<index_op>(t.node);
-        ret.node.emplace<index_op>(index_op{a.args});
-     }
-     else if(mpark::holds_alternative<add_op>(t.node)) {
-        auto & a = mpark::get<add_op>(t.node);
-        ret.node.emplace<add_op>(add_op{a.args});
-     }
-     else if(mpark::holds_alternative<sub_op>(t.node)) {
-        auto & a = mpark::get<sub_op>(t.node);
-        ret.node.emplace<sub_op>(sub_op{a.args});
-     }
-     else if(mpark::holds_alternative<mul_op>(t.node)) {
-        auto & a = mpark::get<mul_op>(t.node);
-        ret.node.emplace<mul_op>(mul_op{a.args});
-     }
-     else if(mpark::holds_alternative<div_op>(t.node)) {
-        auto & a = mpark::get<div_op>(t.node);
-        ret.node.emplace<div_op>(div_op{a.args});
-     }
-     else if(mpark::holds_alternative<mod_op>(t.node)) {
-        auto & a = mpark::get<mod_op>(t.node);
-        ret.node.emplace<mod_op>(mod_op{a.args});
-     }
-     else if(mpark::holds_alternative<pow_op>(t.node)) {
-        auto & a = mpark::get<pow_op>(t.node);
-        ret.node.emplace<pow_op>(pow_op{a.args});
-     }
-     else if(mpark::holds_alternative<log_op>(t.node)) {
-        auto & a = mpark::get<log_op>(t.node);
-        ret.node.emplace<log_op>(log_op{a.args});
-     }
-     else if(mpark::holds_alternative<exp_op>(t.node)) {
-        auto & a = mpark::get<exp_op>(t.node);
-        ret.node.emplace<exp_op>(exp_op{a.args});
-     }
-     else if(mpark::holds_alternative<sin_op>(t.node)) {
-        auto & a = mpark::get<sin_op>(t.node);
-        ret.node.emplace<sin_op>(sin_op{a.args});
-     }
-     else if(mpark::holds_alternative<cos_op>(t.node)) {
-        auto & a = mpark::get<cos_op>(t.node);
-        ret.node.emplace<cos_op>(cos_op{a.args});
-     }
-     else if(mpark::holds_alternative<tan_op>(t.node)) {
-        auto & a = mpark::get<tan_op>(t.node);
-        ret.node.emplace<tan_op>(tan_op{a.args});
-     }
-     else if(mpark::holds_alternative<lt_op>(t.node)) {
-        auto & a = mpark::get<lt_op>(t.node);
-        ret.node.emplace<lt_op>(lt_op{a.args});
-     }
-     else if(mpark::holds_alternative<lte_op>(t.node)) {
-        auto & a = mpark::get<lte_op>(t.node);
-        ret.node.emplace<lte_op>(lte_op{a.args});
-     }
-     else if(mpark::holds_alternative<gt_op>(t.node)) {
-        auto & a = mpark::get<gt_op>(t.node);
-        ret.node.emplace<gt_op>(gt_op{a.args});
-     }
-     else if(mpark::holds_alternative<gte_op>(t.node)) {
-        auto & a = mpark::get<gte_op>(t.node);
-        ret.node.emplace<gte_op>(gte_op{a.args});
-     }
-     else if(mpark::holds_alternative<eq_op>(t.node)) {
-        auto & a = mpark::get<eq_op>(t.node);
-        ret.node.emplace<eq_op>(eq_op{a.args});
-     }
-     else if(mpark::holds_alternative<neq_op>(t.node)) {
-        auto & a = mpark::get<neq_op>(t.node);
-        ret.node.emplace<neq_op>(neq_op{a.args});
-     }
-     else if(mpark::holds_alternative<neg_op>(t.node)) {
-        auto & a = mpark::get<neg_op>(t.node);
-        ret.node.emplace<neg_op>(neg_op{a.node});
-     }
-     else if(mpark::holds_alternative<not_op>(t.node)) {
-        auto & a = mpark::get<not_op>(t.node);
-        ret.node.emplace<not_op>(not_op{a.node});
-     }
-     else if(mpark::holds_alternative<xor_op>(t.node)) {
-        auto & a = mpark::get<xor_op>(t.node);
-        ret.node.emplace<xor_op>(xor_op{a.args});
-     }
-     else if(mpark::holds_alternative<logical_and_op>(t.node)) {
-        auto & a = mpark::get<logical_and_op>(t.node);
-        ret.node.emplace<logical_and_op>(logical_and_op{a.args});
-     }
-     else if(mpark::holds_alternative<logical_or_op>(t.node)) {
-        auto & a = mpark::get<logical_or_op>(t.node);
-        ret.node.emplace<logical_or_op>(logical_or_op{a.args});
-     }
-     else if(mpark::holds_alternative<bitwise_and_op>(t.node)) {
-        auto & a = mpark::get<bitwise_and_op>(t.node);
-        ret.node.emplace<bitwise_and_op>(bitwise_and_op{a.args});
-     }
-     else if(mpark::holds_alternative<bitwise_or_op>(t.node)) {
-        auto & a = mpark::get<bitwise_or_op>(t.node);
-        ret.node.emplace<bitwise_or_op>(bitwise_or_op{a.args});
-     }
-     else if(mpark::holds_alternative<paren_op>(t.node)) {
-        auto & a = mpark::get<paren_op>(t.node);
-        ret.node.emplace<paren_op>(paren_op{a.node});
-     }
-     else if(mpark::holds_alternative<recursive_wrapper<function_call>>(t.node)) {
-        //auto & v = mpark::get<recursive_wrapper<function_call>>(t.node);
-        //ret.node.emplace<recursive_wrapper<function_call>>(variable_type{recursive_wrapper<function_call>{a.args}});
-     }
-  }
+      visit([&ret](auto const& a) {
+         using T = typename std::decay<decltype(a)>::type;
+
+         if constexpr(std::is_same<T, variable_type>::value) {
+            visit([&ret](auto const& v) {
+               using V = typename std::decay<decltype(v)>::type;
+
+               if constexpr(std::is_same<V, none>::value) {
+                  ret.node.emplace<variable_type>(variable_type{none{}});
+               }
+               else if constexpr(is_scalar_type<V>::type::value) {
+                  ret.node.emplace<variable_type>(variable_type{V{v.identity}});
+               }
+               else if constexpr(is_literal_type<V>::type::value) {
+                  ret.node.emplace<variable_type>(variable_type{V{v.value}});
+               }
+               else if constexpr(is_array_type<V>::type::value) {
+                  ret.node.emplace<variable_type>(variable_type{V{v.identity, v.num_dims}});
+               }
+               else if constexpr(is_matrix_type<V>::type::value) {
+                  ret.node.emplace<variable_type>(variable_type{V{v.identity, v.dimensions}});
+               }
+            }, a);
+         }
+         else if constexpr(is_binary_op_type<T>::type::value) {
+            ret.node.template emplace<T>(T{a.args});
+         }
+         else if constexpr(is_unary_op_type<T>::type::value) {
+            ret.node.template emplace<T>(T{a.node});
+         }
+      }, t.node);
+   }
 
 /*
         else if(mpark::holds_alternative<pointer<scalar<i8>>(v))
@@ -2525,9 +2070,9 @@ static inline expression_data _ = expression_data{expression_type{paren_op{}}};
 struct VariableDeclVisitor {
 
    std::uint64_t const indent;
-   std::string & buf;
+   emitter & buf;
 
-   VariableDeclVisitor(std::uint64_t const i, std::string & b) : indent(i), buf(b) {}
+   VariableDeclVisitor(std::uint64_t const i, emitter & b) : indent(i), buf(b) {}
 
    template<typename T>
    void operator()(T const& t) {
@@ -2717,9 +2262,9 @@ struct VariableDeclVisitor {
 struct VariableVisitor {
 
    std::uint64_t const indent;
-   std::string & buf;
+   emitter & buf;
 
-   VariableVisitor(std::uint64_t const i, std::string & b) : indent(i), buf(b) {}
+   VariableVisitor(std::uint64_t const i, emitter & b) : indent(i), buf(b) {}
 
    template<typename T>
    void operator()(T const& t) {
@@ -2907,52 +2452,60 @@ struct VariableVisitor {
 
    template<>
    void operator()(literal<i8> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<i16> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<i32> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<i64> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<u8> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<u16> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<u32> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
    template<>
    void operator()(literal<u64> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{}", t.value);
    }
 
+   // suffixed so the literal stays a float in the emitted
+   // source instead of promoting its expression to double
+   //
    template<>
    void operator()(literal<fp32> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{:f}f", t.value);
    }
 
    template<>
    void operator()(literal<fp64> const& t) {
-      buf += std::to_string(t.value);
+      buf.format("{:f}", t.value);
+   }
+
+   template<>
+   void operator()(literal<boolean> const& t) {
+      buf += t.value ? "true" : "false";
    }
 
    template<>
@@ -2977,9 +2530,9 @@ struct VariableVisitor {
 struct ExpressionVisitor {
 
    std::uint64_t & indent;
-   std::string & buf;
+   emitter & buf;
 
-   ExpressionVisitor(std::uint64_t & i, std::string & b) : indent(i), buf(b) {}
+   ExpressionVisitor(std::uint64_t & i, emitter & b) : indent(i), buf(b) {}
 
    template<typename T>
    void operator()(T const& t) {
@@ -3229,14 +2782,12 @@ bool is_statement(T const& t) { return is_statement_type<T>::type::value; }
 struct StatementVisitor {
 
    std::uint64_t & indent;
-   std::string & buf;
+   emitter & buf;
    bool is_expression_data;
    bool is_comment;
 
-   StatementVisitor(std::uint64_t & i, std::string & b) : indent(i), buf(b), is_expression_data(false), is_comment(false) {
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+   StatementVisitor(std::uint64_t & i, emitter & b) : indent(i), buf(b), is_expression_data(false), is_comment(false) {
+      buf.indent(indent);
    }
 
    static inline const std::string term[2] = { " ;\n", ";\n" };
@@ -3273,13 +2824,13 @@ struct StatementVisitor {
 
    template<>
    void operator()(comment const& t) {
-      buf += fmt::format("// {}", t.data);
+      buf.format("// {}", t.data);
       is_comment = true;
    }
 
    template<>
    void operator()(include const& t) {
-      buf += fmt::format("#include<{}>", t.path.data);
+      buf.format("#include<{}>", t.path.data);
       is_comment = true;
    }
 
@@ -3311,25 +2862,46 @@ struct loop_base {
    loop_base() : statements() {}
 
    loop_base(std::vector<statement> & stmts) : statements(stmts) {}
+   loop_base(std::vector<statement> && stmts) : statements(std::move(stmts)) {}
    loop_base(std::initializer_list<statement> stmts) : statements(stmts) {}
 };
 
 struct for_ : public loop_base {
 
+   using full_unroll = std::integral_constant<std::size_t, std::numeric_limits<std::size_t>::max()>;
+
    expression_data init_expr;
    expression_data cond_expr;
    expression_data incr_expr;
 
+   // copies of the body per iteration unroll_loops (optimize.hpp)
+   // emits; 0 leaves the loop alone. emission ignores it
+   //
+   std::size_t unroll_factor;
+
    //for_(binary_op_type init, conditional_type cond, binary_op_type incr, std::initializer_list<statement> statements) :
    //
    for_(expression_data init, expression_data cond, expression_data incr, std::initializer_list<statement> statements) :
-      loop_base(statements), init_expr(init), cond_expr(cond), incr_expr(incr) {
+      loop_base(statements), init_expr(std::move(init)), cond_expr(std::move(cond)), incr_expr(std::move(incr)), unroll_factor(0UL) {
    } 
 
    for_(expression_data init, expression_data cond, expression_data incr, std::vector<statement> statements) :
-      loop_base(statements), init_expr(init), cond_expr(cond), incr_expr(incr) {
+      loop_base(std::move(statements)), init_expr(std::move(init)), cond_expr(std::move(cond)), incr_expr(std::move(incr)), unroll_factor(0UL) {
    } 
 
+   //    for_(i = 0, i < 8, i = i + 1, { ... }).unroll(4)
+   //    for_(i = 0, i < 8, i = i + 1, { ... }).unroll_full()
+   //
+   for_ & unroll(std::size_t const factor) {
+      unroll_factor = factor;
+      return *this;
+   }
+
+   for_ & unroll_full() {
+      unroll_factor = full_unroll::value;
+      return *this;
+   }
+
 };
 
 template<>
@@ -3354,9 +2926,7 @@ void StatementVisitor::operator()(recursive_wrapper<for_> const& t) {
 
    auto & t_val_statements = t_val.statements;
    for(auto & stmt : t_val_statements) {
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       visit(*this, stmt);
 
@@ -3367,9 +2937,7 @@ void StatementVisitor::operator()(recursive_wrapper<for_> const& t) {
 
    indent -= 1UL;
 
-   for(std::uint64_t i = 0; i < indent; ++i) {
-      buf += "    ";
-   }
+   buf.indent(indent);
 
    buf += "}";
 }
@@ -3380,7 +2948,7 @@ struct while_ : public loop_base {
    //while_(conditional_type cond, std::initializer_list<statement> statements) :
 
    while_(expression_data cond, std::initializer_list<statement> statements) :
-      loop_base(statements), cond_expr(cond) {
+      loop_base(statements), cond_expr(std::move(cond)) {
    } 
 };
 
@@ -3401,9 +2969,7 @@ void StatementVisitor::operator()(recursive_wrapper<while_> const& t) {
 
    auto & t_val_statements = t_val.statements;
    for(auto & stmt : t_val_statements) {
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       visit(*this, stmt);
 
@@ -3414,9 +2980,7 @@ void StatementVisitor::operator()(recursive_wrapper<while_> const& t) {
 
    indent -= 1UL;
 
-   for(std::uint64_t i = 0; i < indent; ++i) {
-      buf += "    ";
-   }
+   buf.indent(indent);
 
    buf += "}";   
 }
@@ -3431,24 +2995,24 @@ struct if_ {
 
    template<typename T>
    if_(T cond, std::initializer_list<statement> stmts) :
-      statements({std::make_pair<expression_data, std::vector<statement>>(expression_data{cond}, stmts)}) {
+      statements({std::make_pair<expression_data, std::vector<statement>>(expression_data{std::move(cond)}, stmts)}) {
       static_assert(is_conditional_type<T>::type::value, "invalid conditional expression used in if_ statement");
    }
 
    if_(expression_data cond, std::initializer_list<statement> stmts) :
-      statements({std::make_pair<expression_data, std::vector<statement>>(expression_data{cond}, stmts)}) {
+      statements({std::make_pair<expression_data, std::vector<statement>>(expression_data{std::move(cond)}, stmts)}) {
    }
 
    template<typename T>
    if_ & else_if_(T cond, std::initializer_list<statement> stmts) {
      static_assert(is_conditional_type<T>::type::value, "invalid conditional expression used in if_ statement");
 
-     statements.push_back({std::make_pair<expression_data, std::vector<statement>>(expression_data{cond}, stmts)});
+     statements.push_back({std::make_pair<expression_data, std::vector<statement>>(expression_data{std::move(cond)}, stmts)});
      return (*this);
    }
 
    if_ & else_if_(expression_data cond, std::initializer_list<statement> stmts) {
-     statements.push_back({std::make_pair<expression_data, std::vector<statement>>(expression_data{cond}, stmts)});
+     statements.push_back({std::make_pair<expression_data, std::vector<statement>>(expression_data{std::move(cond)}, stmts)});
      return (*this);
    }
 
@@ -3484,16 +3048,12 @@ void StatementVisitor::operator()(recursive_wrapper<if_> const& t) {
       }
       else if( holds_alternative<monostate>(itr->first.node) ) {
          buf += "\n";
-         for(std::uint64_t i = 0; i < indent; ++i) {
-            buf += "    ";
-         }
+         buf.indent(indent);
          buf += "else";
       }
       else {
          buf += "\n";
-         for(std::uint64_t i = 0; i < indent; ++i) {
-            buf += "    ";
-         }
+         buf.indent(indent);
          buf += "else if ( ";
          visit(*this, itr->first.node);
          buf += " ) ";
@@ -3505,9 +3065,7 @@ void StatementVisitor::operator()(recursive_wrapper<if_> const& t) {
 
       auto & itr_statements = itr->second;
       for(auto & stmt : itr_statements) {
-         for(std::uint64_t i = 0; i < indent; ++i) {
-            buf += "    ";
-         }
+         buf.indent(indent);
 
          visit(*this, stmt);
 
@@ -3518,9 +3076,7 @@ void StatementVisitor::operator()(recursive_wrapper<if_> const& t) {
 
       indent -= 1UL;
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "}";
    }
@@ -3586,13 +3142,13 @@ struct switch_ {
          wrap_literal(variable, var);
       }
       else {
-         variable = expression_data{var};
+         variable.node = expression_type{std::move(var)};
       }
    }
 
    template<>
    switch_(expression_data var) :
-      variable(var), cases(), default_case() {
+      variable(std::move(var)), cases(), default_case() {
    }
 
    template<typename T>
@@ -3602,10 +3158,10 @@ struct switch_ {
          expression_data val;
          wrap_literal(val, var);
 
-         cases.push_back({std::make_pair<>(val, stmts)});
+         cases.push_back({std::make_pair<>(std::move(val), stmts)});
       }
       else{
-         cases.push_back({std::make_pair<>(var, stmts)});
+         cases.push_back({std::make_pair<>(std::move(var), stmts)});
       }
 
       return (*this);
@@ -3652,25 +3208,19 @@ void StatementVisitor::operator()(recursive_wrapper<switch_> const& t) {
    for(auto itr = beg_itr; itr != end_itr; ++itr) {
       std::uint64_t & indent = this->indent;
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "case ";
       visit(*this, itr->first.node);
       buf += " :\n";
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
       buf += "{\n";
 
       indent += 1UL;
       auto & itr_statements = itr->second;
       for(auto & stmt : itr_statements) {
-         for(std::uint64_t i = 0; i < indent; ++i) {
-            buf += "    ";
-         }
+         buf.indent(indent);
 
          visit(*this, stmt);
 
@@ -3681,16 +3231,12 @@ void StatementVisitor::operator()(recursive_wrapper<switch_> const& t) {
 
       indent -= 1UL;
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "}\n";
 
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "break;\n";
 
@@ -3699,23 +3245,17 @@ void StatementVisitor::operator()(recursive_wrapper<switch_> const& t) {
    if(0 < t_val.default_case.size()) {
       std::uint64_t & indent = this->indent;
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
       buf += "default:\n";
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "{\n";
 
       indent += 1UL;
 
       for(auto & stmt : t_val.default_case) {
-         for(std::uint64_t i = 0; i < indent; ++i) {
-            buf += "    ";
-         }
+         buf.indent(indent);
 
          visit(*this, stmt);
 
@@ -3726,24 +3266,18 @@ void StatementVisitor::operator()(recursive_wrapper<switch_> const& t) {
 
       indent -=  1UL;
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "}\n";
 
-      for(std::uint64_t i = 0; i < indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(indent);
 
       buf += "break;\n";
    }
 
    out_indent -= 1UL;
 
-   for(std::uint64_t i = 0; i < out_indent; ++i) {
-         buf += "    ";
-   }
+   buf.indent(out_indent);
 
    buf += "}";
 }
@@ -3753,138 +3287,22 @@ struct function_decl {
    std::vector<variable_type> args;
    variable_type return_type;
 
-   template<typename T>
-   std::string argument_str_template() const {
-      static_assert(is_variable_type<T>::type::value, "argument_str_template was passed a non-variable_type type");
-      using value_type = typename T::value_type;
-      return fmt::format("{}", value_type::value);
-   }
-
-   void return_type_str(std::string & buf) const {
-     if(holds_alternative<scalar<i8>>(return_type)) {
-        buf += argument_str_template<scalar<i8>>();
-     }
-     else if(holds_alternative<scalar<i16>>(return_type)) {
-        buf += argument_str_template<scalar<i16>>();
-     }
-     else if(holds_alternative<scalar<i32>>(return_type)) {
-        buf += argument_str_template<scalar<i32>>();
-     }
-     else if(holds_alternative<scalar<i64>>(return_type)) {
-        buf += argument_str_template<scalar<i64>>();
-     }
-     else if(holds_alternative<scalar<u8>>(return_type)) {
-        buf += argument_str_template<scalar<u8>>();
-     }
-     else if(holds_alternative<scalar<u16>>(return_type)) {
-        buf += argument_str_template<scalar<u16>>();
-     }
-     else if(holds_alternative<scalar<u32>>(return_type)) {
-        buf += argument_str_template<scalar<u32>>();
-     }
-     else if(holds_alternative<scalar<u64>>(return_type)) {
-        buf += argument_str_template<scalar<u64>>();
-     }
-     else if(holds_alternative<scalar<fp16a>>(return_type)) {
-        buf += argument_str_template<scalar<fp16b>>();
-     }
-     else if(holds_alternative<scalar<fp16b>>(return_type)) {
-        buf += argument_str_template<scalar<fp16b>>();
-     }
-     else if(holds_alternative<scalar<fp32>>(return_type)) {
-        buf += argument_str_template<scalar<fp32>>();
-     }
-     else if(holds_alternative<scalar<fp64>>(return_type)) {
-        buf += argument_str_template<scalar<fp64>>();
-     }
-     else if(holds_alternative<scalar<boolean>>(return_type)) {
-        buf += argument_str_template<scalar<boolean>>();
-     }
-     else if(holds_alternative<array<i8>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i8>>());
-     }
-     else if(holds_alternative<array<i16>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i16>>());
-     }
-     else if(holds_alternative<array<i32>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i32>>());
-     }
-     else if(holds_alternative<array<i64>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<i64>>());
-     }
-     else if(holds_alternative<array<u8>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u8>>());
-     }
-     else if(holds_alternative<array<u16>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u16>>());
-     }
-     else if(holds_alternative<array<u32>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u32>>());
-     }
-     else if(holds_alternative<array<u64>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<u64>>());
-     }
-     else if(holds_alternative<array<fp16a>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<array<fp16b>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<array<fp32>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp32>>());
-     }
-     else if(holds_alternative<array<fp64>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<fp64>>());
-     }
-     else if(holds_alternative<array<boolean>>(return_type)) {
-        buf += fmt::format("{} []", argument_str_template<matrix<boolean>>());
-     }
-     else if(holds_alternative<matrix<i8>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i8>>());
-     }
-     else if(holds_alternative<matrix<i16>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i16>>());
-     }
-     else if(holds_alternative<matrix<i32>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i32>>());
-     }
-     else if(holds_alternative<matrix<i64>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<i64>>());
-     }
-     else if(holds_alternative<matrix<u8>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u8>>());
-     }
-     else if(holds_alternative<matrix<u16>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u16>>());
-     }
-     else if(holds_alternative<matrix<u32>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u32>>());
-     }
-     else if(holds_alternative<matrix<u64>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<u64>>());
-     }
-     else if(holds_alternative<matrix<fp16a>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<matrix<fp16b>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp16b>>());
-     }
-     else if(holds_alternative<matrix<fp32>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp32>>());
-     }
-     else if(holds_alternative<matrix<fp64>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<fp64>>());
-     }
-     else if(holds_alternative<matrix<boolean>>(return_type)) {
-        buf += fmt::format("{} [][]", argument_str_template<matrix<boolean>>());
-     }
-
-     buf += "void";
-   }
-
-   void decl(std::string & buf) const {
+   void return_type_str(emitter & buf) const {
+      visit([&buf](auto const& t) {
+         using T = typename std::decay<decltype(t)>::type;
+         if constexpr(is_scalar_type<T>::type::value || is_array_type<T>::type::value || is_matrix_type<T>::type::value) {
+            buf += T::value_type::value;
+            buf += type_suffix<T>::value;
+         }
+         else {
+            buf += "void";
+         }
+      }, return_type);
+   }
+
+   void decl(emitter & buf) const {
       return_type_str(buf);
-      buf += fmt::format(" {}", ident);
+      buf.format(" {}", ident);
    }
 };
 
@@ -3894,8 +3312,34 @@ struct function_def {
    std::vector<placeholder> placeholders;
    std::vector<statement> statements; 
 
-   function_def & operator()(std::initializer_list<placeholder> plhs) {
-      placeholders.reserve(plhs.size());
+   // builders never modify (*this); every call returns a new
+   // function_def so a shared definition (ie: kernel_main) can
+   // be used from any number of kernels and threads
+   //
+   function_def operator()(std::initializer_list<placeholder> plhs) const & {
+      return function_def{fdecl, placeholders, statements}.append(plhs);
+   }
+
+   function_def operator()(std::initializer_list<placeholder> plhs) && {
+      return std::move(append(plhs));
+   }
+
+   function_def operator[](std::initializer_list<statement> stmts) const & {
+      return function_def{fdecl, placeholders, statements}.append(stmts);
+   }
+
+   function_def operator[](std::initializer_list<statement> stmts) && {
+      return std::move(append(stmts));
+   }
+
+   void decl(emitter & buf) const {
+      fdecl.decl(buf);
+   }
+
+private:
+
+   function_def & append(std::initializer_list<placeholder> plhs) {
+      placeholders.reserve(placeholders.size() + plhs.size());
 
       for(auto & plh : plhs) {
          placeholders.push_back(plh);
@@ -3904,8 +3348,8 @@ struct function_def {
       return (*this);
    }
 
-   function_def & operator[](std::initializer_list<statement> stmts) {
-      statements.reserve(stmts.size());
+   function_def & append(std::initializer_list<statement> stmts) {
+      statements.reserve(statements.size() + stmts.size());
 
       for(auto & stmt : stmts) {
          statements.push_back(stmt);
@@ -3913,14 +3357,33 @@ struct function_def {
 
       return (*this);
    }
-
-   void decl(std::string & buf) const {
-      fdecl.decl(buf);
-   }
 };
 
 static inline function_decl const kernel_main_decl{"kernel_main", {}, {}};
-static inline function_def kernel_main{kernel_main_decl, {}, {}};
+static inline function_def const kernel_main{kernel_main_decl, {}, {}};
+
+// statements in a function body that are not followed by ';'
+//
+template<typename T>
+using is_unterminated_statement_type = std::conditional<
+   std::is_same<T, monostate>::value ||
+   std::is_same<T, comment>::value ||
+   std::is_same<T, recursive_wrapper<for_>>::value ||
+   std::is_same<T, recursive_wrapper<while_>>::value ||
+   std::is_same<T, recursive_wrapper<if_>>::value ||
+   std::is_same<T, recursive_wrapper<switch_>>::value ||
+   std::is_same<T, recursive_wrapper<function_def>>::value,
+   std::true_type,
+   std::false_type
+>;
+
+template<std::size_t... Is>
+constexpr std::array<bool, sizeof...(Is)> make_unterminated_statement_table(std::index_sequence<Is...>) {
+   return {{ is_unterminated_statement_type< variant_alternative_t<Is, statement> >::type::value... }};
+}
+
+static constexpr std::array<bool, variant_size<statement>::value> unterminated_statement_table =
+   make_unterminated_statement_table(std::make_index_sequence<variant_size<statement>::value>{});
 
 template<>
 void StatementVisitor::operator()(recursive_wrapper<function_def> const& t) {
@@ -3938,7 +3401,7 @@ void StatementVisitor::operator()(recursive_wrapper<function_def> const& t) {
    static std::string const terminal[2] = {";\n", "\n"};
 
    for(ph_beg_itr = t_val.placeholders.begin(); ph_beg_itr != ph_end_itr; ++ph_beg_itr) {
-      visit(*this, *ph_beg_itr);
+      visit(PlaceholderVisitor{buf}, *ph_beg_itr);
       buf += comma[ph_beg_itr+1 == ph_end_itr];
    }
 
@@ -3955,29 +3418,17 @@ void StatementVisitor::operator()(recursive_wrapper<function_def> const& t) {
 
    for(auto itr = beg_itr; itr != end_itr; ++itr) {
 
-      for(std::uint64_t i = 0; i < this->indent; ++i) {
-         buf += "    ";
-      }
+      buf.indent(this->indent);
 
       visit(*this, *itr);
 
-      buf += terminal[(
-         holds_alternative<monostate>(*itr) ||
-         holds_alternative<comment>(*itr) ||
-         holds_alternative<recursive_wrapper<for_>>(*itr) ||
-         holds_alternative<recursive_wrapper<while_>>(*itr) ||
-         holds_alternative<recursive_wrapper<if_>>(*itr) ||
-         holds_alternative<recursive_wrapper<switch_>>(*itr) ||
-         holds_alternative<recursive_wrapper<function_def>>(*itr)
-      )];
+      buf += terminal[unterminated_statement_table[itr->index()]];
 
    }
 
    this->indent = indent;
 
-   for(std::uint64_t i = 0; i < indent; ++i) {
-      buf += "    ";
-   }
+   buf.indent(indent);
 
    buf += "}";
 }
@@ -4036,65 +3487,48 @@ struct function_call {
       d.node.emplace<variable_type>( variable_type{literal<boolean>{t}} );
    }
 
-   expression_data operator()() {
-      auto _new = function_call{*this};
+   expression_data operator()() const {
       return expression_data{
-         recursive_wrapper<function_call>{_new}
+         recursive_wrapper<function_call>{function_call{fdecl, {}}}
       };
    }
 
    template<typename T>
-   expression_data operator()(T t) {
-      function_call _new = function_call{*this};
-      _new.arguments.erase(_new.arguments.begin(), _new.arguments.end());
+   void append_args(T && t) {
+      using value_type = typename std::decay<T>::type;
 
-      expression_data val;
-      if constexpr(std::is_integral<T>::value) {
-         wrap_literal(val, t);
-      }
-
-      _new.arguments.push_back(val);
-
-      //return _new;
-      return expression_data{
-         recursive_wrapper<function_call>{_new}
-      };
-   }
-
-   template<typename T>
-   void append_args(T t) {
-
-      if constexpr(std::is_integral<T>::value) {
+      if constexpr(std::is_integral<value_type>::value) {
          (*this).arguments.emplace_back(expression_data{});
-         wrap_literal((*this).arguments.back(), t);
+         wrap_literal(get<expression_data>((*this).arguments.back()), static_cast<value_type>(t));
       }
-      else if constexpr(is_variable_type<T>::type::value) {
-         (*this).arguments.emplace_back(t);
+      else if constexpr(is_variable_type<value_type>::type::value) {
+         (*this).arguments.emplace_back(expression_data{variable_type{std::forward<T>(t)}});
       }
-      else if constexpr(std::is_same<expression_data, T>::value) {
-         (*this).arguments.emplace_back(t);
+      else if constexpr(std::is_same<expression_data, value_type>::value) {
+         (*this).arguments.emplace_back(std::forward<T>(t));
       }
       else {
-         std::cerr << "ERROR\t" << typeid(T).name() << std::endl;
+         std::cerr << "ERROR\t" << typeid(value_type).name() << std::endl;
       }
 
    }
 
    template<typename T, typename... F>
-   void append_args(T const& first, F const&... rest) {
-      append_args(first);
-      append_args(rest...);
+   void append_args(T && first, F &&... rest) {
+      append_args(std::forward<T>(first));
+      append_args(std::forward<F>(rest)...);
    }
 
+   // arguments are forwarded, temporaries are moved into the call
+   //
    template<typename T, typename... F>
-   expression_data operator()(T const& first, F const&... rest) {
-      function_call _new = function_call{*this};
-      _new.arguments.erase(_new.arguments.begin(), _new.arguments.end());
-      _new.append_args(first);
-      _new.append_args(rest...);
-      //return _new;
+   expression_data operator()(T && first, F &&... rest) const {
+      function_call _new{fdecl, {}};
+      _new.arguments.reserve(1UL + sizeof...(F));
+      _new.append_args(std::forward<T>(first), std::forward<F>(rest)...);
+
       return expression_data{
-         recursive_wrapper<function_call>{_new}
+         recursive_wrapper<function_call>{std::move(_new)}
       };
    }
 
@@ -4106,7 +3540,7 @@ expression_data expression_data::operator=(function_call t) {
    return expression_data{expression_type{
       assign_op{
          std::pair< recursive_wrapper<expression_data>, recursive_wrapper<expression_data> >{
-            *this, expression_data{expression_type{recursive_wrapper<function_call>{t}}}
+            *this, expression_data{expression_type{recursive_wrapper<function_call>{std::move(t)}}}
          }
       }
    }};
@@ -4122,7 +3556,8 @@ void ExpressionVisitor::operator()(function_call const& t) {
 
    static std::string const delim [2] = { "", ", " };
 
-   buf += t.fdecl.ident + "( ";
+   buf += t.fdecl.ident;
+   buf += "( ";
 
    for(auto const& arg : t.arguments) {
       std::uint64_t i = 0;
@@ -4143,6 +3578,224 @@ void ExpressionVisitor::operator()(recursive_wrapper<function_call> const& t) {
    (*this)(t.get());
 }
 
+struct NodeCountVisitor {
+
+   // counts the nodes of a statement tree; used to pre-size
+   // the emitter before a kernel is written
+   //
+
+   std::size_t count;
+
+   NodeCountVisitor() : count(0) {}
+
+   void statements(std::vector<statement> const& stmts) {
+      for(auto const& stmt : stmts) {
+         visit(*this, stmt);
+      }
+   }
+
+   void operator()(expression_data const& t) {
+      visit(*this, t.node);
+   }
+
+   template<typename T>
+   void operator()(T const& t) {
+      ++count;
+
+      if constexpr(is_binary_op_type<T>::type::value) {
+         (*this)(t.args.first.get());
+         (*this)(t.args.second.get());
+      }
+      else if constexpr(is_unary_op_type<T>::type::value) {
+         (*this)(t.node.get());
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+         statements(t.get().arguments);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<for_>>::value) {
+         (*this)(t.get().init_expr);
+         (*this)(t.get().cond_expr);
+         (*this)(t.get().incr_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<while_>>::value) {
+         (*this)(t.get().cond_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<if_>>::value) {
+         for(auto const& branch : t.get().statements) {
+            (*this)(branch.first);
+            statements(branch.second);
+         }
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<switch_>>::value) {
+         (*this)(t.get().variable);
+         for(auto const& c : t.get().cases) {
+            (*this)(c.first);
+            statements(c.second);
+         }
+         statements(t.get().default_case);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_def>>::value) {
+         count += t.get().placeholders.size();
+         statements(t.get().statements);
+      }
+   }
+};
+
+inline std::size_t node_count(statement const* first, statement const* last) {
+   NodeCountVisitor counter{};
+   for(; first != last; ++first) {
+      visit(counter, *first);
+   }
+   return counter.count;
+}
+
+inline std::size_t node_count(std::initializer_list<statement> statements) {
+   return node_count(statements.begin(), statements.end());
+}
+
+template<typename Digest>
+struct FingerprintVisitor {
+
+   // feeds the structure of a statement tree into a digest
+   // (structural_hash or sha256); node kinds and value types
+   // (variant indices), identifiers, literal values and
+   // dimensions. every child list and string is length
+   // prefixed so distinct trees never feed the same bytes
+   //
+
+   Digest & digest;
+
+   FingerprintVisitor(Digest & d) : digest(d) {}
+
+   void tag(std::size_t const value) {
+      digest.update(static_cast<std::uint64_t>(value));
+   }
+
+   void text(std::string_view const s) {
+      tag(s.size());
+      digest.update(s);
+   }
+
+   void statements(std::vector<statement> const& stmts) {
+      tag(stmts.size());
+      for(auto const& stmt : stmts) {
+         (*this)(stmt);
+      }
+   }
+
+   void decl(function_decl const& fdecl) {
+      text(fdecl.ident);
+      tag(fdecl.args.size());
+      for(auto const& arg : fdecl.args) {
+         (*this)(arg);
+      }
+      (*this)(fdecl.return_type);
+   }
+
+   void operator()(statement const& t) {
+      tag(t.index());
+      visit(*this, t);
+   }
+
+   void operator()(expression_data const& t) {
+      tag(t.node.index());
+      visit(*this, t.node);
+   }
+
+   void operator()(variable_type const& t) {
+      tag(t.index());
+      visit(*this, t);
+   }
+
+   void operator()(placeholder const& t) {
+      tag(t.index());
+      visit(*this, t);
+   }
+
+   template<typename T>
+   void operator()(T const& t) {
+      if constexpr(is_binary_op_type<T>::type::value) {
+         (*this)(t.args.first.get());
+         (*this)(t.args.second.get());
+      }
+      else if constexpr(is_unary_op_type<T>::type::value) {
+         (*this)(t.node.get());
+      }
+      else if constexpr(std::is_same<T, decl_expr>::value) {
+         (*this)(t.var.get());
+      }
+      else if constexpr(is_literal_type<T>::type::value) {
+         std::uint64_t bits = 0;
+         std::memcpy(&bits, &t.value, sizeof(t.value));
+         digest.update(bits);
+      }
+      else if constexpr(is_scalar_type<T>::type::value || is_pointer_type<T>::type::value || is_reference_type<T>::type::value) {
+         text(t.identity);
+      }
+      else if constexpr(is_array_type<T>::type::value) {
+         text(t.identity);
+         tag(t.num_dims);
+      }
+      else if constexpr(is_matrix_type<T>::type::value) {
+         text(t.identity);
+         tag(t.dimensions.size());
+         for(auto const dim : t.dimensions) {
+            tag(dim);
+         }
+      }
+      else if constexpr(is_placeholder_arg_type<T>::type::value) {
+         tag(t.type_index);
+         tag(t.identifier);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+         decl(t.get().fdecl);
+         statements(t.get().arguments);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<for_>>::value) {
+         (*this)(t.get().init_expr);
+         (*this)(t.get().cond_expr);
+         (*this)(t.get().incr_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<while_>>::value) {
+         (*this)(t.get().cond_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<if_>>::value) {
+         tag(t.get().statements.size());
+         for(auto const& branch : t.get().statements) {
+            (*this)(branch.first);
+            statements(branch.second);
+         }
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<switch_>>::value) {
+         (*this)(t.get().variable);
+         tag(t.get().cases.size());
+         for(auto const& c : t.get().cases) {
+            (*this)(c.first);
+            statements(c.second);
+         }
+         statements(t.get().default_case);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_def>>::value) {
+         decl(t.get().fdecl);
+         tag(t.get().placeholders.size());
+         for(auto const& plh : t.get().placeholders) {
+            (*this)(plh);
+         }
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, comment>::value) {
+         text(t.data);
+      }
+      else if constexpr(std::is_same<T, include>::value) {
+         text(t.path.data);
+      }
+   }
+};
+
 struct brisc
    { constexpr static inline char const* value = R"(brisc)"; };
 struct ncrisc
@@ -4163,11 +3816,25 @@ template<typename T>
 struct kernel_context {
    static_assert(is_kernel_type<T>::type::value, "kernel type is not brisc, ncrisc, or crisc");
 
-   std::map<std::string, expression_data> variable_state;
+   // declared first so expression nodes held by
+   // variable_state are destroyed before the arena
+   //
+   node_arena arena;
+   symbol_table symbols;
+   symbol_map<expression_data> variable_state;
    std::string host_program_location;
 
    kernel_context(std::string const host_loc) :
-      variable_state(), host_program_location(host_loc) {
+      arena(), symbols(), variable_state(), host_program_location(host_loc) {
+   }
+
+   // opt-in: expression nodes built while the returned scope
+   // is alive are allocated from this context's arena
+   //
+   //    auto scope = ctx.use_arena();
+   //
+   arena_scope use_arena() {
+      return arena_scope{arena};
    }
 
    template<typename U>
@@ -4177,15 +3844,9 @@ struct kernel_context {
          "is not a valid scalar type"
       );
 
-      using map_iterator_type =
-          std::map<std::string, expression_data>::iterator;
-
-      std::pair<map_iterator_type, bool> vsitr =
-          variable_state.insert(
-             std::pair<std::string, expression_data>{ident, expression_data{expression_type{U{ident}}}}
-          );
+      const symbol sym = symbols.intern(ident);
 
-      return vsitr.first->second;
+      return *variable_state.try_emplace(sym, expression_type{U{sym}}).first;
    }
 
    template<typename U>
@@ -4195,15 +3856,9 @@ struct kernel_context {
          "is not an array type"
       );
 
-      using map_iterator_type =
-          std::map<std::string, expression_data>::iterator;
+      const symbol sym = symbols.intern(ident);
 
-      std::pair<map_iterator_type, bool> vsitr =
-          variable_state.insert(
-             std::pair<std::string, expression_data>{ident, expression_data{expression_type{array<typename U::value_type>{ident, nelems}}}}
-          );
-
-      return vsitr.first->second;
+      return *variable_state.try_emplace(sym, expression_type{array<typename U::value_type>{sym, nelems}}).first;
    }
 
    template<typename U>
@@ -4213,15 +3868,9 @@ struct kernel_context {
          "is not a matrix type"
       );
 
-      using map_iterator_type =
-          std::map<std::string, expression_data>::iterator;
-
-      std::pair<map_iterator_type, bool> vsitr =
-          variable_state.insert(
-             std::pair<std::string, expression_data>{ident, expression_data{expression_type{matrix<typename U::value_type>{ident, dims}}}}
-          );
+      const symbol sym = symbols.intern(ident);
 
-      return vsitr.first->second;
+      return *variable_state.try_emplace(sym, expression_type{matrix<typename U::value_type>{sym, dims}}).first;
    }
 
    template<typename U>
@@ -4231,15 +3880,9 @@ struct kernel_context {
          "is not a matrix type"
       );
 
-      using map_iterator_type =
-          std::map<std::string, expression_data>::iterator;
-
-      std::pair<map_iterator_type, bool> vsitr =
-          variable_state.insert(
-             std::pair<std::string, expression_data>{ident, expression_data{expression_type{matrix<typename U::value_type>{ident, dims}}}}
-          );
+      const symbol sym = symbols.intern(ident);
 
-      return vsitr.first->second;
+      return *variable_state.try_emplace(sym, expression_type{matrix<typename U::value_type>{sym, dims}}).first;
    }
 
 
@@ -4266,53 +3909,70 @@ using kernel_context_type = variant<
    kernel_context<crisc>
 >;
 
-template<typename T>
-struct kernel {
-   static_assert(is_kernel_type<T>::type::value, "kernel type is not brisc, ncrisc, or crisc");
+// walks the statement tree straight into source. kernel<T>
+// and emit() lower the tree into an ir_module (ir.hpp) and
+// emit that instead; this walk is kept as the reference the
+// ir emission is checked against
+//
+inline void emit_tree(statement const* first, statement const* last, emitter & out) {
+   out.reserve_nodes(node_count(first, last));
 
-   using kernel_type = T;
+   std::uint64_t indent = 0;
 
-   std::string kernel_impl_src;
-   std::string host_program_location;
-
-   kernel() : kernel_impl_src(), host_program_location() {};
-   kernel(std::string const& src_loc_str) : kernel_impl_src(), host_program_location(src_loc_str) {};
+   for(; first != last; ++first) {
+      visit(StatementVisitor{++indent, out}, *first);
+   }
+}
 
-   template<typename U>
-   kernel(kernel_context<U> & kctx, std::initializer_list<statement> statements) :
-      kernel_impl_src() {
+inline void emit_tree(std::initializer_list<statement> statements, emitter & out) {
+   emit_tree(statements.begin(), statements.end(), out);
+}
 
-         static_assert(
-            is_kernel_type<T>::type::value &&
-            is_kernel_type<U>::type::value,
-            "kernel<T>::implement and kernel_context<U> are not kernel types"
-         );
+// bumped whenever emit() writes a different source for the
+// same statement tree, so fingerprints from an older tt-edsl
+// never name a newer kernel
+//
+using fingerprint_version = std::integral_constant<std::size_t, 3UL>;
 
-         static_assert(
-            std::is_same<kernel_type, U>::value,
-            "kernel type and kernel_context type are not the same"
-         );
+// structural digest of a kernel, computed from its statement
+// tree without emitting it; two trees with the same
+// fingerprint emit the same source for the same core type.
+// Digest is sha256 unless named; structural_hash is faster
+// but not collision resistant, so nothing may key on it
+//
+// the digest is one walk over the finished tree, not a value
+// kept up to date while the tree is built. operators copy and
+// combine nodes by value as a kernel is written, and the
+// passes in optimize.hpp rewrite them in place, so a digest
+// carried in every node would grow each node and go stale on
+// every rewrite
+//
+template<typename T, typename Digest = sha256>
+content_hash fingerprint(statement const* first, statement const* last) {
+   static_assert(is_kernel_type<T>::type::value, "fingerprint<T> where T is not brisc, ncrisc, or crisc");
 
-         std::uint64_t indent = 0;
+   Digest digest{};
+   FingerprintVisitor fp{digest};
 
-         for(auto & stmt : statements) {
-            visit(StatementVisitor{++indent, kernel_impl_src}, stmt);
-         }
+   fp.text(T::value);
+   fp.tag(fingerprint_version::value);
+   fp.tag(static_cast<std::size_t>(last - first));
 
-         host_program_location = kctx.host_program_location;
+   for(; first != last; ++first) {
+      fp(*first);
    }
-};
 
-using kernel_type = variant<
-   std::monostate,
-   kernel<brisc>,
-   kernel<ncrisc>,
-   kernel<crisc>
->;
+   return digest.finalize();
+}
 
-template<typename T>
-std::ostream & operator<<(std::ostream & os, kernel<T> const& kern) {
-   return os << kern.kernel_impl_src;
+template<typename T, typename Digest = sha256>
+content_hash fingerprint(std::initializer_list<statement> statements) {
+   return fingerprint<T, Digest>(statements.begin(), statements.end());
+}
+
+template<typename T, typename Digest = sha256>
+content_hash fingerprint(std::vector<statement> const& statements) {
+   return fingerprint<T, Digest>(statements.data(), statements.data() + statements.size());
 }
 
 } /* namespace dsl */ } // namespace tt
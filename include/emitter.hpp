@@ -0,0 +1,183 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_EMITTER_HPP__
+#define __TT_EDSL_EMITTER_HPP__
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace tt { namespace dsl {
+
+struct emitter {
+
+   // code emission sink
+   //
+   // tokens are written into a growable fmt::memory_buffer
+   // through fmt::format_to; the buffer is drained into a
+   // std::string, a std::ostream, or a file descriptor once it
+   // reaches flush_threshold and when the emitter is destroyed
+   //
+
+   using flush_threshold = std::integral_constant<std::size_t, 64UL * 1024UL>;
+   using bytes_per_node = std::integral_constant<std::size_t, 24UL>;
+
+   enum class sink_kind : std::uint8_t {
+      string,
+      ostream,
+      fd
+   };
+
+   fmt::memory_buffer buffer;
+   sink_kind kind;
+   std::string * str;
+   std::ostream * os;
+   int fd;
+   char last;
+   bool failed;
+
+   emitter(std::string & s) :
+      buffer(), kind(sink_kind::string), str(&s), os(nullptr), fd(-1), last(s.empty() ? '\0' : s.back()), failed(false) {}
+
+   emitter(std::ostream & o) :
+      buffer(), kind(sink_kind::ostream), str(nullptr), os(&o), fd(-1), last('\0'), failed(false) {}
+
+   emitter(int const f) :
+      buffer(), kind(sink_kind::fd), str(nullptr), os(nullptr), fd(f), last('\0'), failed(false) {}
+
+   emitter(emitter const&) = delete;
+   emitter & operator=(emitter const&) = delete;
+
+   ~emitter() {
+      flush();
+   }
+
+   // pre-sizes the sink from the number of nodes about to be emitted
+   //
+   void reserve_nodes(std::size_t const nodes) {
+      const std::size_t bytes = nodes * bytes_per_node::value;
+
+      if(kind == sink_kind::string) {
+         str->reserve(str->size() + bytes);
+      }
+      else {
+         buffer.reserve((bytes < flush_threshold::value) ? bytes : flush_threshold::value);
+      }
+   }
+
+   void append(std::string_view const s) {
+      if(s.empty()) { return; }
+      buffer.append(s.data(), s.data() + s.size());
+      last = s.back();
+      drain();
+   }
+
+   emitter & operator+=(std::string_view const s) {
+      append(s);
+      return (*this);
+   }
+
+   emitter & operator+=(std::string const& s) {
+      append(std::string_view{s});
+      return (*this);
+   }
+
+   emitter & operator+=(char const* s) {
+      append(std::string_view{s});
+      return (*this);
+   }
+
+   emitter & operator+=(char const c) {
+      buffer.push_back(c);
+      last = c;
+      drain();
+      return (*this);
+   }
+
+   template<typename... Args>
+   void format(fmt::format_string<Args...> fmtstr, Args &&... args) {
+      const std::size_t before = buffer.size();
+      fmt::format_to(std::back_inserter(buffer), fmtstr, std::forward<Args>(args)...);
+      if(before < buffer.size()) {
+         last = buffer.data()[buffer.size() - 1UL];
+      }
+      drain();
+   }
+
+   void indent(std::uint64_t const n) {
+      static constexpr char const spaces[] = "                                                                ";
+      std::uint64_t remaining = n * 4UL;
+
+      while(0 < remaining) {
+         const std::uint64_t len = (remaining < sizeof(spaces) - 1UL) ? remaining : sizeof(spaces) - 1UL;
+         append(std::string_view{spaces, len});
+         remaining -= len;
+      }
+   }
+
+   // last character written, spans flushes
+   //
+   char back() const {
+      return last;
+   }
+
+   bool empty() const {
+      return last == '\0';
+   }
+
+   void flush() {
+      if(buffer.size() < 1) { return; }
+
+      if(kind == sink_kind::string) {
+         str->append(buffer.data(), buffer.size());
+      }
+      else if(kind == sink_kind::ostream) {
+         os->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         failed = failed || !(*os);
+      }
+      else {
+         char const* data = buffer.data();
+         std::size_t remaining = buffer.size();
+
+         while(0 < remaining) {
+            const ssize_t written = ::write(fd, data, remaining);
+            if(written < 0) {
+               if(errno == EINTR) { continue; }
+               failed = true;
+               break;
+            }
+            data += written;
+            remaining -= static_cast<std::size_t>(written);
+         }
+      }
+
+      buffer.clear();
+   }
+
+private:
+
+   void drain() {
+      if(flush_threshold::value <= buffer.size()) {
+         flush();
+      }
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
@@ -0,0 +1,258 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_GENERATE_HPP__
+#define __TT_EDSL_GENERATE_HPP__
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ir.hpp"
+
+namespace tt { namespace dsl {
+
+struct work_stealing_pool {
+
+   // fixed set of worker threads, one task queue per worker
+   // plus one for the thread calling run()
+   //
+   // run() deals task indices round robin across the queues;
+   // each thread pops from the back of its own queue and steals
+   // from the front of the others once it runs dry. run()
+   // blocks, the calling thread works alongside the pool
+   //
+   // concurrent run() calls from different threads take turns;
+   // the first exception a task throws is rethrown by run()
+   // once every task of that call has finished
+   //
+
+   using task_type = std::pair<std::function<void(std::size_t)> const*, std::size_t>;
+
+   struct task_queue {
+      std::mutex lock;
+      std::deque<task_type> tasks;
+   };
+
+   std::vector<std::thread> workers;
+   std::vector< std::unique_ptr<task_queue> > queues;
+
+   std::mutex run_lock;
+   std::mutex lock;
+   std::condition_variable wake;
+   std::condition_variable done;
+
+   std::size_t pending;
+   std::uint64_t epoch;
+   std::exception_ptr failure;
+   bool stopping;
+
+   work_stealing_pool(std::size_t const nworkers = default_workers()) :
+      workers(), queues(), run_lock(), lock(), wake(), done(), pending(0), epoch(0), failure(), stopping(false) {
+
+      for(std::size_t i = 0; i <= nworkers; ++i) {
+         queues.emplace_back(new task_queue{});
+      }
+
+      workers.reserve(nworkers);
+      for(std::size_t i = 0; i < nworkers; ++i) {
+         workers.emplace_back([this, i]() { worker(i); });
+      }
+   }
+
+   work_stealing_pool(work_stealing_pool const&) = delete;
+   work_stealing_pool & operator=(work_stealing_pool const&) = delete;
+
+   ~work_stealing_pool() {
+      {
+         std::lock_guard<std::mutex> guard{lock};
+         stopping = true;
+      }
+      wake.notify_all();
+
+      for(auto & w : workers) {
+         w.join();
+      }
+   }
+
+   static std::size_t default_workers() {
+      const std::size_t hw = std::thread::hardware_concurrency();
+      return (hw < 2) ? 0 : hw - 1UL;
+   }
+
+   std::size_t size() const {
+      return workers.size() + 1UL;
+   }
+
+   // calls f(i) for every i in [0, n); not reentrant, a task
+   // must not call run() on the pool running it
+   //
+   void run(std::size_t const n, std::function<void(std::size_t)> const& f) {
+      if(n < 1) { return; }
+
+      std::lock_guard<std::mutex> serial{run_lock};
+
+      {
+         std::lock_guard<std::mutex> guard{lock};
+         pending = n;
+         failure = nullptr;
+      }
+
+      for(std::size_t i = 0; i < n; ++i) {
+         task_queue & q = *queues[i % queues.size()];
+         std::lock_guard<std::mutex> guard{q.lock};
+         q.tasks.emplace_back(&f, i);
+      }
+
+      // the epoch moves only once every task is queued; a
+      // worker that wakes to it and finds the queues empty has
+      // lost them to the other threads, not missed the run
+      //
+      {
+         std::lock_guard<std::mutex> guard{lock};
+         ++epoch;
+      }
+      wake.notify_all();
+
+      drain(workers.size());
+
+      std::exception_ptr failed{};
+      {
+         std::unique_lock<std::mutex> guard{lock};
+         done.wait(guard, [this]() { return pending == 0; });
+         failed = std::move(failure);
+         failure = nullptr;
+      }
+
+      if(failed) {
+         std::rethrow_exception(failed);
+      }
+   }
+
+private:
+
+   bool pop(std::size_t const self, task_type & t) {
+      {
+         task_queue & q = *queues[self];
+         std::lock_guard<std::mutex> guard{q.lock};
+         if(!q.tasks.empty()) {
+            t = q.tasks.back();
+            q.tasks.pop_back();
+            return true;
+         }
+      }
+
+      for(std::size_t i = 1; i < queues.size(); ++i) {
+         task_queue & q = *queues[(self + i) % queues.size()];
+         std::lock_guard<std::mutex> guard{q.lock};
+         if(!q.tasks.empty()) {
+            t = q.tasks.front();
+            q.tasks.pop_front();
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   void drain(std::size_t const self) {
+      task_type t{nullptr, 0};
+      while(pop(self, t)) {
+         std::exception_ptr failed{};
+         try {
+            (*t.first)(t.second);
+         }
+         catch(...) {
+            failed = std::current_exception();
+         }
+
+         std::lock_guard<std::mutex> guard{lock};
+         if(failed && !failure) {
+            failure = std::move(failed);
+         }
+
+         if(--pending == 0) {
+            done.notify_all();
+         }
+      }
+   }
+
+   void worker(std::size_t const self) {
+      std::uint64_t seen = 0;
+
+      while(true) {
+         {
+            std::unique_lock<std::mutex> guard{lock};
+            wake.wait(guard, [this, seen]() { return stopping || epoch != seen; });
+            if(stopping) { return; }
+            seen = epoch;
+         }
+
+         drain(self);
+      }
+   }
+};
+
+inline work_stealing_pool & default_pool() {
+   static work_stealing_pool pool;
+   return pool;
+}
+
+// one kernel to generate; each job owns its kernel_context
+// for the duration of generate_all, a context must not be
+// shared between jobs
+//
+template<typename T>
+struct kernel_job {
+   kernel_context<T> & kctx;
+   std::vector<statement> statements;
+};
+
+// emits every job concurrently, results are in job order
+//
+//    std::vector<kernel_job<crisc>> jobs;
+//    jobs.push_back({ctx0, { include(cstdint), kernel_main[{ ... }] }});
+//    jobs.push_back({ctx1, { ... }});
+//
+//    std::vector<kernel<crisc>> kernels = generate_all(std::move(jobs));
+//
+template<typename T>
+std::vector< kernel<T> > generate_all(std::vector< kernel_job<T> > jobs, work_stealing_pool & pool = default_pool()) {
+   static_assert(is_kernel_type<T>::type::value, "kernel type is not brisc, ncrisc, or crisc");
+
+   std::vector< kernel<T> > kernels(jobs.size());
+
+   pool.run(jobs.size(), [&jobs, &kernels](std::size_t const i) {
+      {
+         const std::vector<statement> statements{std::move(jobs[i].statements)};
+         kernels[i] = kernel<T>{jobs[i].kctx, statements};
+      }
+
+      // the kernel's own release() ran while the statements
+      // were still alive and only marked the arena; they are
+      // destroyed now, and the job owns its context for the
+      // duration of generate_all, so the arena rewinds here
+      //
+      jobs[i].kctx.arena.release();
+   });
+
+   return kernels;
+}
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
@@ -0,0 +1,327 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_HASH_HPP__
+#define __TT_EDSL_HASH_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace tt { namespace dsl {
+
+struct content_hash {
+
+   // 256 bit content digest
+   //
+
+   using digest_size = std::integral_constant<std::size_t, 32UL>;
+
+   std::array<std::uint8_t, digest_size::value> bytes;
+
+   std::string hex() const {
+      static constexpr char const digits[] = "0123456789abcdef";
+      std::string str(digest_size::value * 2UL, '0');
+      for(std::size_t i = 0; i < digest_size::value; ++i) {
+         str[2UL * i] = digits[bytes[i] >> 4U];
+         str[2UL * i + 1UL] = digits[bytes[i] & 0x0fU];
+      }
+      return str;
+   }
+
+   // parses the output of hex(); false on malformed input
+   //
+   static bool from_hex(std::string_view const str, content_hash & h) {
+      if(str.size() != digest_size::value * 2UL) { return false; }
+
+      auto nibble = [](char const c) -> int {
+         if('0' <= c && c <= '9') { return c - '0'; }
+         if('a' <= c && c <= 'f') { return c - 'a' + 10; }
+         if('A' <= c && c <= 'F') { return c - 'A' + 10; }
+         return -1;
+      };
+
+      for(std::size_t i = 0; i < digest_size::value; ++i) {
+         const int hi = nibble(str[2UL * i]);
+         const int lo = nibble(str[2UL * i + 1UL]);
+         if(hi < 0 || lo < 0) { return false; }
+         h.bytes[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+      }
+
+      return true;
+   }
+
+   // leading 8 bytes, for in-memory hash tables
+   //
+   std::size_t prefix() const {
+      std::uint64_t p = 0;
+      std::memcpy(&p, bytes.data(), sizeof(p));
+      return static_cast<std::size_t>(p);
+   }
+
+   friend bool operator==(content_hash const& lhs, content_hash const& rhs) { return lhs.bytes == rhs.bytes; }
+   friend bool operator!=(content_hash const& lhs, content_hash const& rhs) { return lhs.bytes != rhs.bytes; }
+   friend bool operator<(content_hash const& lhs, content_hash const& rhs) { return lhs.bytes < rhs.bytes; }
+};
+
+struct sha256 {
+
+   // FIPS 180-4 SHA-256, incremental
+   //
+   //    sha256 h;
+   //    h.update(a);
+   //    h.update(b);
+   //    content_hash digest = h.finalize();
+   //
+
+   using block_size = std::integral_constant<std::size_t, 64UL>;
+
+   std::array<std::uint32_t, 8> state;
+   std::array<std::uint8_t, block_size::value> block;
+   std::size_t block_len;
+   std::uint64_t total_len;
+
+   sha256() :
+      state{{0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U}},
+      block(), block_len(0), total_len(0) {}
+
+   sha256 & update(void const* data, std::size_t len) {
+      std::uint8_t const* p = static_cast<std::uint8_t const*>(data);
+      total_len += len;
+
+      if(0 < block_len) {
+         const std::size_t n = (len < block_size::value - block_len) ? len : block_size::value - block_len;
+         std::memcpy(block.data() + block_len, p, n);
+         block_len += n;
+         p += n;
+         len -= n;
+
+         if(block_len < block_size::value) { return (*this); }
+
+         compress(block.data());
+         block_len = 0;
+      }
+
+      for(; block_size::value <= len; p += block_size::value, len -= block_size::value) {
+         compress(p);
+      }
+
+      std::memcpy(block.data(), p, len);
+      block_len = len;
+
+      return (*this);
+   }
+
+   sha256 & update(std::string_view const s) {
+      return update(s.data(), s.size());
+   }
+
+   // one word as an LEB128 varint; the tags, indices and
+   // lengths FingerprintVisitor feeds are small, and a varint
+   // sequence decodes one way, so trees stay distinct in a
+   // fraction of the bytes
+   //
+   sha256 & update(std::uint64_t w) {
+      std::uint8_t buf[10];
+      std::uint8_t * out = (block_len + sizeof(buf) <= block_size::value) ? block.data() + block_len : buf;
+
+      std::size_t n = 0;
+      for(; 0x80U <= w; w >>= 7U) {
+         out[n++] = static_cast<std::uint8_t>(w | 0x80U);
+      }
+      out[n++] = static_cast<std::uint8_t>(w);
+
+      if(out == buf) {
+         return update(buf, n);
+      }
+
+      // written in place, the block still has room
+      //
+      block_len += n;
+      total_len += n;
+      return (*this);
+   }
+
+   content_hash finalize() {
+      const std::uint64_t bits = total_len * 8ULL;
+
+      static constexpr std::uint8_t const pad[block_size::value] = { 0x80U };
+      const std::size_t padlen = (block_len < 56UL) ? 56UL - block_len : 120UL - block_len;
+      update(pad, padlen);
+
+      std::uint8_t len_be[8];
+      for(std::size_t i = 0; i < 8UL; ++i) {
+         len_be[i] = static_cast<std::uint8_t>(bits >> (56U - 8U * i));
+      }
+      update(len_be, sizeof(len_be));
+
+      content_hash h{};
+      for(std::size_t i = 0; i < state.size(); ++i) {
+         h.bytes[4UL * i] = static_cast<std::uint8_t>(state[i] >> 24U);
+         h.bytes[4UL * i + 1UL] = static_cast<std::uint8_t>(state[i] >> 16U);
+         h.bytes[4UL * i + 2UL] = static_cast<std::uint8_t>(state[i] >> 8U);
+         h.bytes[4UL * i + 3UL] = static_cast<std::uint8_t>(state[i]);
+      }
+
+      return h;
+   }
+
+   static content_hash of(std::string_view const s) {
+      return sha256{}.update(s).finalize();
+   }
+
+private:
+
+   static std::uint32_t rotr(std::uint32_t const x, std::uint32_t const n) {
+      return (x >> n) | (x << (32U - n));
+   }
+
+   void compress(std::uint8_t const* p) {
+      static constexpr std::uint32_t const k[64] = {
+         0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+         0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+         0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+         0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+         0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+         0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+         0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+         0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+      };
+
+      std::uint32_t w[64];
+      for(std::size_t i = 0; i < 16UL; ++i) {
+         w[i] = (static_cast<std::uint32_t>(p[4UL * i]) << 24U) |
+                (static_cast<std::uint32_t>(p[4UL * i + 1UL]) << 16U) |
+                (static_cast<std::uint32_t>(p[4UL * i + 2UL]) << 8U) |
+                static_cast<std::uint32_t>(p[4UL * i + 3UL]);
+      }
+
+      for(std::size_t i = 16; i < 64UL; ++i) {
+         const std::uint32_t s0 = rotr(w[i - 15UL], 7U) ^ rotr(w[i - 15UL], 18U) ^ (w[i - 15UL] >> 3U);
+         const std::uint32_t s1 = rotr(w[i - 2UL], 17U) ^ rotr(w[i - 2UL], 19U) ^ (w[i - 2UL] >> 10U);
+         w[i] = w[i - 16UL] + s0 + w[i - 7UL] + s1;
+      }
+
+      std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+      std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+      for(std::size_t i = 0; i < 64UL; ++i) {
+         const std::uint32_t t1 = h + (rotr(e, 6U) ^ rotr(e, 11U) ^ rotr(e, 25U)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+         const std::uint32_t t2 = (rotr(a, 2U) ^ rotr(a, 13U) ^ rotr(a, 22U)) + ((a & b) ^ (a & c) ^ (b & c));
+         h = g;
+         g = f;
+         f = e;
+         e = d + t1;
+         d = c;
+         c = b;
+         b = a;
+         a = t1 + t2;
+      }
+
+      state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+      state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+   }
+};
+
+struct structural_hash {
+
+   // fast non-cryptographic digest for structural fingerprints
+   // (see FingerprintVisitor in dsl.hpp); two 64 bit lanes
+   // mixed a word at a time. its collision resistance has not
+   // been analyzed, so nothing that serves or compares by a
+   // fingerprint (the kernel cache, the passes in optimize.hpp)
+   // keys on it, and fingerprint<T> only uses it when asked
+   // to. it costs about a third of sha256 on the many small
+   // values a statement tree feeds it
+   //
+   //    structural_hash h;
+   //    h.update(std::uint64_t{kind});
+   //    h.update(name);
+   //    content_hash digest = h.finalize();
+   //
+
+   std::uint64_t a;
+   std::uint64_t b;
+   std::uint64_t words;
+
+   structural_hash() : a(0x9e3779b97f4a7c15ULL), b(0xc2b2ae3d27d4eb4fULL), words(0) {}
+
+   structural_hash & update(std::uint64_t const w) {
+      a = rotl(a + w * 0xc2b2ae3d27d4eb4fULL, 31U) * 0x9e3779b97f4a7c15ULL;
+      b = rotl(b ^ (w * 0x165667b19e3779f9ULL), 27U) * 0x85ebca77c2b2ae63ULL + a;
+      ++words;
+      return (*this);
+   }
+
+   // fed as whole words, the last one zero padded; callers
+   // prefix the length so padding is never ambiguous
+   //
+   structural_hash & update(std::string_view const s) {
+      std::size_t i = 0;
+      for(; i + sizeof(std::uint64_t) <= s.size(); i += sizeof(std::uint64_t)) {
+         std::uint64_t w;
+         std::memcpy(&w, s.data() + i, sizeof(w));
+         update(w);
+      }
+
+      if(i < s.size()) {
+         std::uint64_t w = 0;
+         std::memcpy(&w, s.data() + i, s.size() - i);
+         update(w);
+      }
+
+      return (*this);
+   }
+
+   content_hash finalize() const {
+      const std::uint64_t x = fmix(a ^ words);
+      const std::uint64_t y = fmix(b + x);
+      const std::uint64_t lanes[4] = { x, y, fmix(x ^ rotl(y, 32U)), fmix(y ^ 0x94d049bb133111ebULL) };
+
+      content_hash h{};
+      for(std::size_t i = 0; i < 4UL; ++i) {
+         for(std::size_t j = 0; j < 8UL; ++j) {
+            h.bytes[8UL * i + j] = static_cast<std::uint8_t>(lanes[i] >> (56U - 8U * j));
+         }
+      }
+
+      return h;
+   }
+
+private:
+
+   static std::uint64_t rotl(std::uint64_t const x, std::uint32_t const n) {
+      return (x << n) | (x >> (64U - n));
+   }
+
+   static std::uint64_t fmix(std::uint64_t x) {
+      x ^= x >> 33U;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33U;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33U;
+      return x;
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+template<>
+struct std::hash<tt::dsl::content_hash> {
+   std::size_t operator()(tt::dsl::content_hash const& h) const noexcept {
+      return h.prefix();
+   }
+};
+
+#endif
@@ -0,0 +1,940 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_IR_HPP__
+#define __TT_EDSL_IR_HPP__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dsl.hpp"
+
+namespace tt { namespace dsl {
+
+// flat, index based representation of a statement tree
+//
+// nodes are fixed size records stored contiguously in
+// post-order (children precede their parent). nodes with
+// more than two children (calls, blocks, control flow)
+// reference a contiguous range of ir_module::edges.
+//
+
+enum class ir_opcode : std::uint8_t {
+   none,
+   variable,
+   literal,
+   placeholder,
+   decl,
+   assign,
+   index,
+   add,
+   sub,
+   mul,
+   div,
+   mod,
+   pow,
+   log,
+   exp,
+   sin,
+   cos,
+   tan,
+   lt,
+   lte,
+   gt,
+   gte,
+   eq,
+   neq,
+   neg,
+   not_,
+   xor_,
+   logical_and,
+   logical_or,
+   bitwise_and,
+   bitwise_or,
+   paren,
+   call,
+   block,
+   for_stmt,
+   while_stmt,
+   if_stmt,
+   switch_stmt,
+   function_def_stmt,
+   comment,
+   include
+};
+
+struct ir_node {
+   ir_opcode opcode;
+   std::uint8_t type_tag;   // variable_type::index() of variable, literal and decl nodes
+   std::uint16_t reserved;
+   std::uint32_t lhs;       // first child or offset into ir_module::edges
+   std::uint32_t rhs;       // second child or number of edges
+   std::uint32_t ident;     // interned string or literal pool index
+};
+
+static_assert(sizeof(ir_node) == 16UL, "ir_node is expected to be 16 bytes");
+static_assert(variant_size<variable_type>::value < 256UL, "variable_type does not fit in ir_node::type_tag");
+
+using ir_invalid = std::integral_constant<std::uint32_t, 0xFFFFFFFFU>;
+
+enum class ir_type_kind : std::uint8_t {
+   none,
+   scalar,
+   literal,
+   array,
+   matrix,
+   pointer,
+   reference,
+   placeholder
+};
+
+struct ir_type_info {
+   ir_type_kind kind;
+   char const* name;
+   void (*format_literal)(std::uint64_t, emitter &);
+};
+
+template<typename T>
+struct ir_literal_codec {
+   using value_type = typename T::value_type;
+
+   static std::uint64_t encode(value_type v) {
+      std::uint64_t bits = 0;
+      std::memcpy(&bits, &v, sizeof(value_type));
+      return bits;
+   }
+
+   static value_type decode(std::uint64_t bits) {
+      value_type v{};
+      std::memcpy(&v, &bits, sizeof(value_type));
+      return v;
+   }
+
+   static void format(std::uint64_t bits, emitter & buf) {
+      if constexpr(std::is_same<T, boolean>::value) {
+         buf += decode(bits) ? "true" : "false";
+      }
+      else if constexpr(std::is_same<value_type, float>::value) {
+         buf.format("{:f}f", decode(bits));
+      }
+      else if constexpr(std::is_floating_point<value_type>::value) {
+         buf.format("{:f}", decode(bits));
+      }
+      else {
+         buf.format("{}", decode(bits));
+      }
+   }
+};
+
+template<typename T>
+struct ir_type_of {
+   static constexpr ir_type_info value{ir_type_kind::none, "", nullptr};
+};
+
+template<typename T>
+struct ir_type_of< scalar<T> > {
+   static constexpr ir_type_info value{ir_type_kind::scalar, T::value, nullptr};
+};
+
+template<typename T>
+struct ir_type_of< literal<T> > {
+   static constexpr ir_type_info value{ir_type_kind::literal, T::value, &ir_literal_codec<T>::format};
+};
+
+template<typename T>
+struct ir_type_of< array<T> > {
+   static constexpr ir_type_info value{ir_type_kind::array, T::value, nullptr};
+};
+
+template<typename T>
+struct ir_type_of< matrix<T> > {
+   static constexpr ir_type_info value{ir_type_kind::matrix, T::value, nullptr};
+};
+
+template<typename T>
+struct ir_type_of< pointer<T> > {
+   static constexpr ir_type_info value{ir_type_kind::pointer, underlying_value_type<T>::value_type::value, nullptr};
+};
+
+template<typename T>
+struct ir_type_of< reference<T> > {
+   static constexpr ir_type_info value{ir_type_kind::reference, underlying_value_type<T>::value_type::value, nullptr};
+};
+
+template<>
+struct ir_type_of< placeholder > {
+   static constexpr ir_type_info value{ir_type_kind::placeholder, "", nullptr};
+};
+
+template<std::size_t... Is>
+constexpr std::array<ir_type_info, sizeof...(Is)> make_ir_type_table(std::index_sequence<Is...>) {
+   return {{ ir_type_of< variant_alternative_t<Is, variable_type> >::value... }};
+}
+
+static constexpr std::array<ir_type_info, variant_size<variable_type>::value> ir_type_table =
+   make_ir_type_table(std::make_index_sequence<variant_size<variable_type>::value>{});
+
+// placeholder_value_type index -> variable_type index
+//
+template<std::size_t... Is>
+constexpr std::array<std::uint8_t, sizeof...(Is)> make_ir_placeholder_tags(std::index_sequence<Is...>) {
+   return {{ static_cast<std::uint8_t>(alternative_index< variant_alternative_t<Is, placeholder_value_type>, variable_type >::value)... }};
+}
+
+static constexpr std::array<std::uint8_t, variant_size<placeholder_value_type>::value> ir_placeholder_tags =
+   make_ir_placeholder_tags(std::make_index_sequence<variant_size<placeholder_value_type>::value>{});
+
+template<typename T> struct ir_opcode_of { using type = std::integral_constant<ir_opcode, ir_opcode::none>; };
+template<> struct ir_opcode_of<assign_op> { using type = std::integral_constant<ir_opcode, ir_opcode::assign>; };
+template<> struct ir_opcode_of<index_op> { using type = std::integral_constant<ir_opcode, ir_opcode::index>; };
+template<> struct ir_opcode_of<add_op> { using type = std::integral_constant<ir_opcode, ir_opcode::add>; };
+template<> struct ir_opcode_of<sub_op> { using type = std::integral_constant<ir_opcode, ir_opcode::sub>; };
+template<> struct ir_opcode_of<mul_op> { using type = std::integral_constant<ir_opcode, ir_opcode::mul>; };
+template<> struct ir_opcode_of<div_op> { using type = std::integral_constant<ir_opcode, ir_opcode::div>; };
+template<> struct ir_opcode_of<mod_op> { using type = std::integral_constant<ir_opcode, ir_opcode::mod>; };
+template<> struct ir_opcode_of<pow_op> { using type = std::integral_constant<ir_opcode, ir_opcode::pow>; };
+template<> struct ir_opcode_of<log_op> { using type = std::integral_constant<ir_opcode, ir_opcode::log>; };
+template<> struct ir_opcode_of<exp_op> { using type = std::integral_constant<ir_opcode, ir_opcode::exp>; };
+template<> struct ir_opcode_of<sin_op> { using type = std::integral_constant<ir_opcode, ir_opcode::sin>; };
+template<> struct ir_opcode_of<cos_op> { using type = std::integral_constant<ir_opcode, ir_opcode::cos>; };
+template<> struct ir_opcode_of<tan_op> { using type = std::integral_constant<ir_opcode, ir_opcode::tan>; };
+template<> struct ir_opcode_of<lt_op> { using type = std::integral_constant<ir_opcode, ir_opcode::lt>; };
+template<> struct ir_opcode_of<lte_op> { using type = std::integral_constant<ir_opcode, ir_opcode::lte>; };
+template<> struct ir_opcode_of<gt_op> { using type = std::integral_constant<ir_opcode, ir_opcode::gt>; };
+template<> struct ir_opcode_of<gte_op> { using type = std::integral_constant<ir_opcode, ir_opcode::gte>; };
+template<> struct ir_opcode_of<eq_op> { using type = std::integral_constant<ir_opcode, ir_opcode::eq>; };
+template<> struct ir_opcode_of<neq_op> { using type = std::integral_constant<ir_opcode, ir_opcode::neq>; };
+template<> struct ir_opcode_of<neg_op> { using type = std::integral_constant<ir_opcode, ir_opcode::neg>; };
+template<> struct ir_opcode_of<not_op> { using type = std::integral_constant<ir_opcode, ir_opcode::not_>; };
+template<> struct ir_opcode_of<xor_op> { using type = std::integral_constant<ir_opcode, ir_opcode::xor_>; };
+template<> struct ir_opcode_of<logical_and_op> { using type = std::integral_constant<ir_opcode, ir_opcode::logical_and>; };
+template<> struct ir_opcode_of<logical_or_op> { using type = std::integral_constant<ir_opcode, ir_opcode::logical_or>; };
+template<> struct ir_opcode_of<bitwise_and_op> { using type = std::integral_constant<ir_opcode, ir_opcode::bitwise_and>; };
+template<> struct ir_opcode_of<bitwise_or_op> { using type = std::integral_constant<ir_opcode, ir_opcode::bitwise_or>; };
+template<> struct ir_opcode_of<paren_op> { using type = std::integral_constant<ir_opcode, ir_opcode::paren>; };
+
+struct ir_module {
+   std::vector<ir_node> nodes;
+   std::vector<std::uint32_t> edges;
+   std::vector<std::uint64_t> literals;
+   std::vector<std::string> strings;
+   std::unordered_map<std::string, std::uint32_t> string_ids;
+   std::unordered_map<std::uint32_t, std::uint32_t> symbol_ids;
+   std::vector<std::uint32_t> roots;
+
+   std::uint32_t intern(std::string_view const str) {
+      std::string key{str};
+      auto itr = string_ids.find(key);
+      if(itr != string_ids.end()) {
+         return itr->second;
+      }
+
+      const std::uint32_t id = static_cast<std::uint32_t>(strings.size());
+      strings.push_back(key);
+      string_ids.emplace(std::move(key), id);
+      return id;
+   }
+
+   std::uint32_t intern(std::string const& str) {
+      return intern(std::string_view{str});
+   }
+
+   // variable identities are already interned, map them by symbol id
+   //
+   std::uint32_t intern(symbol const& sym) {
+      auto itr = symbol_ids.find(sym.id());
+      if(itr != symbol_ids.end()) {
+         return itr->second;
+      }
+
+      const std::uint32_t id = intern(sym.view());
+      symbol_ids.emplace(sym.id(), id);
+      return id;
+   }
+
+   std::uint32_t push(ir_opcode op, std::uint8_t type_tag, std::uint32_t lhs, std::uint32_t rhs, std::uint32_t ident) {
+      nodes.push_back(ir_node{op, type_tag, 0, lhs, rhs, ident});
+      return static_cast<std::uint32_t>(nodes.size() - 1UL);
+   }
+
+   // appends a child list, returns the offset into edges
+   //
+   std::uint32_t push_edges(std::vector<std::uint32_t> const& children) {
+      const std::uint32_t offset = static_cast<std::uint32_t>(edges.size());
+      edges.insert(edges.end(), children.begin(), children.end());
+      return offset;
+   }
+
+   std::uint32_t const* children(ir_node const& n) const {
+      return edges.data() + n.lhs;
+   }
+
+   std::size_t bytes() const {
+      std::size_t total = nodes.size() * sizeof(ir_node) +
+         edges.size() * sizeof(std::uint32_t) +
+         literals.size() * sizeof(std::uint64_t);
+
+      for(auto const& str : strings) {
+         total += str.size();
+      }
+
+      return total;
+   }
+};
+
+struct IrBuilder {
+
+   // lowers expression_data / statement trees into an ir_module
+   //
+
+   ir_module & mod;
+
+   IrBuilder(ir_module & m) : mod(m) {}
+
+   std::uint32_t variable(variable_type const& v) {
+      const std::uint8_t tag = static_cast<std::uint8_t>(v.index());
+
+      return visit([this, tag](auto const& t) -> std::uint32_t {
+         using T = typename std::decay<decltype(t)>::type;
+
+         if constexpr(is_literal_type<T>::type::value) {
+            const std::uint32_t lit = static_cast<std::uint32_t>(mod.literals.size());
+            mod.literals.push_back(ir_literal_codec<typename T::value_type>::encode(t.value));
+            return mod.push(ir_opcode::literal, tag, ir_invalid::value, ir_invalid::value, lit);
+         }
+         else if constexpr(std::is_same<T, placeholder>::value) {
+            return visit([this](auto const& p) -> std::uint32_t {
+               using P = typename std::decay<decltype(p)>::type;
+               if constexpr(std::is_base_of<placeholder_arg_base, P>::value) {
+                  // type_tag is the variable_type index of the placeholder's value type
+                  //
+                  return mod.push(ir_opcode::placeholder, ir_placeholder_tags[p.type_index], ir_invalid::value, ir_invalid::value, mod.intern(p.identity));
+               }
+               else {
+                  return mod.push(ir_opcode::none, 0, ir_invalid::value, ir_invalid::value, ir_invalid::value);
+               }
+            }, t);
+         }
+         else if constexpr(
+            is_scalar_type<T>::type::value || is_array_type<T>::type::value || is_matrix_type<T>::type::value ||
+            is_pointer_type<T>::type::value || is_reference_type<T>::type::value) {
+            return mod.push(ir_opcode::variable, tag, ir_invalid::value, ir_invalid::value, mod.intern(t.identity));
+         }
+         else {
+            return mod.push(ir_opcode::none, tag, ir_invalid::value, ir_invalid::value, ir_invalid::value);
+         }
+      }, v);
+   }
+
+   std::uint32_t declaration(variable_type const& v) {
+      const std::uint8_t tag = static_cast<std::uint8_t>(v.index());
+
+      return visit([this, tag](auto const& t) -> std::uint32_t {
+         using T = typename std::decay<decltype(t)>::type;
+         std::vector<std::uint32_t> dims;
+
+         if constexpr(is_array_type<T>::type::value) {
+            dims.push_back(static_cast<std::uint32_t>(t.num_dims));
+         }
+         else if constexpr(is_matrix_type<T>::type::value) {
+            for(auto const& dim : t.dimensions) {
+               dims.push_back(static_cast<std::uint32_t>(dim));
+            }
+         }
+
+         if constexpr(is_scalar_type<T>::type::value || is_array_type<T>::type::value || is_matrix_type<T>::type::value) {
+            const std::uint32_t offset = mod.push_edges(dims);
+            return mod.push(ir_opcode::decl, tag, offset, static_cast<std::uint32_t>(dims.size()), mod.intern(t.identity));
+         }
+         else {
+            return mod.push(ir_opcode::none, tag, ir_invalid::value, ir_invalid::value, ir_invalid::value);
+         }
+      }, v);
+   }
+
+   std::uint32_t expression(expression_data const& e) {
+      return visit([this](auto const& t) -> std::uint32_t {
+         using T = typename std::decay<decltype(t)>::type;
+
+         if constexpr(std::is_same<T, variable_type>::value) {
+            return variable(t);
+         }
+         else if constexpr(std::is_same<T, decl_expr>::value) {
+            return declaration(get<variable_type>(t.var.get().node));
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+            function_call const& call = t.get();
+            std::vector<std::uint32_t> args;
+            args.reserve(call.arguments.size());
+            for(auto const& arg : call.arguments) {
+               args.push_back(statement_node(arg));
+            }
+
+            const std::uint32_t offset = mod.push_edges(args);
+            return mod.push(ir_opcode::call, 0, offset, static_cast<std::uint32_t>(args.size()), mod.intern(call.fdecl.ident));
+         }
+         else if constexpr(is_unary_op_type<T>::type::value) {
+            const std::uint32_t child = expression(t.node.get());
+            return mod.push(ir_opcode_of<T>::type::value, 0, child, ir_invalid::value, ir_invalid::value);
+         }
+         else if constexpr(is_binary_op_type<T>::type::value) {
+            const std::uint32_t lhs = expression(t.args.first.get());
+            const std::uint32_t rhs = expression(t.args.second.get());
+            return mod.push(ir_opcode_of<T>::type::value, 0, lhs, rhs, ir_invalid::value);
+         }
+         else {
+            return mod.push(ir_opcode::none, 0, ir_invalid::value, ir_invalid::value, ir_invalid::value);
+         }
+      }, e.node);
+   }
+
+   std::uint32_t block(std::vector<statement> const& stmts) {
+      std::vector<std::uint32_t> children;
+      children.reserve(stmts.size());
+      for(auto const& stmt : stmts) {
+         children.push_back(statement_node(stmt));
+      }
+
+      const std::uint32_t offset = mod.push_edges(children);
+      return mod.push(ir_opcode::block, 0, offset, static_cast<std::uint32_t>(children.size()), ir_invalid::value);
+   }
+
+   std::uint32_t statement_node(statement const& stmt) {
+      return visit([this](auto const& t) -> std::uint32_t {
+         using T = typename std::decay<decltype(t)>::type;
+
+         if constexpr(std::is_same<T, expression_data>::value) {
+            return expression(t);
+         }
+         else if constexpr(std::is_same<T, comment>::value) {
+            return mod.push(ir_opcode::comment, 0, ir_invalid::value, ir_invalid::value, mod.intern(t.data));
+         }
+         else if constexpr(std::is_same<T, include>::value) {
+            return mod.push(ir_opcode::include, 0, ir_invalid::value, ir_invalid::value, mod.intern(t.path.data));
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<for_>>::value) {
+            for_ const& f = t.get();
+            std::vector<std::uint32_t> children{
+               expression(f.init_expr), expression(f.cond_expr), expression(f.incr_expr), block(f.statements)
+            };
+            const std::uint32_t offset = mod.push_edges(children);
+            return mod.push(ir_opcode::for_stmt, 0, offset, static_cast<std::uint32_t>(children.size()), ir_invalid::value);
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<while_>>::value) {
+            while_ const& w = t.get();
+            const std::uint32_t cond = expression(w.cond_expr);
+            const std::uint32_t body = block(w.statements);
+            return mod.push(ir_opcode::while_stmt, 0, cond, body, ir_invalid::value);
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<if_>>::value) {
+            // edges: (condition, block) pairs, a none condition is an else branch
+            //
+            std::vector<std::uint32_t> children;
+            for(auto const& branch : t.get().statements) {
+               children.push_back(expression(branch.first));
+               children.push_back(block(branch.second));
+            }
+            const std::uint32_t offset = mod.push_edges(children);
+            return mod.push(ir_opcode::if_stmt, 0, offset, static_cast<std::uint32_t>(children.size()), ir_invalid::value);
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<switch_>>::value) {
+            // edges: variable, (case, block) pairs, default block
+            //
+            switch_ const& s = t.get();
+            std::vector<std::uint32_t> children{ expression(s.variable) };
+            for(auto const& c : s.cases) {
+               children.push_back(expression(c.first));
+               children.push_back(block(c.second));
+            }
+            children.push_back(block(s.default_case));
+            const std::uint32_t offset = mod.push_edges(children);
+            return mod.push(ir_opcode::switch_stmt, 0, offset, static_cast<std::uint32_t>(children.size()), ir_invalid::value);
+         }
+         else if constexpr(std::is_same<T, recursive_wrapper<function_def>>::value) {
+            // edges: placeholders, block; type_tag is the return type
+            //
+            function_def const& fd = t.get();
+            std::vector<std::uint32_t> children;
+            for(auto const& plh : fd.placeholders) {
+               children.push_back(variable(variable_type{plh}));
+            }
+            children.push_back(block(fd.statements));
+            const std::uint32_t offset = mod.push_edges(children);
+            return mod.push(ir_opcode::function_def_stmt, static_cast<std::uint8_t>(fd.fdecl.return_type.index()),
+               offset, static_cast<std::uint32_t>(children.size()), mod.intern(fd.fdecl.ident));
+         }
+         else {
+            return mod.push(ir_opcode::none, 0, ir_invalid::value, ir_invalid::value, ir_invalid::value);
+         }
+      }, stmt);
+   }
+
+   void root(statement const& stmt) {
+      mod.roots.push_back(statement_node(stmt));
+   }
+};
+
+inline ir_module lower(statement const* first, statement const* last) {
+   ir_module mod;
+   IrBuilder builder{mod};
+   for(; first != last; ++first) {
+      builder.root(*first);
+   }
+   return mod;
+}
+
+inline ir_module lower(std::initializer_list<statement> statements) {
+   return lower(statements.begin(), statements.end());
+}
+
+// statement list built ahead of time
+//
+inline ir_module lower(std::vector<statement> const& statements) {
+   return lower(statements.data(), statements.data() + statements.size());
+}
+
+struct IrVisitor {
+
+   // emits kernel source from an ir_module; output matches
+   // emit_tree (dsl.hpp)
+   //
+
+   ir_module const& mod;
+   emitter & buf;
+
+   IrVisitor(ir_module const& m, emitter & b) : mod(m), buf(b) {}
+
+   static bool is_statement_op(ir_opcode op) {
+      return op == ir_opcode::for_stmt || op == ir_opcode::while_stmt || op == ir_opcode::if_stmt ||
+         op == ir_opcode::switch_stmt || op == ir_opcode::function_def_stmt;
+   }
+
+   void indent(std::uint64_t n) {
+      buf.indent(n);
+   }
+
+   void binary(ir_node const& n, char const* op) {
+      expression(n.lhs);
+      buf += op;
+      expression(n.rhs);
+   }
+
+   static char const* dims_suffix(ir_type_kind kind) {
+      return (kind == ir_type_kind::array) ? " []" : (kind == ir_type_kind::matrix) ? " [][]" : "";
+   }
+
+   void placeholder_argument(ir_node const& n) {
+      if(n.opcode != ir_opcode::placeholder) { return; }
+
+      ir_type_info const& info = ir_type_table[n.type_tag];
+      buf.format("{} {}{}", info.name, mod.strings[n.ident], dims_suffix(info.kind));
+   }
+
+   void declaration(ir_node const& n) {
+      ir_type_info const& info = ir_type_table[n.type_tag];
+      std::string const& ident = mod.strings[n.ident];
+      std::uint32_t const* dims = mod.children(n);
+
+      if(info.kind == ir_type_kind::scalar) {
+         buf.format("{} {}", info.name, ident);
+      }
+      else if(info.kind == ir_type_kind::array) {
+         buf.format("{} {} [{}]", info.name, ident, dims[0]);
+      }
+      else if(info.kind == ir_type_kind::matrix) {
+         buf.format("{} {} ", info.name, ident);
+         for(std::uint32_t i = 0; i < n.rhs; ++i) {
+            buf.format("[{}]", dims[i]);
+         }
+      }
+   }
+
+   void expression(std::uint32_t idx) {
+      ir_node const& n = mod.nodes[idx];
+
+      switch(n.opcode) {
+         case ir_opcode::variable:
+            buf += mod.strings[n.ident];
+            break;
+         case ir_opcode::literal:
+            ir_type_table[n.type_tag].format_literal(mod.literals[n.ident], buf);
+            break;
+         case ir_opcode::decl:
+            declaration(n);
+            break;
+         case ir_opcode::assign: binary(n, " = "); break;
+         case ir_opcode::add: binary(n, " + "); break;
+         case ir_opcode::sub: binary(n, " - "); break;
+         case ir_opcode::mul: binary(n, " * "); break;
+         case ir_opcode::div: binary(n, " / "); break;
+         case ir_opcode::mod: binary(n, " % "); break;
+         case ir_opcode::lt: binary(n, " < "); break;
+         case ir_opcode::lte: binary(n, " <= "); break;
+         case ir_opcode::gt: binary(n, " > "); break;
+         case ir_opcode::gte: binary(n, " >= "); break;
+         case ir_opcode::eq: binary(n, " == "); break;
+         case ir_opcode::neq: binary(n, " != "); break;
+         case ir_opcode::logical_and: binary(n, " && "); break;
+         case ir_opcode::logical_or: binary(n, " || "); break;
+         case ir_opcode::bitwise_and: binary(n, " & "); break;
+         case ir_opcode::bitwise_or: binary(n, " | "); break;
+         case ir_opcode::xor_: binary(n, " ^ "); break;
+         case ir_opcode::index:
+            expression(n.lhs);
+            buf += " [ ";
+            expression(n.rhs);
+            buf += " ] ";
+            break;
+         case ir_opcode::paren:
+            buf += "( ";
+            expression(n.lhs);
+            buf += " )";
+            break;
+         case ir_opcode::neg:
+            buf += "-";
+            expression(n.lhs);
+            break;
+         case ir_opcode::not_:
+            buf += "!";
+            expression(n.lhs);
+            break;
+         case ir_opcode::call:
+         {
+            static char const* const delim[2] = { "", ", " };
+            std::uint32_t const* args = mod.children(n);
+
+            buf += mod.strings[n.ident];
+            buf += "( ";
+            for(std::uint32_t i = 0; i < n.rhs; ++i) {
+               std::uint64_t zero = 0;
+               statement(args[i], zero);
+               buf += delim[i + 1U < n.rhs];
+            }
+            buf += " )";
+            break;
+         }
+         default:
+            break;
+      }
+   }
+
+   // body of for_/while_/if_/switch_, every statement is
+   // terminated with ";\n" as in StatementVisitor
+   //
+   void block(std::uint32_t idx, std::uint64_t & level) {
+      ir_node const& n = mod.nodes[idx];
+      std::uint32_t const* stmts = mod.children(n);
+
+      for(std::uint32_t i = 0; i < n.rhs; ++i) {
+         indent(level);
+         statement(stmts[i], level);
+         if(mod.nodes[stmts[i]].opcode != ir_opcode::none) {
+            buf += ";\n";
+         }
+      }
+   }
+
+   void statement(std::uint32_t idx, std::uint64_t & level) {
+      ir_node const& n = mod.nodes[idx];
+      std::uint32_t const* c = mod.children(n);
+
+      switch(n.opcode) {
+         case ir_opcode::comment:
+            buf.format("// {}", mod.strings[n.ident]);
+            break;
+         case ir_opcode::include:
+            buf.format("#include<{}>", mod.strings[n.ident]);
+            break;
+         case ir_opcode::for_stmt:
+            buf += "for ( ";
+            expression(c[0]);
+            buf += " ; ";
+            expression(c[1]);
+            buf += " ; ";
+            expression(c[2]);
+            buf += " ) {\n";
+            ++level;
+            block(c[3], level);
+            --level;
+            indent(level);
+            buf += "}";
+            break;
+         case ir_opcode::while_stmt:
+            buf += "while ( ";
+            expression(n.lhs);
+            buf += " ) {\n";
+            ++level;
+            block(n.rhs, level);
+            --level;
+            indent(level);
+            buf += "}";
+            break;
+         case ir_opcode::if_stmt:
+            for(std::uint32_t i = 0; i < n.rhs; i += 2U) {
+               if(i == 0) {
+                  buf += "if ( ";
+                  expression(c[i]);
+                  buf += " ) ";
+               }
+               else if(mod.nodes[c[i]].opcode == ir_opcode::none) {
+                  buf += "\n";
+                  indent(level);
+                  buf += "else";
+               }
+               else {
+                  buf += "\n";
+                  indent(level);
+                  buf += "else if ( ";
+                  expression(c[i]);
+                  buf += " ) ";
+               }
+               buf += " {\n";
+               ++level;
+               block(c[i+1U], level);
+               --level;
+               indent(level);
+               buf += "}";
+            }
+            break;
+         case ir_opcode::switch_stmt:
+         {
+            buf += "switch ( ";
+            expression(c[0]);
+            buf += " ) {\n";
+            ++level;
+            const std::uint32_t last = n.rhs - 1U;
+            for(std::uint32_t i = 1; i < last; i += 2U) {
+               indent(level);
+               buf += "case ";
+               expression(c[i]);
+               buf += " :\n";
+               indent(level);
+               buf += "{\n";
+               ++level;
+               block(c[i+1U], level);
+               --level;
+               indent(level);
+               buf += "}\n";
+               indent(level);
+               buf += "break;\n";
+            }
+            if(0 < mod.nodes[c[last]].rhs) {
+               indent(level);
+               buf += "default:\n";
+               indent(level);
+               buf += "{\n";
+               ++level;
+               block(c[last], level);
+               --level;
+               indent(level);
+               buf += "}\n";
+               indent(level);
+               buf += "break;\n";
+            }
+            --level;
+            indent(level);
+            buf += "}";
+            break;
+         }
+         case ir_opcode::function_def_stmt:
+         {
+            static char const* const comma[2] = {" , ", ""};
+            const std::uint32_t nplh = n.rhs - 1U;
+
+            ir_type_info const& ret = ir_type_table[n.type_tag];
+            buf += (ret.kind == ir_type_kind::none) ? "void" : ret.name;
+            buf += dims_suffix(ret.kind);
+            buf.format(" {}", mod.strings[n.ident]);
+            buf += " ( ";
+            for(std::uint32_t i = 0; i < nplh; ++i) {
+               ir_node const& plh = mod.nodes[c[i]];
+               placeholder_argument(plh);
+               buf += comma[i + 1U == nplh];
+            }
+            buf += " ) {\n";
+
+            ir_node const& body = mod.nodes[c[nplh]];
+            std::uint32_t const* stmts = mod.children(body);
+            ++level;
+            for(std::uint32_t i = 0; i < body.rhs; ++i) {
+               indent(level);
+               statement(stmts[i], level);
+               const ir_opcode op = mod.nodes[stmts[i]].opcode;
+               buf += (op == ir_opcode::none || op == ir_opcode::comment || is_statement_op(op)) ? "\n" : ";\n";
+            }
+            --level;
+            indent(level);
+            buf += "}";
+            break;
+         }
+         default:
+            expression(idx);
+            break;
+      }
+   }
+
+   // top level statements, terminated as kernel<T> does
+   //
+   void root(std::uint32_t idx) {
+      static char const* const term[2] = { " ;\n", ";\n" };
+      const ir_opcode op = mod.nodes[idx].opcode;
+
+      std::uint64_t level = 1;
+      indent(level);
+      statement(idx, level);
+
+      if(op == ir_opcode::comment || op == ir_opcode::include || is_statement_op(op)) {
+         buf += "\n";
+      }
+      else {
+         buf += term[buf.back() == ' '];
+      }
+   }
+
+   void operator()() {
+      for(auto const& idx : mod.roots) {
+         root(idx);
+      }
+   }
+};
+
+inline void emit(ir_module const& mod, emitter & out) {
+   out.reserve_nodes(mod.nodes.size());
+   IrVisitor{mod, out}();
+}
+
+// lowers a statement tree and emits the module; every
+// kernel's source is written this way
+//
+inline void emit(statement const* first, statement const* last, emitter & out) {
+   emit(lower(first, last), out);
+}
+
+inline void emit(std::initializer_list<statement> statements, emitter & out) {
+   emit(statements.begin(), statements.end(), out);
+}
+
+template<typename T>
+struct kernel {
+   static_assert(is_kernel_type<T>::type::value, "kernel type is not brisc, ncrisc, or crisc");
+
+   using kernel_type = T;
+
+   std::string kernel_impl_src;
+   std::string host_program_location;
+
+   kernel() : kernel_impl_src(), host_program_location() {};
+   kernel(std::string const& src_loc_str) : kernel_impl_src(), host_program_location(src_loc_str) {};
+
+   template<typename U>
+   kernel(kernel_context<U> & kctx, std::initializer_list<statement> statements) :
+      kernel_impl_src() {
+
+         static_assert(
+            is_kernel_type<T>::type::value &&
+            is_kernel_type<U>::type::value,
+            "kernel<T>::implement and kernel_context<U> are not kernel types"
+         );
+
+         static_assert(
+            std::is_same<kernel_type, U>::value,
+            "kernel type and kernel_context type are not the same"
+         );
+
+         {
+            emitter out{kernel_impl_src};
+            emit(statements, out);
+         }
+
+         host_program_location = kctx.host_program_location;
+
+         // every node of this kernel is released once the
+         // statement temporaries are gone
+         //
+         kctx.arena.release();
+   }
+
+   // statement list built ahead of time (ie: a generate_all job)
+   //
+   template<typename U>
+   kernel(kernel_context<U> & kctx, std::vector<statement> const& statements) :
+      kernel_impl_src() {
+
+         static_assert(
+            std::is_same<kernel_type, U>::value,
+            "kernel type and kernel_context type are not the same"
+         );
+
+         {
+            emitter out{kernel_impl_src};
+            emit(statements.data(), statements.data() + statements.size(), out);
+         }
+
+         host_program_location = kctx.host_program_location;
+         kctx.arena.release();
+   }
+};
+
+using kernel_type = variant<
+   std::monostate,
+   kernel<brisc>,
+   kernel<ncrisc>,
+   kernel<crisc>
+>;
+
+// streams kernel source straight into an emitter sink
+// (ie: a file descriptor in the Metallium JIT build
+// directory) without building kernel_impl_src
+//
+//    emitter out{fd};
+//    emit(ctx, { ... }, out);
+//
+template<typename U>
+void emit(kernel_context<U> & kctx, std::initializer_list<statement> statements, emitter & out) {
+   static_assert(is_kernel_type<U>::type::value, "kernel_context type is not brisc, ncrisc, or crisc");
+
+   emit(statements, out);
+   out.flush();
+
+   kctx.arena.release();
+}
+
+template<typename T>
+std::ostream & operator<<(std::ostream & os, kernel<T> const& kern) {
+   return os << kern.kernel_impl_src;
+}
+
+// emits a lowered module as a kernel and, as kernel<T> does,
+// releases the context's arena; the module holds no nodes, and
+// statement trees still alive only defer the rewind
+//
+// auto mod = lower({ ... });
+// kernel<brisc> k = emit(ctx, mod);
+//
+template<typename T>
+kernel<T> emit(kernel_context<T> & kctx, ir_module const& mod) {
+   kernel<T> kern{kctx.host_program_location};
+   {
+      emitter out{kern.kernel_impl_src};
+      emit(mod, out);
+   }
+
+   kctx.arena.release();
+   return kern;
+}
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
@@ -0,0 +1,187 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_LRU_HPP__
+#define __TT_EDSL_LRU_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tt { namespace dsl {
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+struct sharded_lru {
+
+   // bounded, thread safe least recently used map
+   //
+   // keys are spread over independently locked shards so
+   // concurrent lookups of different kernels rarely contend;
+   // each shard evicts its own least recently used entry once
+   // it holds capacity / shards entries
+   //
+
+   struct shard {
+      std::mutex lock;
+      std::list< std::pair<K, V> > order;
+      std::unordered_map<K, typename std::list< std::pair<K, V> >::iterator, Hash> index;
+   };
+
+   std::vector< std::unique_ptr<shard> > shards;
+   std::size_t shard_capacity;
+
+   std::atomic<std::uint64_t> hits;
+   std::atomic<std::uint64_t> misses;
+   std::atomic<std::uint64_t> evictions;
+
+   sharded_lru(std::size_t const capacity, std::size_t const nshards = 16UL) :
+      shards(), shard_capacity(0), hits(0), misses(0), evictions(0) {
+      const std::size_t n = (nshards < 1) ? 1UL : nshards;
+      shard_capacity = (capacity + n - 1UL) / n;
+
+      shards.reserve(n);
+      for(std::size_t i = 0; i < n; ++i) {
+         shards.emplace_back(new shard{});
+      }
+   }
+
+   sharded_lru(sharded_lru const&) = delete;
+   sharded_lru & operator=(sharded_lru const&) = delete;
+
+   std::size_t capacity() const {
+      return shard_capacity * shards.size();
+   }
+
+   // copies the value out and marks it most recently used
+   //
+   bool get(K const& key, V & value) {
+      shard & s = shard_of(key);
+      std::lock_guard<std::mutex> guard{s.lock};
+
+      auto itr = s.index.find(key);
+      if(itr == s.index.end()) {
+         misses.fetch_add(1, std::memory_order_relaxed);
+         return false;
+      }
+
+      s.order.splice(s.order.begin(), s.order, itr->second);
+      value = itr->second->second;
+
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return true;
+   }
+
+   bool contains(K const& key) {
+      shard & s = shard_of(key);
+      std::lock_guard<std::mutex> guard{s.lock};
+
+      const bool found = s.index.find(key) != s.index.end();
+      (found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+      return found;
+   }
+
+   void put(K const& key, V value) {
+      if(shard_capacity < 1) { return; }
+
+      shard & s = shard_of(key);
+      std::lock_guard<std::mutex> guard{s.lock};
+
+      auto itr = s.index.find(key);
+      if(itr != s.index.end()) {
+         itr->second->second = std::move(value);
+         s.order.splice(s.order.begin(), s.order, itr->second);
+         return;
+      }
+
+      if(shard_capacity <= s.order.size()) {
+         s.index.erase(s.order.back().first);
+         s.order.pop_back();
+         evictions.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      s.order.emplace_front(key, std::move(value));
+      s.index.emplace(key, s.order.begin());
+   }
+
+   bool erase(K const& key) {
+      shard & s = shard_of(key);
+      std::lock_guard<std::mutex> guard{s.lock};
+
+      auto itr = s.index.find(key);
+      if(itr == s.index.end()) { return false; }
+
+      s.order.erase(itr->second);
+      s.index.erase(itr);
+      return true;
+   }
+
+   void clear() {
+      for(auto & s : shards) {
+         std::lock_guard<std::mutex> guard{s->lock};
+         s->order.clear();
+         s->index.clear();
+      }
+   }
+
+   std::size_t size() {
+      std::size_t total = 0;
+      for(auto & s : shards) {
+         std::lock_guard<std::mutex> guard{s->lock};
+         total += s->order.size();
+      }
+      return total;
+   }
+
+   std::size_t shard_count() const {
+      return shards.size();
+   }
+
+   // calls f(key, value) for at most max entries of shard idx,
+   // skipping the first offset from its most recently used end;
+   // f runs under the shard lock and must not call back into
+   // the map. returns the number of entries visited
+   //
+   template<typename F>
+   std::size_t visit(std::size_t const idx, std::size_t const offset, std::size_t const max, F && f) {
+      shard & s = *shards[idx % shards.size()];
+      std::lock_guard<std::mutex> guard{s.lock};
+
+      std::size_t visited = 0;
+      if(s.order.size() <= offset) { return visited; }
+
+      auto itr = std::next(s.order.begin(), static_cast<std::ptrdiff_t>(offset));
+      for(; itr != s.order.end() && visited < max; ++itr, ++visited) {
+         f(itr->first, itr->second);
+      }
+
+      return visited;
+   }
+
+private:
+
+   shard & shard_of(K const& key) {
+      // the high bits pick the shard, the low bits are
+      // left for the shard's own table
+      //
+      const std::size_t h = Hash{}(key);
+      return *shards[((h >> 32U) ^ (h >> 7U)) % shards.size()];
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
@@ -0,0 +1,2004 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_OPTIMIZE_HPP__
+#define __TT_EDSL_OPTIMIZE_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dsl.hpp"
+
+namespace tt { namespace dsl {
+
+// optional passes over a statement tree, run after it is
+// built and before it is emitted
+//
+//    std::vector<statement> stmts{ kernel_main[{ ... }] };
+//    simplify(stmts);
+//    hoist_inits(stmts);
+//    coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+//    pipeline_loops(ctx, stmts, 4UL);
+//    unroll_loops(stmts);
+//    kernel<crisc> kern{ctx, stmts};
+//
+// passes follow the tree, not the emitted text; emission does
+// not parenthesize by precedence, so subexpressions whose
+// grouping matters must already be wrapped in _( ) for the
+// source to mean what the tree does
+//
+
+// a literal operand as the emitted source reads it: integers
+// are bare decimals (int, or long when out of int range),
+// fp32 values are "{:f}f" text parsed as a float, fp64
+// values "{:f}" text parsed as a double, booleans are
+// true/false
+//
+struct folded_value {
+
+   enum class kind : std::uint8_t {
+      none,
+      integer,
+      floating,
+      boolean
+   };
+
+   kind k;
+   bool wide;           // fp64 operand or an integer outside int range
+   std::int64_t i;
+   double d;
+
+   folded_value() : k(kind::none), wide(false), i(0), d(0.0) {}
+
+   bool integral() const { return k == kind::integer || k == kind::boolean; }
+
+   bool is(std::int64_t const v) const {
+      return integral() ? (i == v) : (k == kind::floating && d == static_cast<double>(v));
+   }
+
+   double as_double() const { return integral() ? static_cast<double>(i) : d; }
+
+   float as_float() const { return integral() ? static_cast<float>(i) : static_cast<float>(d); }
+
+   // the usual arithmetic conversion rank of the literal's
+   // emitted type, see value_rank
+   //
+   std::size_t rank() const {
+      switch(k) {
+         case kind::boolean: return 1UL;
+         case kind::integer: return wide ? 3UL : 2UL;
+         case kind::floating: return wide ? 5UL : 4UL;
+         default: return 0UL;
+      }
+   }
+
+   template<typename T>
+   static T printed(T const v) {
+      const std::string text = fmt::format("{:f}", v);
+      if constexpr(std::is_same<T, float>::value) { return std::strtof(text.c_str(), nullptr); }
+      else { return std::strtod(text.c_str(), nullptr); }
+   }
+
+   static bool int_range(std::int64_t const v) {
+      return std::numeric_limits<std::int32_t>::min() <= v && v <= std::numeric_limits<std::int32_t>::max();
+   }
+
+   // fp16a and fp16b hold raw bits and are never folded
+   //
+   static bool of(expression_data const& e, folded_value & v) {
+      if(!holds_alternative<variable_type>(e.node)) { return false; }
+
+      return visit([&v](auto const& t) {
+         using T = typename std::decay<decltype(t)>::type;
+
+         if constexpr(std::is_same<T, literal<boolean>>::value) {
+            v.k = kind::boolean;
+            v.i = t.value ? 1 : 0;
+            return true;
+         }
+         else if constexpr(std::is_same<T, literal<fp32>>::value || std::is_same<T, literal<fp64>>::value) {
+            v.k = kind::floating;
+            v.wide = std::is_same<T, literal<fp64>>::value;
+            v.d = printed(t.value);
+            return true;
+         }
+         else if constexpr(is_literal_type<T>::type::value &&
+            !std::is_same<T, literal<fp16a>>::value && !std::is_same<T, literal<fp16b>>::value) {
+            using value_type = typename T::integral_value_type;
+
+            if constexpr(std::is_same<value_type, std::uint64_t>::value) {
+               if(static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) < t.value) { return false; }
+            }
+
+            v.k = kind::integer;
+            v.i = static_cast<std::int64_t>(t.value);
+            v.wide = !int_range(v.i);
+            return true;
+         }
+         else {
+            return false;
+         }
+      }, get<variable_type>(e.node));
+   }
+};
+
+// orders the types an operand can have in emitted source so
+// that a wider type never converts to a narrower one: bool
+// (1), int and narrower integers (2), 64 bit integers (3),
+// float (4), double (5); 0 is unknown, including fp16a and
+// fp16b, which hold raw bits
+//
+template<typename T>
+constexpr std::size_t value_rank() {
+   if constexpr(std::is_same<T, boolean>::value) { return 1UL; }
+   else if constexpr(std::is_same<T, fp32>::value) { return 4UL; }
+   else if constexpr(std::is_same<T, fp64>::value) { return 5UL; }
+   else if constexpr(std::is_same<T, fp16a>::value || std::is_same<T, fp16b>::value || std::is_same<T, none>::value) { return 0UL; }
+   else { return sizeof(typename T::value_type) < sizeof(std::int64_t) ? 2UL : 3UL; }
+}
+
+template<typename Op>
+using is_comparison_op_type = std::conditional<
+      std::is_same<Op, lt_op>::value ||
+      std::is_same<Op, lte_op>::value ||
+      std::is_same<Op, gt_op>::value ||
+      std::is_same<Op, gte_op>::value ||
+      std::is_same<Op, eq_op>::value ||
+      std::is_same<Op, neq_op>::value,
+      std::true_type,
+      std::false_type
+>;
+
+template<typename Op, typename T>
+bool compare(T const a, T const b) {
+   if constexpr(std::is_same<Op, lt_op>::value) { return a < b; }
+   else if constexpr(std::is_same<Op, lte_op>::value) { return a <= b; }
+   else if constexpr(std::is_same<Op, gt_op>::value) { return a > b; }
+   else if constexpr(std::is_same<Op, gte_op>::value) { return a >= b; }
+   else if constexpr(std::is_same<Op, eq_op>::value) { return a == b; }
+   else { return a != b; }
+}
+
+template<typename Op, typename T>
+T arithmetic(T const a, T const b) {
+   if constexpr(std::is_same<Op, add_op>::value) { return a + b; }
+   else if constexpr(std::is_same<Op, sub_op>::value) { return a - b; }
+   else if constexpr(std::is_same<Op, mul_op>::value) { return a * b; }
+   else { return a / b; }
+}
+
+// replaces e, `a Op b`, with one literal when the emitted source
+// would compute the same value; integer overflow, division
+// by zero and floating point results that do not survive
+// "{:f}" formatting are left alone. pow_op through tan_op
+// have no emitted form and are never folded
+//
+template<typename Op>
+bool fold_literals(folded_value const& a, folded_value const& b, expression_data & e) {
+   // floating point operands compute and compare in double
+   // when one is fp64, otherwise a float operand converts the
+   // other one to float, as the usual arithmetic conversions do
+   //
+   const bool wide = (a.k == folded_value::kind::floating && a.wide) || (b.k == folded_value::kind::floating && b.wide);
+
+   if constexpr(is_comparison_op_type<Op>::type::value) {
+      bool r = false;
+      if(a.integral() && b.integral()) { r = compare<Op>(a.i, b.i); }
+      else if(wide) { r = compare<Op>(a.as_double(), b.as_double()); }
+      else { r = compare<Op>(a.as_float(), b.as_float()); }
+
+      e.node.emplace<variable_type>(literal<boolean>{r});
+      return true;
+   }
+   else if constexpr(std::is_same<Op, logical_and_op>::value || std::is_same<Op, logical_or_op>::value) {
+      const bool lhs = a.as_double() != 0.0;
+      const bool rhs = b.as_double() != 0.0;
+      e.node.emplace<variable_type>(literal<boolean>{ std::is_same<Op, logical_and_op>::value ? (lhs && rhs) : (lhs || rhs) });
+      return true;
+   }
+   else if constexpr(std::is_same<Op, add_op>::value || std::is_same<Op, sub_op>::value ||
+      std::is_same<Op, mul_op>::value || std::is_same<Op, div_op>::value || std::is_same<Op, mod_op>::value ||
+      std::is_same<Op, bitwise_and_op>::value || std::is_same<Op, bitwise_or_op>::value || std::is_same<Op, xor_op>::value) {
+
+      if(a.integral() && b.integral()) {
+         std::int64_t r = 0;
+         bool ok = true;
+
+         if constexpr(std::is_same<Op, add_op>::value) { ok = !__builtin_add_overflow(a.i, b.i, &r); }
+         else if constexpr(std::is_same<Op, sub_op>::value) { ok = !__builtin_sub_overflow(a.i, b.i, &r); }
+         else if constexpr(std::is_same<Op, mul_op>::value) { ok = !__builtin_mul_overflow(a.i, b.i, &r); }
+         else if constexpr(std::is_same<Op, div_op>::value || std::is_same<Op, mod_op>::value) {
+            ok = b.i != 0 && !(a.i == std::numeric_limits<std::int64_t>::min() && b.i == -1);
+            if(ok) { r = std::is_same<Op, div_op>::value ? a.i / b.i : a.i % b.i; }
+         }
+         else if constexpr(std::is_same<Op, bitwise_and_op>::value) { r = a.i & b.i; }
+         else if constexpr(std::is_same<Op, bitwise_or_op>::value) { r = a.i | b.i; }
+         else { r = a.i ^ b.i; }
+
+         // int operands compute in int. a long operand makes
+         // the result long, and a long result in int range
+         // would be emitted, and computed on, as an int, so it
+         // is left alone
+         //
+         if(!ok || (!a.wide && !b.wide && !folded_value::int_range(r)) ||
+            ((a.wide || b.wide) && folded_value::int_range(r))) { return false; }
+
+         if(folded_value::int_range(r)) { e.node.emplace<variable_type>(literal<i32>{static_cast<std::int32_t>(r)}); }
+         else { e.node.emplace<variable_type>(literal<i64>{r}); }
+         return true;
+      }
+
+      if constexpr(std::is_same<Op, add_op>::value || std::is_same<Op, sub_op>::value ||
+         std::is_same<Op, mul_op>::value || std::is_same<Op, div_op>::value) {
+
+         if(wide) {
+            const double r = arithmetic<Op>(a.as_double(), b.as_double());
+            if(!std::isfinite(r) || folded_value::printed(r) != r) { return false; }
+            e.node.emplace<variable_type>(literal<fp64>{r});
+         }
+         else {
+            const float r = arithmetic<Op>(a.as_float(), b.as_float());
+            if(!std::isfinite(r) || folded_value::printed(r) != r) { return false; }
+            e.node.emplace<variable_type>(literal<fp32>{r});
+         }
+         return true;
+      }
+   }
+
+   return false;
+}
+
+struct SimplifyVisitor {
+
+   // rewrites a statement tree in place, bottom up:
+   //
+   //    literal Op literal      -> literal    (see fold_literals)
+   //    x + 0, 0 + x, x - 0     -> x          (0 no wider than x)
+   //    x * 1, 1 * x, x / 1     -> x          (1 no wider than x)
+   //    x * 0, 0 * x            -> 0          (x free of calls and assignments,
+   //                                           and no wider than 0)
+   //    ( ( x ) )               -> ( x )
+   //    ( atom )                -> atom       (variable, literal, call, index)
+   //    ( x )                   -> x          (a whole statement, assignment
+   //                                           right hand side, index, loop
+   //                                           or branch condition, argument)
+   //    x = x;                  -> removed    (x a scalar)
+   //
+   // x * 0 assumes finite values, as -ffinite-math-only does;
+   // an identity never changes the type of the expression it
+   // rewrites, ie: int x * 1.0 stays a float product
+   //
+
+   std::size_t rewrites;
+
+   SimplifyVisitor() : rewrites(0) {}
+
+   void statements(std::vector<statement> & stmts) {
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+      }
+
+      const std::size_t removed = static_cast<std::size_t>(std::count_if(stmts.begin(), stmts.end(), self_assignment));
+      if(removed == 0) { return; }
+
+      // statements are moved, never assigned; expression_data's
+      // operator= builds an assign_op
+      //
+      std::vector<statement> kept;
+      kept.reserve(stmts.size() - removed);
+      for(auto & stmt : stmts) {
+         if(!self_assignment(stmt)) {
+            kept.push_back(std::move(stmt));
+         }
+      }
+
+      stmts.swap(kept);
+      rewrites += removed;
+   }
+
+   void operator()(expression_data & t) {
+      whole(t);
+   }
+
+   void operator()(recursive_wrapper<for_> & t) {
+      whole(t.get().init_expr);
+      whole(t.get().cond_expr);
+      whole(t.get().incr_expr);
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<while_> & t) {
+      whole(t.get().cond_expr);
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<if_> & t) {
+      for(auto & branch : t.get().statements) {
+         whole(branch.first);
+         statements(branch.second);
+      }
+   }
+
+   void operator()(recursive_wrapper<switch_> & t) {
+      whole(t.get().variable);
+      for(auto & c : t.get().cases) {
+         whole(c.first);
+         statements(c.second);
+      }
+      statements(t.get().default_case);
+   }
+
+   void operator()(recursive_wrapper<function_def> & t) {
+      statements(t.get().statements);
+   }
+
+   template<typename T>
+   void operator()(T &) {
+   }
+
+   // an expression that is not an operand
+   //
+   void whole(expression_data & e) {
+      expression(e);
+
+      while(holds_alternative<paren_op>(e.node) &&
+         !holds_alternative<monostate>(get<paren_op>(e.node).node.get().node)) {
+         replace(e, get<paren_op>(e.node).node.get());
+      }
+   }
+
+   void expression(expression_data & e) {
+      visit([this, &e](auto & node) { this->rewrite(e, node); }, e.node);
+   }
+
+   static bool atom(expression_data const& e) {
+      return (holds_alternative<variable_type>(e.node) && !holds_alternative<monostate>(get<variable_type>(e.node))) ||
+         holds_alternative<recursive_wrapper<function_call>>(e.node) ||
+         holds_alternative<paren_op>(e.node) ||
+         holds_alternative<index_op>(e.node);
+   }
+
+   // `x = x` for a scalar x, ie: what `x = x * 1` simplifies to
+   //
+   static bool self_assignment(statement const& stmt) {
+      if(!holds_alternative<expression_data>(stmt) || !holds_alternative<assign_op>(get<expression_data>(stmt).node)) {
+         return false;
+      }
+
+      assign_op const& op = get<assign_op>(get<expression_data>(stmt).node);
+      expression_data const& lhs = op.args.first.get();
+      expression_data const& rhs = op.args.second.get();
+
+      if(!holds_alternative<variable_type>(lhs.node) || !holds_alternative<variable_type>(rhs.node)) {
+         return false;
+      }
+
+      variable_type const& x = get<variable_type>(lhs.node);
+      variable_type const& y = get<variable_type>(rhs.node);
+
+      return x.index() == y.index() && visit([&y](auto const& t) {
+         using T = typename std::decay<decltype(t)>::type;
+         if constexpr(is_scalar_type<T>::type::value) {
+            return !t.identity.empty() && t.identity == get<T>(y).identity;
+         }
+         else {
+            return false;
+         }
+      }, x);
+   }
+
+   // true when dropping e from the source changes nothing but its value
+   //
+   static bool pure(expression_data const& e) {
+      return visit([](auto const& node) {
+         using T = typename std::decay<decltype(node)>::type;
+
+         if constexpr(std::is_same<T, assign_op>::value || std::is_same<T, decl_expr>::value ||
+            std::is_same<T, recursive_wrapper<function_call>>::value) {
+            return false;
+         }
+         else if constexpr(is_binary_op_type<T>::type::value) {
+            return pure(node.args.first.get()) && pure(node.args.second.get());
+         }
+         else if constexpr(is_unary_op_type<T>::type::value) {
+            return pure(node.node.get());
+         }
+         else {
+            return true;
+         }
+      }, e.node);
+   }
+
+   // value_rank of the type e has in emitted source, 0 when
+   // it is not known
+   //
+   static std::size_t rank(expression_data const& e) {
+      folded_value f{};
+      if(folded_value::of(e, f)) { return f.rank(); }
+
+      return visit([](auto const& node) -> std::size_t {
+         using T = typename std::decay<decltype(node)>::type;
+
+         if constexpr(std::is_same<T, variable_type>::value) {
+            return visit([](auto const& v) -> std::size_t {
+               using V = typename std::decay<decltype(v)>::type;
+
+               if constexpr(is_scalar_type<V>::type::value) {
+                  return value_rank<typename V::value_type>();
+               }
+               else {
+                  return 0UL;
+               }
+            }, node);
+         }
+         else if constexpr(std::is_same<T, index_op>::value) {
+            expression_data const& base = node.args.first.get();
+            if(!holds_alternative<variable_type>(base.node)) { return 0UL; }
+
+            return visit([](auto const& v) -> std::size_t {
+               using V = typename std::decay<decltype(v)>::type;
+
+               if constexpr(is_array_type<V>::type::value || is_matrix_type<V>::type::value) {
+                  return value_rank<typename V::value_type>();
+               }
+               else {
+                  return 0UL;
+               }
+            }, get<variable_type>(base.node));
+         }
+         else if constexpr(std::is_same<T, assign_op>::value) {
+            return rank(node.args.first.get());
+         }
+         else if constexpr(is_comparison_op_type<T>::type::value || is_logical_op_type<T>::type::value) {
+            return 1UL;
+         }
+         else if constexpr(std::is_same<T, add_op>::value || std::is_same<T, sub_op>::value ||
+            std::is_same<T, mul_op>::value || std::is_same<T, div_op>::value || std::is_same<T, mod_op>::value ||
+            std::is_same<T, bitwise_and_op>::value || std::is_same<T, bitwise_or_op>::value || std::is_same<T, xor_op>::value) {
+            const std::size_t a = rank(node.args.first.get());
+            const std::size_t b = rank(node.args.second.get());
+            return (a == 0UL || b == 0UL) ? 0UL : std::max({a, b, 2UL});
+         }
+         else if constexpr(std::is_same<T, paren_op>::value) {
+            return rank(node.node.get());
+         }
+         else if constexpr(std::is_same<T, neg_op>::value) {
+            const std::size_t a = rank(node.node.get());
+            return a == 0UL ? 0UL : std::max(a, 2UL);
+         }
+         else {
+            return 0UL;
+         }
+      }, e.node);
+   }
+
+private:
+
+   // e becomes one of its own descendants; expression_type is
+   // not assignable (function_call holds a reference), nodes
+   // are replaced with emplace
+   //
+   void replace(expression_data & e, expression_data & descendant) {
+      expression_type node{std::move(descendant.node)};
+      visit([&e](auto & alt) {
+         using T = typename std::decay<decltype(alt)>::type;
+         e.node.template emplace<T>(std::move(alt));
+      }, node);
+      ++rewrites;
+   }
+
+   template<typename T>
+   void rewrite(expression_data & e, T & node) {
+      if constexpr(std::is_same<T, assign_op>::value || std::is_same<T, index_op>::value) {
+         expression(node.args.first.get());
+         whole(node.args.second.get());
+      }
+      else if constexpr(is_binary_op_type<T>::type::value) {
+         expression(node.args.first.get());
+         expression(node.args.second.get());
+         identities<T>(e, node);
+      }
+      else if constexpr(std::is_same<T, paren_op>::value) {
+         expression(node.node.get());
+         if(atom(node.node.get())) {
+            replace(e, node.node.get());
+         }
+      }
+      else if constexpr(is_unary_op_type<T>::type::value) {
+         expression(node.node.get());
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+         for(auto & arg : node.get().arguments) {
+            if(holds_alternative<expression_data>(arg)) {
+               whole(get<expression_data>(arg));
+            }
+         }
+      }
+   }
+
+   // `x Op v` has x's type, so x can stand in for it
+   //
+   static bool keeps(expression_data const& x, folded_value const& v) {
+      const std::size_t r = rank(x);
+      return r != 0UL && v.rank() <= r;
+   }
+
+   // `x * v` has v's type, so v can stand in for it
+   //
+   static bool absorbs(folded_value const& v, expression_data const& x) {
+      const std::size_t r = rank(x);
+      return r != 0UL && r <= v.rank();
+   }
+
+   template<typename Op>
+   void identities(expression_data & e, Op & node) {
+      expression_data & lhs = node.args.first.get();
+      expression_data & rhs = node.args.second.get();
+
+      folded_value a, b;
+      const bool lit_a = folded_value::of(lhs, a);
+      const bool lit_b = folded_value::of(rhs, b);
+
+      if(lit_a && lit_b) {
+         if(fold_literals<Op>(a, b, e)) {
+            ++rewrites;
+         }
+      }
+      else if constexpr(std::is_same<Op, add_op>::value) {
+         if(lit_b && b.is(0) && keeps(lhs, b)) { replace(e, lhs); }
+         else if(lit_a && a.is(0) && keeps(rhs, a)) { replace(e, rhs); }
+      }
+      else if constexpr(std::is_same<Op, sub_op>::value) {
+         if(lit_b && b.is(0) && keeps(lhs, b)) { replace(e, lhs); }
+      }
+      else if constexpr(std::is_same<Op, mul_op>::value) {
+         if(lit_b && b.is(1) && keeps(lhs, b)) { replace(e, lhs); }
+         else if(lit_a && a.is(1) && keeps(rhs, a)) { replace(e, rhs); }
+         else if(lit_b && b.is(0) && pure(lhs) && absorbs(b, lhs)) { replace(e, rhs); }
+         else if(lit_a && a.is(0) && pure(rhs) && absorbs(a, rhs)) { replace(e, lhs); }
+      }
+      else if constexpr(std::is_same<Op, div_op>::value) {
+         if(lit_b && b.is(1) && keeps(lhs, b)) { replace(e, lhs); }
+      }
+   }
+};
+
+// runs SimplifyVisitor over statements; returns the number
+// of nodes rewritten
+//
+inline std::size_t simplify(std::vector<statement> & statements) {
+   SimplifyVisitor simplifier{};
+   simplifier.statements(statements);
+   return simplifier.rewrites;
+}
+
+// whether word is one of ident's '_' separated words
+//
+inline bool ident_word(std::string_view const ident, std::string_view const word) {
+   for(std::size_t pos = 0; pos <= ident.size();) {
+      const std::size_t end = std::min(ident.find('_', pos), ident.size());
+      if(ident.substr(pos, end - pos) == word) { return true; }
+      pos = end + 1UL;
+   }
+   return false;
+}
+
+// a call whose identifier names an api init (copy_tile_init,
+// mm_init_short, binary_op_init_common, exp_tile_init, ...)
+// or uninit (tilize_uninit, ...); inits configure unpack,
+// math and pack state, which later tile calls depend on.
+// "init" must be a whole word of the name, so isfinite_tile
+// is not an init
+//
+inline bool init_ident(std::string_view const ident) {
+   return ident_word(ident, "init");
+}
+
+inline bool uninit_ident(std::string_view const ident) {
+   return ident_word(ident, "uninit");
+}
+
+// the init a statement calls, when the statement is nothing but
+// that call ( `exp_tile_init();` ), or nullptr
+//
+inline function_call const* init_statement(statement const& stmt) {
+   if(!holds_alternative<expression_data>(stmt) ||
+      !holds_alternative<recursive_wrapper<function_call>>(get<expression_data>(stmt).node)) {
+      return nullptr;
+   }
+
+   function_call const& call = get<recursive_wrapper<function_call>>(get<expression_data>(stmt).node).get();
+   const std::string_view ident{call.fdecl.ident};
+
+   return init_ident(ident) ? &call : nullptr;
+}
+
+// passes treat equal fingerprints as equal statements, so the
+// digest is sha256
+//
+inline content_hash statement_fingerprint(statement const& stmt) {
+   sha256 digest{};
+   FingerprintVisitor fp{digest};
+   fp(stmt);
+   return digest.finalize();
+}
+
+struct EffectsVisitor {
+
+   // what a statement tree may do, as far as moving a call
+   // across it is concerned; the calls it makes, how many of
+   // them are inits or uninits, and the symbol ids of the
+   // variables it writes (assigns or declares) and mentions
+   //
+
+   std::size_t calls;
+   std::size_t inits;
+   std::vector<std::string_view> callees;
+   std::vector<std::uint32_t> assigned;
+   std::vector<std::uint32_t> used;
+
+   EffectsVisitor() : calls(0), inits(0), callees(), assigned(), used() {}
+
+   void statements(std::vector<statement> const& stmts) {
+      for(auto const& stmt : stmts) {
+         visit(*this, stmt);
+      }
+   }
+
+   void operator()(expression_data const& t) {
+      visit(*this, t.node);
+   }
+
+   void operator()(variable_type const& t) {
+      const std::uint32_t id = identity(t);
+      if(id != 0) { used.push_back(id); }
+   }
+
+   template<typename T>
+   void operator()(T const& t) {
+      if constexpr(std::is_same<T, assign_op>::value) {
+         write(t.args.first.get());
+         (*this)(t.args.first.get());
+         (*this)(t.args.second.get());
+      }
+      else if constexpr(is_binary_op_type<T>::type::value) {
+         (*this)(t.args.first.get());
+         (*this)(t.args.second.get());
+      }
+      else if constexpr(is_unary_op_type<T>::type::value) {
+         (*this)(t.node.get());
+      }
+      else if constexpr(std::is_same<T, decl_expr>::value) {
+         write(t.var.get());
+         (*this)(t.var.get());
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+         ++calls;
+         inits += (init_ident(t.get().fdecl.ident) || uninit_ident(t.get().fdecl.ident)) ? 1UL : 0UL;
+         callees.emplace_back(t.get().fdecl.ident);
+         statements(t.get().arguments);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<for_>>::value) {
+         (*this)(t.get().init_expr);
+         (*this)(t.get().cond_expr);
+         (*this)(t.get().incr_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<while_>>::value) {
+         (*this)(t.get().cond_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<if_>>::value) {
+         for(auto const& branch : t.get().statements) {
+            (*this)(branch.first);
+            statements(branch.second);
+         }
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<switch_>>::value) {
+         (*this)(t.get().variable);
+         for(auto const& c : t.get().cases) {
+            (*this)(c.first);
+            statements(c.second);
+         }
+         statements(t.get().default_case);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_def>>::value) {
+         statements(t.get().statements);
+      }
+   }
+
+   bool writes_any(std::vector<std::uint32_t> const& ids) const {
+      return std::any_of(ids.begin(), ids.end(), [this](std::uint32_t const id) {
+         return std::find(assigned.begin(), assigned.end(), id) != assigned.end();
+      });
+   }
+
+   static std::uint32_t identity(variable_type const& t) {
+      return visit([](auto const& v) -> std::uint32_t {
+         using V = typename std::decay<decltype(v)>::type;
+         if constexpr(is_scalar_type<V>::type::value || is_pointer_type<V>::type::value ||
+            is_reference_type<V>::type::value || is_array_type<V>::type::value || is_matrix_type<V>::type::value) {
+            return v.identity.id();
+         }
+         else {
+            return 0U;
+         }
+      }, t);
+   }
+
+private:
+
+   // the variable an assignment target names; `x`, `x[i]`, `x[i][j]`
+   //
+   void write(expression_data const& e) {
+      if(holds_alternative<variable_type>(e.node)) {
+         const std::uint32_t id = identity(get<variable_type>(e.node));
+         if(id != 0) { assigned.push_back(id); }
+      }
+      else if(holds_alternative<index_op>(e.node)) {
+         write(get<index_op>(e.node).args.first.get());
+      }
+      else if(holds_alternative<paren_op>(e.node)) {
+         write(get<paren_op>(e.node).node.get());
+      }
+   }
+};
+
+// a for_ header that counts a scalar integer variable from a
+// literal start by a literal step to a literal bound;
+//
+//    i = s  or  decl(i) = s
+//    i < b, i <= b, i > b, i >= b  or  i != b
+//    i = i + d, i = d + i  or  i = i - d
+//
+// every value i takes, and b, fit i's type
+//
+struct induction {
+
+   expression_data var;
+   expression_data * storage;    // the variable decl(i) refers to, when the loop declares i
+   std::uint32_t id;
+   std::int64_t start;
+   std::int64_t step;
+   std::int64_t trips;
+
+   induction() : var(), storage(nullptr), id(0), start(0), step(0), trips(0) {}
+
+   std::int64_t at(std::int64_t const k) const {
+      return start + k * step;
+   }
+
+   // a literal of i's type
+   //
+   expression_data constant(std::int64_t const v) const {
+      return visit([v](auto const& t) {
+         using V = typename std::decay<decltype(t)>::type;
+         expression_data e{};
+         if constexpr(is_scalar_type<V>::type::value) {
+            using L = typename V::value_type;
+            e.node.template emplace<variable_type>(literal<L>{static_cast<typename L::value_type>(v)});
+         }
+         return e;
+      }, get<variable_type>(var.node));
+   }
+
+   // i + k * step, as the body reads it on the k'th copy
+   //
+   expression_data offset(std::int64_t const k) const {
+      expression_data x{var};
+      return (0 < step) ? _(x + constant(k * step)) : _(x - constant(-k * step));
+   }
+
+   static bool of(for_ const& loop, induction & ind) {
+      if(!holds_alternative<assign_op>(loop.init_expr.node)) { return false; }
+
+      assign_op const& init = get<assign_op>(loop.init_expr.node);
+      expression_data const& lhs = init.args.first.get();
+      expression_data * storage = holds_alternative<decl_expr>(lhs.node) ? &get<decl_expr>(lhs.node).var.get() : nullptr;
+      expression_data const& target = (storage != nullptr) ? *storage : lhs;
+
+      std::int64_t lo = 0, hi = 0;
+      if(!holds_alternative<variable_type>(target.node) || !range(get<variable_type>(target.node), lo, hi)) { return false; }
+
+      const std::uint32_t id = EffectsVisitor::identity(get<variable_type>(target.node));
+
+      std::int64_t start = 0, bound = 0, step = 0;
+      if(id == 0 || !literal_of(init.args.second.get(), start) || !increment(loop.incr_expr, id, step) ||
+         step == 0 || step == std::numeric_limits<std::int64_t>::min()) {
+         return false;
+      }
+
+      std::int64_t span = 0;
+      std::int64_t trips = 0;
+
+      if(compared<lt_op>(loop.cond_expr, id, bound) || compared<lte_op>(loop.cond_expr, id, bound)) {
+         if(step < 0 || __builtin_sub_overflow(bound, start, &span)) { return false; }
+         if(compared<lte_op>(loop.cond_expr, id, bound)) { trips = (span < 0) ? 0 : span / step + 1; }
+         else { trips = (span <= 0) ? 0 : (span - 1) / step + 1; }
+      }
+      else if(compared<gt_op>(loop.cond_expr, id, bound) || compared<gte_op>(loop.cond_expr, id, bound)) {
+         if(0 < step || __builtin_sub_overflow(start, bound, &span)) { return false; }
+         if(compared<gte_op>(loop.cond_expr, id, bound)) { trips = (span < 0) ? 0 : span / -step + 1; }
+         else { trips = (span <= 0) ? 0 : (span - 1) / -step + 1; }
+      }
+      else if(compared<neq_op>(loop.cond_expr, id, bound)) {
+         if(__builtin_sub_overflow(bound, start, &span) || span % step != 0 || span / step < 0) { return false; }
+         trips = span / step;
+      }
+      else {
+         return false;
+      }
+
+      std::int64_t travel = 0, exit = 0;
+      if(__builtin_mul_overflow(trips, step, &travel) || __builtin_add_overflow(start, travel, &exit) ||
+         start < lo || hi < start || bound < lo || hi < bound || exit < lo || hi < exit) {
+         return false;
+      }
+
+      ind.var.node.template emplace<variable_type>(get<variable_type>(target.node));
+      ind.storage = storage;
+      ind.id = id;
+      ind.start = start;
+      ind.step = step;
+      ind.trips = trips;
+      return true;
+   }
+
+private:
+
+   // the values of a scalar integer type, clamped to int64
+   //
+   static bool range(variable_type const& v, std::int64_t & lo, std::int64_t & hi) {
+      return visit([&lo, &hi](auto const& t) {
+         using V = typename std::decay<decltype(t)>::type;
+         if constexpr(is_scalar_type<V>::type::value) {
+            using I = typename V::value_type::value_type;
+            if constexpr(std::is_integral<I>::value && !std::is_same<I, bool>::value) {
+               lo = static_cast<std::int64_t>(std::numeric_limits<I>::min());
+               hi = (static_cast<std::uint64_t>(std::numeric_limits<I>::max()) < static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) ?
+                  static_cast<std::int64_t>(std::numeric_limits<I>::max()) : std::numeric_limits<std::int64_t>::max();
+               return true;
+            }
+         }
+         return false;
+      }, v);
+   }
+
+   static bool literal_of(expression_data const& e, std::int64_t & value) {
+      folded_value v;
+      if(!folded_value::of(e, v) || v.k != folded_value::kind::integer) { return false; }
+      value = v.i;
+      return true;
+   }
+
+   static bool names(expression_data const& e, std::uint32_t const id) {
+      return holds_alternative<variable_type>(e.node) && EffectsVisitor::identity(get<variable_type>(e.node)) == id;
+   }
+
+   template<typename Op>
+   static bool compared(expression_data const& cond, std::uint32_t const id, std::int64_t & bound) {
+      if(!holds_alternative<Op>(cond.node)) { return false; }
+
+      Op const& op = get<Op>(cond.node);
+      return names(op.args.first.get(), id) && literal_of(op.args.second.get(), bound);
+   }
+
+   static bool increment(expression_data const& incr, std::uint32_t const id, std::int64_t & step) {
+      if(!holds_alternative<assign_op>(incr.node) || !names(get<assign_op>(incr.node).args.first.get(), id)) { return false; }
+
+      expression_data const& rhs = get<assign_op>(incr.node).args.second.get();
+
+      if(holds_alternative<add_op>(rhs.node)) {
+         add_op const& op = get<add_op>(rhs.node);
+         return (names(op.args.first.get(), id) && literal_of(op.args.second.get(), step)) ||
+            (names(op.args.second.get(), id) && literal_of(op.args.first.get(), step));
+      }
+
+      if(holds_alternative<sub_op>(rhs.node)) {
+         sub_op const& op = get<sub_op>(rhs.node);
+         if(names(op.args.first.get(), id) && literal_of(op.args.second.get(), step) && step != std::numeric_limits<std::int64_t>::min()) {
+            step = -step;
+            return true;
+         }
+      }
+
+      return false;
+   }
+};
+
+struct HoistVisitor {
+
+   // moves loop invariant init calls ahead of for_ loops,
+   // innermost loops first, then drops inits that repeat the
+   // init directly before them
+   //
+   // a loop's init is hoisted when the loop's header is an
+   // induction with at least one trip, every init in its body
+   // is a top level statement and all are the same call,
+   // nothing before the first one makes a call, and its
+   // arguments make no calls and read nothing the loop writes.
+   // a loop that may run zero times (a runtime bound, or any
+   // while_) keeps its init, since hoisting it would run the
+   // init where the source never did. an init is redundant
+   // when the last init before it (in the same statement list)
+   // is the same call, no other init or uninit ran in
+   // between, and nothing in between wrote a variable its
+   // arguments read
+   //
+   // calls are matched by name (see init_ident); other calls
+   // are assumed to leave init state alone
+   //
+
+   std::size_t moved;
+
+   HoistVisitor() : moved(0) {}
+
+   void statements(std::vector<statement> & stmts) {
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+      }
+
+      std::vector<statement> hoisted;
+      hoisted.reserve(stmts.size());
+
+      for(auto & stmt : stmts) {
+         std::optional<statement> init;
+
+         induction ind;
+         if(holds_alternative<recursive_wrapper<for_>>(stmt) &&
+            induction::of(get<recursive_wrapper<for_>>(stmt).get(), ind) && 0 < ind.trips) {
+            for_ & loop = get<recursive_wrapper<for_>>(stmt).get();
+            EffectsVisitor header{};
+            header(loop.init_expr);
+            header(loop.cond_expr);
+            header(loop.incr_expr);
+            init = invariant_init(header, loop.statements);
+         }
+
+         if(init) {
+            hoisted.push_back(std::move(*init));
+         }
+         hoisted.push_back(std::move(stmt));
+      }
+
+      std::vector<statement> kept;
+      kept.reserve(hoisted.size());
+
+      // last_args holds the variables the last init reads; the
+      // same call after one of them is written configures
+      // different state and is kept
+      //
+      std::optional<content_hash> last;
+      EffectsVisitor last_args{};
+      for(auto & stmt : hoisted) {
+         function_call const* call = init_statement(stmt);
+         if(call != nullptr) {
+            const content_hash fp = statement_fingerprint(stmt);
+            if(last && *last == fp) {
+               ++moved;
+               continue;
+            }
+            last = fp;
+            last_args = EffectsVisitor{};
+            last_args.statements(call->arguments);
+         }
+         else {
+            EffectsVisitor fx{};
+            visit(fx, stmt);
+            if(0 < fx.inits || fx.writes_any(last_args.used)) { last.reset(); }
+         }
+
+         kept.push_back(std::move(stmt));
+      }
+
+      stmts.swap(kept);
+   }
+
+   void operator()(recursive_wrapper<for_> & t) {
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<while_> & t) {
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<if_> & t) {
+      for(auto & branch : t.get().statements) {
+         statements(branch.second);
+      }
+   }
+
+   void operator()(recursive_wrapper<switch_> & t) {
+      for(auto & c : t.get().cases) {
+         statements(c.second);
+      }
+      statements(t.get().default_case);
+   }
+
+   void operator()(recursive_wrapper<function_def> & t) {
+      statements(t.get().statements);
+   }
+
+   template<typename T>
+   void operator()(T &) {
+   }
+
+private:
+
+   // removes the body's init and returns it, or returns nothing
+   // and leaves the body as it is
+   //
+   std::optional<statement> invariant_init(EffectsVisitor & loop, std::vector<statement> & body) {
+      statement const* first = nullptr;
+      content_hash fp{};
+      std::size_t count = 0;
+
+      for(auto const& stmt : body) {
+         if(init_statement(stmt) != nullptr) {
+            if(first == nullptr) {
+               first = &stmt;
+               fp = statement_fingerprint(stmt);
+            }
+            else if(statement_fingerprint(stmt) != fp) {
+               return std::nullopt;
+            }
+            ++count;
+            continue;
+         }
+
+         EffectsVisitor fx{};
+         visit(fx, stmt);
+         if(0 < fx.inits || (first == nullptr && 0 < fx.calls)) {
+            return std::nullopt;
+         }
+      }
+
+      if(first == nullptr) { return std::nullopt; }
+
+      EffectsVisitor args{};
+      args.statements(init_statement(*first)->arguments);
+      loop.statements(body);
+
+      if(0 < args.calls || loop.writes_any(args.used)) { return std::nullopt; }
+
+      std::optional<statement> init{*first};
+
+      std::vector<statement> kept;
+      kept.reserve(body.size() - count);
+      for(auto & stmt : body) {
+         if(init_statement(stmt) == nullptr) {
+            kept.push_back(std::move(stmt));
+         }
+      }
+
+      body.swap(kept);
+      moved += count;
+      return init;
+   }
+};
+
+// runs HoistVisitor over statements; returns the number of
+// init calls taken out of loop bodies or dropped as repeats
+//
+inline std::size_t hoist_inits(std::vector<statement> & statements) {
+   HoistVisitor hoister{};
+   hoister.statements(statements);
+   return hoister.moved;
+}
+
+// barrier coalescing settings for one kernel
+//
+struct barrier_batching {
+   std::size_t depth;      // most noc issues one barrier waits for
+   std::size_t cb_pages;   // pages in the circular buffer a loop moves blocks through
+
+   barrier_batching() : depth(1UL), cb_pages(0UL) {}
+
+   barrier_batching(std::size_t const d, std::size_t const pages) : depth(d), cb_pages(pages) {}
+};
+
+// the calls that move one block through a circular buffer, in
+// either direction, and which issue argument is the L1 address
+//
+struct noc_transfer {
+   char const* acquire;
+   char const* pointer;
+   char const* issue;
+   char const* barrier;
+   char const* release;
+   std::size_t l1_arg;
+};
+
+constexpr static inline noc_transfer noc_reads{
+   "cb_reserve_back", "get_write_ptr", "noc_async_read", "noc_async_read_barrier", "cb_push_back", 1UL
+};
+
+constexpr static inline noc_transfer noc_writes{
+   "cb_wait_front", "get_read_ptr", "noc_async_write", "noc_async_write_barrier", "cb_pop_front", 0UL
+};
+
+// a loop body that moves one block per iteration through a
+// circular buffer, as found by match;
+//
+//    cb_reserve_back(cb, n);            cb_wait_front(cb, n);
+//    l1 = get_write_ptr(cb);            l1 = get_read_ptr(cb);
+//    noc_async_read(src, l1, bytes);    noc_async_write(l1, dst, bytes);
+//    noc_async_read_barrier();          noc_async_write_barrier();
+//    cb_push_back(cb, n);               cb_pop_front(cb, n);
+//
+// with any statements before the reserve (wait), between it
+// and the issue, and after the push (pop). n is a literal or
+// a variable last set to one before the loop; cb, n and bytes
+// are loop invariant; bytes is get_tile_size(cb) * n (see
+// block_bytes); the loop makes no other noc_ or cb_ call
+//
+struct dataflow_loop {
+
+   noc_transfer const* xfer;
+   std::size_t acquire;          // body indices; the barrier and release follow the issue
+   std::size_t issue;
+   std::size_t pointer;          // `l1 = get_write_ptr(cb)`, or the body size when the issue reads it
+   expression_data const* cb;
+   expression_data const* n;
+   expression_data const* l1;
+   expression_data const* bytes;
+   std::size_t pages;            // n, resolved
+
+   dataflow_loop() : xfer(nullptr), acquire(0), issue(0), pointer(0), cb(nullptr), n(nullptr), l1(nullptr), bytes(nullptr), pages(0) {}
+
+   constexpr static inline char const* tile_size = "get_tile_size";
+
+   // loop holds the effects of the loop header; the body's are added
+   //
+   static bool match(std::vector<statement> const& scope, EffectsVisitor & loop, std::vector<statement> const& body, dataflow_loop & m) {
+      loop.statements(body);
+
+      const std::size_t dataflow = std::count_if(loop.callees.begin(), loop.callees.end(), [](std::string_view const ident) {
+         return ident.rfind("noc_", 0) == 0 || ident.rfind("cb_", 0) == 0;
+      });
+
+      return dataflow == 4UL && (match(scope, loop, body, noc_reads, m) || match(scope, loop, body, noc_writes, m));
+   }
+
+   function_call const& call_at(std::vector<statement> const& body, std::size_t const index) const {
+      return get<recursive_wrapper<function_call>>(get<expression_data>(body[index]).node).get();
+   }
+
+   static function_call const* call(statement const& stmt, std::string_view const ident) {
+      if(!holds_alternative<expression_data>(stmt)) { return nullptr; }
+      return call(get<expression_data>(stmt), ident);
+   }
+
+   static function_call const* call(expression_data const& e, std::string_view const ident) {
+      if(!holds_alternative<recursive_wrapper<function_call>>(e.node)) { return nullptr; }
+
+      function_call const& c = get<recursive_wrapper<function_call>>(e.node).get();
+      return (std::string_view{c.fdecl.ident} == ident) ? &c : nullptr;
+   }
+
+   static expression_data const* argument(function_call const& c, std::size_t const index) {
+      if(c.arguments.size() <= index || !holds_alternative<expression_data>(c.arguments[index])) { return nullptr; }
+      return &get<expression_data>(c.arguments[index]);
+   }
+
+   static bool same(expression_data const& a, expression_data const& b) {
+      return statement_fingerprint(statement{a}) == statement_fingerprint(statement{b});
+   }
+
+   static expression_data operand(expression_data const& e) {
+      return SimplifyVisitor::atom(e) ? expression_data{e} : _(expression_data{e});
+   }
+
+   // c with its index'th argument replaced
+   //
+   static expression_data with_argument(function_call const& c, std::size_t const index, expression_data arg) {
+      function_call rebuilt{c.fdecl, c.arguments};
+      rebuilt.arguments[index].template emplace<expression_data>(std::move(arg));
+      return expression_data{recursive_wrapper<function_call>{std::move(rebuilt)}};
+   }
+
+   // get_tile_size only reads the circular buffer's config, the
+   // one call an invariant may make
+   //
+   static bool invariant(expression_data const& e, EffectsVisitor const& loop) {
+      EffectsVisitor fx{};
+      fx(e);
+      const std::size_t tile_sizes = static_cast<std::size_t>(std::count(fx.callees.begin(), fx.callees.end(), std::string_view{tile_size}));
+      return fx.calls == tile_sizes && !loop.writes_any(fx.used);
+   }
+
+   // the right hand side of the last assignment to the variable
+   // e in scope, when the loop does not write e and nothing
+   // after that assignment does; nullptr otherwise
+   //
+   static expression_data const* definition(expression_data const& e, std::vector<statement> const& scope, EffectsVisitor const& loop) {
+      if(!holds_alternative<variable_type>(e.node)) { return nullptr; }
+
+      const std::uint32_t id = EffectsVisitor::identity(get<variable_type>(e.node));
+      if(id == 0 || loop.writes_any({id})) { return nullptr; }
+
+      for(auto itr = scope.rbegin(); itr != scope.rend(); ++itr) {
+         if(holds_alternative<expression_data>(*itr) && holds_alternative<assign_op>(get<expression_data>(*itr).node)) {
+            assign_op const& op = get<assign_op>(get<expression_data>(*itr).node);
+            expression_data const& lhs = op.args.first.get();
+            expression_data const& target = holds_alternative<decl_expr>(lhs.node) ? get<decl_expr>(lhs.node).var.get() : lhs;
+
+            if(holds_alternative<variable_type>(target.node) && EffectsVisitor::identity(get<variable_type>(target.node)) == id) {
+               return &op.args.second.get();
+            }
+         }
+
+         EffectsVisitor fx{};
+         visit(fx, *itr);
+         if(fx.writes_any({id})) { return nullptr; }
+      }
+
+      return nullptr;
+   }
+
+   // the value of the literal e, or of the literal the variable
+   // e was last set to before the loop
+   //
+   static bool resolve(expression_data const& e, std::vector<statement> const& scope, EffectsVisitor const& loop, std::int64_t & value) {
+      folded_value v;
+      expression_data const* def = folded_value::of(e, v) ? &e : definition(e, scope, loop);
+
+      if(def == nullptr || !folded_value::of(*def, v) || v.k != folded_value::kind::integer) { return false; }
+
+      value = v.i;
+      return true;
+   }
+
+   static expression_data const& unparen(expression_data const& e) {
+      return holds_alternative<paren_op>(e.node) ? unparen(get<paren_op>(e.node).node.get()) : e;
+   }
+
+   // e, or the expression the variable e was last set to before
+   // the loop
+   //
+   static expression_data const& defined(expression_data const& e, std::vector<statement> const& scope, EffectsVisitor const& loop) {
+      expression_data const& x = unparen(e);
+      expression_data const* def = definition(x, scope, loop);
+      return (def == nullptr) ? x : unparen(*def);
+   }
+
+   // bytes is the size of the n pages of cb the issue moves:
+   // `get_tile_size(cb) * n`, in either order, or
+   // `get_tile_size(cb)` when n is 1; the operands may be
+   // variables last set to these before the loop. the rewrites
+   // offset the L1 address by bytes per block, anything else
+   // could overrun the pages reserved (waited on)
+   //
+   static bool block_bytes(expression_data const& bytes, expression_data const& cb, expression_data const& n,
+      std::int64_t const pages, std::vector<statement> const& scope, EffectsVisitor const& loop) {
+
+      auto const tile_size_of = [&](expression_data const& e) {
+         function_call const* c = call(defined(e, scope, loop), tile_size);
+         return c != nullptr && c->arguments.size() == 1UL && argument(*c, 0UL) != nullptr && same(*argument(*c, 0UL), cb);
+      };
+
+      auto const pages_of = [&](expression_data const& e) {
+         std::int64_t value = 0;
+         return same(unparen(e), unparen(n)) || (resolve(unparen(e), scope, loop, value) && value == pages);
+      };
+
+      expression_data const& e = defined(bytes, scope, loop);
+      if(tile_size_of(e)) { return pages == 1; }
+      if(!holds_alternative<mul_op>(e.node)) { return false; }
+
+      mul_op const& op = get<mul_op>(e.node);
+      expression_data const& a = op.args.first.get();
+      expression_data const& b = op.args.second.get();
+
+      return (tile_size_of(a) && pages_of(b)) || (tile_size_of(b) && pages_of(a));
+   }
+
+private:
+
+   static bool match(std::vector<statement> const& scope, EffectsVisitor const& loop, std::vector<statement> const& body,
+      noc_transfer const& xfer, dataflow_loop & m) {
+
+      const std::size_t none = body.size();
+      std::size_t acquire = none, issue = none;
+
+      for(std::size_t i = 0; i < body.size(); ++i) {
+         if(call(body[i], xfer.acquire) != nullptr) { acquire = i; }
+         else if(call(body[i], xfer.issue) != nullptr) { issue = i; }
+      }
+
+      if(acquire == none || issue == none || !(acquire < issue) || body.size() <= issue + 2UL ||
+         call(body[issue + 1UL], xfer.barrier) == nullptr || call(body[issue + 2UL], xfer.release) == nullptr) {
+         return false;
+      }
+
+      function_call const& acq = *call(body[acquire], xfer.acquire);
+      function_call const& iss = *call(body[issue], xfer.issue);
+      function_call const& rel = *call(body[issue + 2UL], xfer.release);
+
+      expression_data const* cb = argument(acq, 0UL);
+      expression_data const* n = argument(acq, 1UL);
+      expression_data const* l1 = argument(iss, xfer.l1_arg);
+      expression_data const* bytes = argument(iss, 2UL);
+
+      if(cb == nullptr || n == nullptr || l1 == nullptr || bytes == nullptr || acq.arguments.size() != 2UL ||
+         rel.arguments.size() != 2UL || argument(rel, 0UL) == nullptr || argument(rel, 1UL) == nullptr ||
+         !same(*cb, *argument(rel, 0UL)) || !same(*n, *argument(rel, 1UL))) {
+         return false;
+      }
+
+      std::int64_t pages = 0;
+      if(!invariant(*cb, loop) || !invariant(*n, loop) || !invariant(*bytes, loop) ||
+         !resolve(*n, scope, loop, pages) || pages <= 0 || !block_bytes(*bytes, *cb, *n, pages, scope, loop)) {
+         return false;
+      }
+
+      const std::size_t pointer = buffer_pointer(*l1, *cb, xfer, body, acquire, issue, loop);
+      if(pointer == 0UL) { return false; }
+
+      m.xfer = &xfer;
+      m.acquire = acquire;
+      m.issue = issue;
+      m.pointer = pointer;
+      m.cb = cb;
+      m.n = n;
+      m.l1 = l1;
+      m.bytes = bytes;
+      m.pages = static_cast<std::size_t>(pages);
+      return true;
+   }
+
+   // the l1 argument is the circular buffer pointer, read in the
+   // issue (body size is returned) or assigned, only, between
+   // acquire and issue (its index is returned); 0 otherwise
+   //
+   static std::size_t buffer_pointer(expression_data const& l1, expression_data const& cb, noc_transfer const& xfer,
+      std::vector<statement> const& body, std::size_t const acquire, std::size_t const issue, EffectsVisitor const& loop) {
+
+      auto const pointer_of = [&cb, &xfer](expression_data const& e) {
+         function_call const* c = call(e, xfer.pointer);
+         return c != nullptr && c->arguments.size() == 1UL && argument(*c, 0UL) != nullptr && same(*argument(*c, 0UL), cb);
+      };
+
+      if(pointer_of(l1)) { return body.size(); }
+      if(!holds_alternative<variable_type>(l1.node)) { return 0UL; }
+
+      const std::uint32_t id = EffectsVisitor::identity(get<variable_type>(l1.node));
+      if(id == 0 || std::count(loop.assigned.begin(), loop.assigned.end(), id) != 1) { return 0UL; }
+
+      for(std::size_t i = acquire + 1UL; i < issue; ++i) {
+         if(!holds_alternative<expression_data>(body[i]) || !holds_alternative<assign_op>(get<expression_data>(body[i]).node)) { continue; }
+
+         assign_op const& op = get<assign_op>(get<expression_data>(body[i]).node);
+         expression_data const& lhs = op.args.first.get();
+         if(holds_alternative<variable_type>(lhs.node) && EffectsVisitor::identity(get<variable_type>(lhs.node)) == id) {
+            return pointer_of(op.args.second.get()) ? i : 0UL;
+         }
+      }
+
+      return 0UL;
+   }
+};
+
+template<typename T>
+struct CoalesceVisitor {
+
+   // rewrites dataflow_loop loops so that one barrier waits on
+   // K issues;
+   //
+   //    cb_reserve_back(cb, ( batch + 1 ) * n);
+   //    l1 = get_write_ptr(cb);
+   //    noc_async_read(src, ( l1 + batch * bytes ), bytes);
+   //    batch = batch + 1;
+   //    if(batch == K) { noc_async_read_barrier(); cb_push_back(cb, n * K); batch = 0; }
+   //
+   // followed, after the loop, by a barrier and push of the last
+   // partial batch. the pointer only moves on push (pop) and
+   // reserve (wait) counts pages from it, so the K blocks land
+   // back to back and a growing request never asks for pages
+   // the other side will not free (or produce)
+   //
+   // K is the largest value up to depth for which K * n pages
+   // divide the circular buffer. no batch wraps around its end
+   // when the pointer starts a multiple of K * n pages from the
+   // base, so only loops that run once, on a buffer whose
+   // pointer has not moved, are rewritten: loops in the body of
+   // kernel_main, or in the branches of its if_ and switch_
+   // statements, that no push (pop) in the same direction runs
+   // before. loops nested in loops are left alone; the flush of
+   // a partial batch leaves the pointer unaligned for the next
+   // run. so are the bodies of other functions, which may be
+   // called any number of times, from anywhere
+   //
+
+   kernel_context<T> & ctx;
+   barrier_batching config;
+   std::size_t loops;
+
+   CoalesceVisitor(kernel_context<T> & c, barrier_batching const& cfg) : ctx(c), config(cfg), loops(0) {}
+
+   void statements(std::vector<statement> & stmts) {
+      bool reads = true, writes = true;
+      statements(stmts, reads, writes);
+   }
+
+   void operator()(recursive_wrapper<function_def> & t) {
+      if(t.get().fdecl.ident == kernel_main_decl.ident) {
+         statements(t.get().statements);
+      }
+   }
+
+   template<typename U>
+   void operator()(U &) {
+   }
+
+private:
+
+   // reads (writes) is whether the write (read) pointer is still
+   // at the buffer's base
+   //
+   void statements(std::vector<statement> & stmts, bool & reads, bool & writes) {
+      std::vector<statement> rebuilt;
+      rebuilt.reserve(stmts.size());
+
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+
+         std::optional<statement> flush;
+
+         if(holds_alternative<recursive_wrapper<for_>>(stmt)) {
+            for_ & loop = get<recursive_wrapper<for_>>(stmt).get();
+            EffectsVisitor header{};
+            header(loop.init_expr);
+            header(loop.cond_expr);
+            header(loop.incr_expr);
+            flush = coalesce(rebuilt, header, loop.statements, reads, writes);
+         }
+         else if(holds_alternative<recursive_wrapper<while_>>(stmt)) {
+            while_ & loop = get<recursive_wrapper<while_>>(stmt).get();
+            EffectsVisitor header{};
+            header(loop.cond_expr);
+            flush = coalesce(rebuilt, header, loop.statements, reads, writes);
+         }
+         else if(holds_alternative<recursive_wrapper<if_>>(stmt)) {
+            for(auto & branch : get<recursive_wrapper<if_>>(stmt).get().statements) {
+               bool r = reads, w = writes;
+               statements(branch.second, r, w);
+            }
+         }
+         else if(holds_alternative<recursive_wrapper<switch_>>(stmt)) {
+            switch_ & sw = get<recursive_wrapper<switch_>>(stmt).get();
+            for(auto & c : sw.cases) {
+               bool r = reads, w = writes;
+               statements(c.second, r, w);
+            }
+            bool r = reads, w = writes;
+            statements(sw.default_case, r, w);
+         }
+
+         EffectsVisitor fx{};
+         visit(fx, stmt);
+         reads = reads && std::find(fx.callees.begin(), fx.callees.end(), std::string_view{noc_reads.release}) == fx.callees.end();
+         writes = writes && std::find(fx.callees.begin(), fx.callees.end(), std::string_view{noc_writes.release}) == fx.callees.end();
+
+         rebuilt.push_back(std::move(stmt));
+         if(flush) {
+            rebuilt.push_back(std::move(*flush));
+         }
+      }
+
+      stmts.swap(rebuilt);
+   }
+
+   std::optional<statement> coalesce(std::vector<statement> & scope, EffectsVisitor & loop, std::vector<statement> & body,
+      bool const reads, bool const writes) {
+
+      dataflow_loop m{};
+      if(!dataflow_loop::match(scope, loop, body, m) || !((m.xfer == &noc_reads) ? reads : writes)) { return std::nullopt; }
+
+      std::size_t depth = config.depth;
+      while(1UL < depth && (config.cb_pages < depth * m.pages || config.cb_pages % (depth * m.pages) != 0UL)) {
+         --depth;
+      }
+
+      if(depth < 2UL) { return std::nullopt; }
+
+      expression_data & batch = ctx.template instance<scalar<u32>>(fmt::format("noc_batch{}", loops++));
+      const std::uint32_t k = static_cast<std::uint32_t>(depth);
+
+      function_call const& acq = m.call_at(body, m.acquire);
+      function_call const& iss = m.call_at(body, m.issue);
+      function_call const& rel = m.call_at(body, m.issue + 2UL);
+
+      statement flush{if_(batch > 0U, {
+         statement{body[m.issue + 1UL]},
+         dataflow_loop::with_argument(rel, 1UL, dataflow_loop::operand(*m.n) * batch)
+      })};
+
+      std::vector<statement> rebuilt;
+      rebuilt.reserve(body.size());
+
+      for(std::size_t i = 0; i < body.size(); ++i) {
+         if(i == m.acquire) {
+            rebuilt.push_back(dataflow_loop::with_argument(acq, 1UL, _(batch + 1U) * dataflow_loop::operand(*m.n)));
+         }
+         else if(i == m.issue) {
+            rebuilt.push_back(dataflow_loop::with_argument(iss, m.xfer->l1_arg,
+               _(dataflow_loop::operand(*m.l1) + batch * dataflow_loop::operand(*m.bytes))));
+            rebuilt.push_back(batch = batch + 1U);
+            rebuilt.push_back(if_(batch == k, {
+               statement{body[m.issue + 1UL]},
+               dataflow_loop::with_argument(rel, 1UL, dataflow_loop::operand(*m.n) * k),
+               batch = 0U
+            }));
+            i += 2UL;
+         }
+         else {
+            rebuilt.push_back(std::move(body[i]));
+         }
+      }
+
+      scope.push_back(decl(batch) = 0U);
+      body.swap(rebuilt);
+      return flush;
+   }
+};
+
+// runs CoalesceVisitor over statements; returns the number of
+// loops whose barriers now wait on a batch of issues. counters
+// are declared in ctx as noc_batch0, noc_batch1, ...
+//
+//    coalesce_barriers(ctx, stmts, barrier_batching{4UL, 8UL});
+//
+template<typename T>
+std::size_t coalesce_barriers(kernel_context<T> & ctx, std::vector<statement> & statements, barrier_batching const& config) {
+   CoalesceVisitor<T> coalescer{ctx, config};
+   for(auto & stmt : statements) {
+      visit(coalescer, stmt);
+   }
+   return coalescer.loops;
+}
+
+template<typename T>
+struct PipelineVisitor {
+
+   // software pipelines the first dataflow_loop for_ of
+   // kernel_main's body, while its circular buffer is still
+   // fresh (no noc_ or cb_ call has run), so that block i + 1
+   // is in flight while block i is handed over;
+   //
+   //    std::uint32_t cb_base = get_write_ptr(cb);
+   //    std::uint32_t cb_slot = 0;
+   //    init;
+   //    if(cond) {
+   //       ...; cb_reserve_back(cb, n); l1 = get_write_ptr(cb);      // prologue,
+   //       noc_async_read(src, l1, bytes); ...; incr;               // block 0
+   //       while(cond) {
+   //          ...;
+   //          cb_slot = cb_slot + 1; if(cb_slot == blocks) { cb_slot = 0; }
+   //          cb_reserve_back(cb, n * 2);                             // steady state,
+   //          noc_async_read_barrier();                               // block i - 1 landed
+   //          l1 = cb_base + cb_slot * bytes;
+   //          noc_async_read(src, l1, bytes);                         // block i issued
+   //          cb_push_back(cb, n);                                    // block i - 1 handed over
+   //          ...; incr;
+   //       }
+   //       noc_async_read_barrier(); cb_push_back(cb, n);             // epilogue
+   //    }
+   //
+   // writes mirror reads (cb_wait_front, get_read_ptr, ...). the
+   // barrier waits on every outstanding issue, so it runs before
+   // the next block is issued; block i - 1 is in flight while the
+   // loop runs its own statements and waits on the buffer
+   //
+   // a fresh buffer's pointer starts at its base and only moves by
+   // n pages, so block i lives at slot i % blocks (blocks =
+   // cb_pages / n, two or more); bytes is get_tile_size(cb) * n
+   // (see dataflow_loop::block_bytes), so cb_base + cb_slot *
+   // bytes is that slot's first page. the loop condition may
+   // make no call or assignment, and the statements around the
+   // pattern must not read the blocks, which now land one
+   // iteration early
+   //
+   // only kernel_main runs once, on fresh buffers; any other
+   // function may be called many times, or from a loop, with
+   // the pointer anywhere, so its body is left alone
+   //
+
+   kernel_context<T> & ctx;
+   std::size_t cb_pages;
+   std::size_t loops;
+
+   PipelineVisitor(kernel_context<T> & c, std::size_t const pages) : ctx(c), cb_pages(pages), loops(0) {}
+
+   void operator()(recursive_wrapper<function_def> & t) {
+      if(t.get().fdecl.ident == kernel_main_decl.ident) {
+         statements(t.get().statements);
+      }
+   }
+
+   template<typename U>
+   void operator()(U &) {
+   }
+
+   void statements(std::vector<statement> & stmts) {
+      std::vector<statement> rebuilt;
+      rebuilt.reserve(stmts.size() + 3UL);
+
+      bool fresh = true;
+
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+
+         if(fresh && holds_alternative<recursive_wrapper<for_>>(stmt)) {
+            for_ & loop = get<recursive_wrapper<for_>>(stmt).get();
+
+            EffectsVisitor header{}, cond{};
+            header(loop.init_expr);
+            header(loop.cond_expr);
+            header(loop.incr_expr);
+            cond(loop.cond_expr);
+
+            dataflow_loop m{};
+            if(cond.calls == 0 && cond.assigned.empty() && dataflow_loop::match(rebuilt, header, loop.statements, m) &&
+               cb_pages % m.pages == 0UL && 2UL <= cb_pages / m.pages) {
+               pipeline(rebuilt, loop, m);
+               fresh = false;
+               continue;
+            }
+         }
+
+         EffectsVisitor fx{};
+         visit(fx, stmt);
+         fresh = fresh && std::none_of(fx.callees.begin(), fx.callees.end(), [](std::string_view const ident) {
+            return ident.rfind("noc_", 0) == 0 || ident.rfind("cb_", 0) == 0;
+         });
+
+         rebuilt.push_back(std::move(stmt));
+      }
+
+      stmts.swap(rebuilt);
+   }
+
+private:
+
+   void pipeline(std::vector<statement> & scope, for_ & loop, dataflow_loop const& m) {
+      std::vector<statement> & body = loop.statements;
+
+      expression_data & base = ctx.template instance<scalar<u32>>(fmt::format("cb_base{}", loops));
+      expression_data & slot = ctx.template instance<scalar<u32>>(fmt::format("cb_slot{}", loops));
+      ++loops;
+
+      const std::uint32_t blocks = static_cast<std::uint32_t>(cb_pages / m.pages);
+      const expression_data address = base + slot * dataflow_loop::operand(*m.bytes);
+
+      const std::size_t post = m.issue + 3UL;
+      statement const& barrier = body[m.issue + 1UL];
+      function_call const& acq = m.call_at(body, m.acquire);
+      function_call const& iss = m.call_at(body, m.issue);
+      function_call const& rel = m.call_at(body, m.issue + 2UL);
+
+      expression_data const pointer = (m.pointer < body.size()) ?
+         get<assign_op>(get<expression_data>(body[m.pointer]).node).args.second.get() : *m.l1;
+
+      std::vector<statement> prologue;
+      prologue.reserve(body.size());
+      for(std::size_t i = 0; i < body.size(); ++i) {
+         if(i <= m.issue || post <= i) { prologue.push_back(body[i]); }
+      }
+      if(!holds_alternative<monostate>(loop.incr_expr.node)) {
+         prologue.push_back(loop.incr_expr);
+      }
+
+      std::vector<statement> steady;
+      steady.reserve(body.size() + 3UL);
+      for(std::size_t i = 0; i < body.size(); ++i) {
+         if(i == m.acquire) {
+            steady.push_back(slot = slot + 1U);
+            steady.push_back(if_(slot == blocks, { slot = 0U }));
+            steady.push_back(dataflow_loop::with_argument(acq, 1UL, dataflow_loop::operand(*m.n) * 2U));
+            steady.push_back(barrier);
+         }
+         else if(i == m.pointer) {
+            steady.push_back(get<assign_op>(get<expression_data>(body[i]).node).args.first.get() = expression_data{address});
+         }
+         else if(i == m.issue) {
+            steady.push_back((m.pointer < body.size()) ? expression_data{get<expression_data>(body[i])} :
+               dataflow_loop::with_argument(iss, m.xfer->l1_arg, _(expression_data{address})));
+            steady.push_back(body[m.issue + 2UL]);
+            i += 2UL;
+         }
+         else {
+            steady.push_back(body[i]);
+         }
+      }
+
+      if(!holds_alternative<monostate>(loop.incr_expr.node)) {
+         steady.push_back(loop.incr_expr);
+      }
+
+      while_ steady_state{loop.cond_expr, {}};
+      steady_state.statements.swap(steady);
+
+      prologue.push_back(std::move(steady_state));
+      prologue.push_back(barrier);
+      prologue.push_back(dataflow_loop::with_argument(rel, 1UL, expression_data{*m.n}));
+
+      if_ guarded{loop.cond_expr, {}};
+      guarded.statements.front().second.swap(prologue);
+
+      scope.push_back(decl(base) = expression_data{pointer});
+      scope.push_back(decl(slot) = 0U);
+      if(!holds_alternative<monostate>(loop.init_expr.node)) {
+         scope.push_back(loop.init_expr);
+      }
+      scope.push_back(std::move(guarded));
+   }
+};
+
+// runs PipelineVisitor over statements, for circular buffers of
+// cb_pages pages; returns the number of loops pipelined. base
+// and slot variables are declared in ctx as cb_base0, cb_slot0,
+// ...
+//
+//    pipeline_loops(ctx, stmts, 4UL);
+//
+template<typename T>
+std::size_t pipeline_loops(kernel_context<T> & ctx, std::vector<statement> & statements, std::size_t const cb_pages) {
+   PipelineVisitor<T> pipeliner{ctx, cb_pages};
+   for(auto & stmt : statements) {
+      visit(pipeliner, stmt);
+   }
+   return pipeliner.loops;
+}
+
+struct SubstituteVisitor {
+
+   // replaces every read of one variable in a statement tree
+   // with an expression; declarations are left alone, they
+   // refer to the variable's storage
+   //
+
+   std::uint32_t id;
+   expression_data const& value;
+
+   SubstituteVisitor(std::uint32_t const i, expression_data const& v) : id(i), value(v) {}
+
+   void statements(std::vector<statement> & stmts) {
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+      }
+   }
+
+   void operator()(expression_data & e) {
+      if(holds_alternative<variable_type>(e.node) && EffectsVisitor::identity(get<variable_type>(e.node)) == id) {
+         expression_type node{value.node};
+         visit([&e](auto & alt) {
+            using T = typename std::decay<decltype(alt)>::type;
+            e.node.template emplace<T>(std::move(alt));
+         }, node);
+         return;
+      }
+
+      visit(*this, e.node);
+   }
+
+   template<typename T>
+   void operator()(T & t) {
+      if constexpr(is_binary_op_type<T>::type::value) {
+         (*this)(t.args.first.get());
+         (*this)(t.args.second.get());
+      }
+      else if constexpr(is_unary_op_type<T>::type::value) {
+         (*this)(t.node.get());
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<function_call>>::value) {
+         statements(t.get().arguments);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<for_>>::value) {
+         (*this)(t.get().init_expr);
+         (*this)(t.get().cond_expr);
+         (*this)(t.get().incr_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<while_>>::value) {
+         (*this)(t.get().cond_expr);
+         statements(t.get().statements);
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<if_>>::value) {
+         for(auto & branch : t.get().statements) {
+            (*this)(branch.first);
+            statements(branch.second);
+         }
+      }
+      else if constexpr(std::is_same<T, recursive_wrapper<switch_>>::value) {
+         (*this)(t.get().variable);
+         for(auto & c : t.get().cases) {
+            (*this)(c.first);
+            statements(c.second);
+         }
+         statements(t.get().default_case);
+      }
+   }
+};
+
+// full unrolls (unroll_full, or a factor of at least the trip
+// count) are limited to loops of this many iterations
+//
+using max_unrolled_trips = std::integral_constant<std::size_t, 64UL>;
+
+struct UnrollVisitor {
+
+   // unrolls for_ loops annotated with unroll(N) or unroll_full()
+   // whose header is an induction, innermost loops first
+   //
+   // with N at least the trip count the loop becomes a copy of
+   // its body per iteration, i replaced by its literal value,
+   // followed by `i = exit` when i outlives the loop. otherwise
+   // the loop steps N * d, copy k of the body reads i + k * d,
+   // and a remainder loop runs the trips N does not divide
+   //
+   //    for(i = 0; i < 10; i = i + 1) { f(i); }         .unroll(4)
+   //
+   //    for(i = 0; i < 8; i = i + 4) { f(i); f(( i + 1 )); f(( i + 2 )); f(( i + 3 )); }
+   //    for(i = 8; i < 10; i = i + 1) { f(i); }
+   //
+   // loops whose body writes i, or declares a variable outside a
+   // nested block (copies would redeclare it), are left alone
+   //
+
+   std::size_t loops;
+
+   UnrollVisitor() : loops(0) {}
+
+   void statements(std::vector<statement> & stmts) {
+      for(auto & stmt : stmts) {
+         visit(*this, stmt);
+      }
+
+      std::vector<statement> rebuilt;
+      rebuilt.reserve(stmts.size());
+
+      for(auto & stmt : stmts) {
+         if(holds_alternative<recursive_wrapper<for_>>(stmt) &&
+            unroll(get<recursive_wrapper<for_>>(stmt).get(), rebuilt)) {
+            ++loops;
+            continue;
+         }
+
+         rebuilt.push_back(std::move(stmt));
+      }
+
+      stmts.swap(rebuilt);
+   }
+
+   void operator()(recursive_wrapper<for_> & t) {
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<while_> & t) {
+      statements(t.get().statements);
+   }
+
+   void operator()(recursive_wrapper<if_> & t) {
+      for(auto & branch : t.get().statements) {
+         statements(branch.second);
+      }
+   }
+
+   void operator()(recursive_wrapper<switch_> & t) {
+      for(auto & c : t.get().cases) {
+         statements(c.second);
+      }
+      statements(t.get().default_case);
+   }
+
+   void operator()(recursive_wrapper<function_def> & t) {
+      statements(t.get().statements);
+   }
+
+   template<typename T>
+   void operator()(T &) {
+   }
+
+private:
+
+   static bool declares(statement const& stmt) {
+      if(!holds_alternative<expression_data>(stmt)) { return false; }
+
+      expression_type const& node = get<expression_data>(stmt).node;
+      return holds_alternative<decl_expr>(node) ||
+         (holds_alternative<assign_op>(node) && holds_alternative<decl_expr>(get<assign_op>(node).args.first.get().node));
+   }
+
+   static void append_copy(std::vector<statement> const& body, std::uint32_t const id, expression_data const& value,
+      std::vector<statement> & out) {
+
+      std::vector<statement> copy{body};
+      SubstituteVisitor{id, value}.statements(copy);
+      for(auto & stmt : copy) {
+         out.push_back(std::move(stmt));
+      }
+   }
+
+   bool unroll(for_ & loop, std::vector<statement> & out) {
+      induction ind{};
+      if(loop.unroll_factor < 2UL || !induction::of(loop, ind)) { return false; }
+
+      EffectsVisitor fx{};
+      fx.statements(loop.statements);
+      if(fx.writes_any({ind.id}) || std::any_of(loop.statements.begin(), loop.statements.end(), declares)) {
+         return false;
+      }
+
+      const std::uint64_t trips = static_cast<std::uint64_t>(ind.trips);
+      if(trips <= loop.unroll_factor && max_unrolled_trips::value < trips) { return false; }
+
+      if(trips <= loop.unroll_factor) {
+         for(std::int64_t k = 0; k < ind.trips; ++k) {
+            append_copy(loop.statements, ind.id, ind.constant(ind.at(k)), out);
+         }
+
+         if(ind.storage == nullptr) {
+            expression_data x{ind.var};
+            out.push_back(x = ind.constant(ind.at(ind.trips)));
+         }
+
+         return true;
+      }
+
+      const std::int64_t factor = static_cast<std::int64_t>(loop.unroll_factor);
+      const std::int64_t main_end = ind.at((ind.trips / factor) * factor);
+
+      std::vector<statement> unrolled;
+      unrolled.reserve(loop.statements.size() * loop.unroll_factor);
+      for(auto const& stmt : loop.statements) {
+         unrolled.push_back(stmt);
+      }
+      for(std::int64_t k = 1; k < factor; ++k) {
+         append_copy(loop.statements, ind.id, ind.offset(k), unrolled);
+      }
+
+      expression_data x{ind.var};
+      expression_data cond = (0 < ind.step) ? x < ind.constant(main_end) : x > ind.constant(main_end);
+      expression_data stride = (0 < ind.step) ? x + ind.constant(factor * ind.step) : x - ind.constant(-factor * ind.step);
+
+      out.push_back(for_(loop.init_expr, std::move(cond), x = std::move(stride), std::move(unrolled)));
+
+      if(main_end != ind.at(ind.trips)) {
+         expression_data init = (ind.storage != nullptr) ?
+            (decl(*ind.storage) = ind.constant(main_end)) : (x = ind.constant(main_end));
+         out.push_back(for_(std::move(init), loop.cond_expr, loop.incr_expr, std::move(loop.statements)));
+      }
+
+      return true;
+   }
+};
+
+// runs UnrollVisitor over statements; returns the number of
+// loops unrolled
+//
+inline std::size_t unroll_loops(std::vector<statement> & statements) {
+   UnrollVisitor unroller{};
+   unroller.statements(statements);
+   return unroller.loops;
+}
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
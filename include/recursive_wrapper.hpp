@@ -9,6 +9,7 @@
 #define MPARK_UTIL_VARIANT_HPP
 
 #include "variant.hpp"
+#include <new>
 #include <utility>
 
 namespace mpark { namespace util
@@ -21,6 +22,23 @@ namespace mpark { namespace util
     using mpark::get_if;
     using mpark::visit;
 
+    ///////////////////////////////////////////////////////////////////////////
+    // storage for recursive_wrapper nodes; when no resource is installed on
+    // the calling thread nodes are allocated with new/delete
+    struct node_resource
+    {
+        virtual ~node_resource() {}
+
+        virtual void* allocate(std::size_t bytes, std::size_t align) = 0;
+        virtual void deallocate(void* p, std::size_t bytes, std::size_t align) = 0;
+    };
+
+    inline node_resource*& current_node_resource()
+    {
+        static thread_local node_resource* resource = nullptr;
+        return resource;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // class template recursive_wrapper
     template <typename T>
@@ -30,37 +48,71 @@ namespace mpark { namespace util
         using type = T;
 
     private:    // representation
+        node_resource* r_;
         T* p_;
 
+        template <typename... Args>
+        T* construct(Args&&... args)
+        {
+            if (r_ == nullptr)
+            {
+                return new T(std::forward<Args>(args)...);
+            }
+
+            void* mem = r_->allocate(sizeof(T), alignof(T));
+            try
+            {
+                return ::new (mem) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                r_->deallocate(mem, sizeof(T), alignof(T));
+                throw;
+            }
+        }
+
+        void destroy()
+        {
+            if (r_ == nullptr)
+            {
+                delete p_;
+            }
+            else if (p_ != nullptr)
+            {
+                p_->~T();
+                r_->deallocate(p_, sizeof(T), alignof(T));
+            }
+        }
+
     public:
         ~recursive_wrapper()
         {
-            delete p_;
+            destroy();
         }
 
         recursive_wrapper()
-          : p_(new T)
+          : r_(current_node_resource()), p_(construct())
         {
         }
 
         recursive_wrapper(recursive_wrapper const& operand)
-          : p_(new T(operand.get()))
+          : r_(current_node_resource()), p_(construct(operand.get()))
         {
         }
 
         recursive_wrapper(T const& operand)
-          : p_(new T(operand))
+          : r_(current_node_resource()), p_(construct(operand))
         {
         }
 
         recursive_wrapper(recursive_wrapper && operand) noexcept
-          : p_(operand.p_)
+          : r_(operand.r_), p_(operand.p_)
         {
             operand.p_ = nullptr;
         }
 
         recursive_wrapper(T && operand)
-          : p_(new T(std::move(operand)))
+          : r_(current_node_resource()), p_(construct(std::move(operand)))
         {
         }
 
@@ -98,6 +150,10 @@ namespace mpark { namespace util
             T* temp = operand.p_;
             operand.p_ = p_;
             p_ = temp;
+
+            node_resource* temp_r = operand.r_;
+            operand.r_ = r_;
+            r_ = temp_r;
         }
 
     public:    // queries
@@ -0,0 +1,431 @@
+/*
+* Copyright(c)	2024 Christopher Taylor
+
+* SPDX-License-Identifier: BSL-1.0
+* Distributed under the Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#pragma once
+#ifndef __TT_EDSL_SYMBOL_HPP__
+#define __TT_EDSL_SYMBOL_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace tt { namespace dsl {
+
+struct symbol_pool {
+
+   // process wide identifier pool
+   //
+   // every distinct identifier is stored once and given a small
+   // integer id; lookups go through an open addressing table
+   // (linear probing, power of two capacity) under a shared
+   // lock, so threads interning identifiers already in the pool
+   // do not wait on each other. only a new identifier takes the
+   // lock exclusively
+   //
+   // entries count the symbols referring to them. an entry no
+   // symbol refers to is dead; interning its identifier again
+   // revives it, and collect() frees dead entries and recycles
+   // their ids. intern collects on its own once dead entries
+   // outnumber live ones
+   //
+   // ids are process wide rather than per kernel_context: the
+   // passes in optimize.hpp and lower() in ir.hpp compare ids
+   // across trees that mix a context's variables with the
+   // api.hpp globals (NOC0, ...), which per context ids would
+   // let collide. each kernel_context keeps a symbol_table in
+   // front of the pool, so an identifier it has seen before
+   // never reaches the pool's lock
+   //
+
+   using initial_slots = std::integral_constant<std::size_t, 1024UL>;
+   using min_collect = std::integral_constant<std::size_t, 1024UL>;
+
+   struct entry {
+      std::atomic<std::uint32_t> refs;
+      std::uint32_t id;
+      std::uint64_t hash;
+      std::string text;
+
+      entry(std::uint32_t const i, std::uint64_t const h, std::string_view const s) : refs(1U), id(i), hash(h), text(s) {}
+   };
+
+   std::shared_mutex lock;
+   std::vector< std::unique_ptr<entry> > entries;    // by id; id 0, the empty identifier, has no entry
+   std::vector<std::uint32_t> free_ids;
+   std::vector<std::uint32_t> slots;
+   std::atomic<std::size_t> dead;                     // entries released since the last collect, an upper bound
+
+   symbol_pool() :
+      lock(), entries(1UL), free_ids(), slots(initial_slots::value, 0U), dead(0UL) {
+   }
+
+   symbol_pool(symbol_pool const&) = delete;
+   symbol_pool & operator=(symbol_pool const&) = delete;
+
+   // fnv-1a
+   //
+   static std::uint64_t hash_of(std::string_view const s) {
+      std::uint64_t h = 14695981039346656037ULL;
+      for(char const c : s) {
+         h ^= static_cast<unsigned char>(c);
+         h *= 1099511628211ULL;
+      }
+      return h;
+   }
+
+   // the entry for s with one more reference
+   //
+   entry * intern(std::string_view const s) {
+      const std::uint64_t h = hash_of(s);
+
+      {
+         std::shared_lock<std::shared_mutex> guard{lock};
+         entry * e = find(s, h);
+         if(e != nullptr && acquire(*e)) { return e; }
+      }
+
+      std::unique_lock<std::shared_mutex> guard{lock};
+
+      // readers are locked out and no symbol refers to a dead
+      // entry, so nothing else can revive or free it here
+      //
+      entry * e = find(s, h);
+      if(e != nullptr) {
+         e->refs.fetch_add(1U, std::memory_order_relaxed);
+         return e;
+      }
+
+      if(min_collect::value <= dead.load(std::memory_order_relaxed) && live() < dead.load(std::memory_order_relaxed) * 2UL) {
+         collect_locked();
+      }
+
+      std::uint32_t id = static_cast<std::uint32_t>(entries.size());
+      if(free_ids.empty()) {
+         entries.emplace_back();
+      }
+      else {
+         id = free_ids.back();
+         free_ids.pop_back();
+      }
+
+      entries[id].reset(new entry{id, h, s});
+
+      if(slots.size() <= live() * 2UL) {
+         rebuild(slots.size() * 2UL);
+      }
+      else {
+         insert_slot(id);
+      }
+
+      return entries[id].get();
+   }
+
+   void release(entry & e) {
+      if(e.refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+         dead.fetch_add(1UL, std::memory_order_relaxed);
+      }
+   }
+
+   // frees every dead entry; returns the number freed
+   //
+   std::size_t collect() {
+      std::unique_lock<std::shared_mutex> guard{lock};
+      return collect_locked();
+   }
+
+   // identifiers held, live or dead but not yet collected
+   //
+   std::size_t size() {
+      std::shared_lock<std::shared_mutex> guard{lock};
+      return live();
+   }
+
+private:
+
+   static bool acquire(entry & e) {
+      std::uint32_t refs = e.refs.load(std::memory_order_relaxed);
+      while(refs != 0U && !e.refs.compare_exchange_weak(refs, refs + 1U, std::memory_order_relaxed)) {
+      }
+      return refs != 0U;
+   }
+
+   std::size_t live() const {
+      return entries.size() - 1UL - free_ids.size();
+   }
+
+   entry * find(std::string_view const s, std::uint64_t const h) const {
+      const std::size_t mask = slots.size() - 1UL;
+      for(std::size_t i = static_cast<std::size_t>(h) & mask;; i = (i + 1UL) & mask) {
+         const std::uint32_t slot = slots[i];
+         if(slot == 0U) { return nullptr; }
+
+         entry * e = entries[slot - 1U].get();
+         if(e->hash == h && std::string_view{e->text} == s) { return e; }
+      }
+   }
+
+   std::size_t collect_locked() {
+      std::size_t freed = 0;
+      for(std::uint32_t id = 1; id < entries.size(); ++id) {
+         if(entries[id] && entries[id]->refs.load(std::memory_order_acquire) == 0U) {
+            entries[id].reset();
+            free_ids.push_back(id);
+            ++freed;
+         }
+      }
+
+      dead.store(0UL, std::memory_order_relaxed);
+
+      if(freed != 0UL) {
+         rebuild(slots.size());
+      }
+
+      return freed;
+   }
+
+   void insert_slot(std::uint32_t const id) {
+      const std::size_t mask = slots.size() - 1UL;
+      std::size_t i = static_cast<std::size_t>(entries[id]->hash) & mask;
+      while(slots[i] != 0U) {
+         i = (i + 1UL) & mask;
+      }
+      slots[i] = id + 1U;
+   }
+
+   void rebuild(std::size_t const size) {
+      slots.assign(size, 0U);
+      for(std::uint32_t id = 1; id < entries.size(); ++id) {
+         if(entries[id]) {
+            insert_slot(id);
+         }
+      }
+   }
+};
+
+inline symbol_pool & global_symbol_pool() {
+   static symbol_pool pool;
+   return pool;
+}
+
+struct symbol {
+
+   // interned identifier; one pointer, copies never allocate.
+   // a symbol holds a reference to its pool entry, so entries
+   // stay valid while any symbol refers to them
+   //
+
+   symbol_pool::entry * ref;
+
+   symbol() : ref(nullptr) {}
+
+   symbol(std::string_view const s) : ref(s.empty() ? nullptr : global_symbol_pool().intern(s)) {}
+
+   symbol(std::string const& s) : symbol(std::string_view{s}) {}
+
+   symbol(char const* s) : symbol(std::string_view{s}) {}
+
+   symbol(symbol const& other) : ref(other.ref) {
+      if(ref != nullptr) {
+         ref->refs.fetch_add(1U, std::memory_order_relaxed);
+      }
+   }
+
+   symbol(symbol && other) noexcept : ref(other.ref) {
+      other.ref = nullptr;
+   }
+
+   symbol & operator=(symbol const& other) {
+      symbol copy{other};
+      std::swap(ref, copy.ref);
+      return *this;
+   }
+
+   symbol & operator=(symbol && other) noexcept {
+      std::swap(ref, other.ref);
+      return *this;
+   }
+
+   ~symbol() {
+      if(ref != nullptr) {
+         global_symbol_pool().release(*ref);
+      }
+   }
+
+   // 0 is the empty identifier; ids of freed entries are reused,
+   // never while a symbol refers to the entry
+   //
+   std::uint32_t id() const { return (ref == nullptr) ? 0U : ref->id; }
+
+   std::string_view view() const { return (ref == nullptr) ? std::string_view{} : std::string_view{ref->text}; }
+
+   operator std::string_view() const { return view(); }
+
+   bool empty() const { return ref == nullptr; }
+
+   friend bool operator==(symbol const& lhs, symbol const& rhs) { return lhs.ref == rhs.ref; }
+   friend bool operator!=(symbol const& lhs, symbol const& rhs) { return lhs.ref != rhs.ref; }
+};
+
+static_assert(sizeof(symbol) == sizeof(void*), "symbol is expected to be one pointer");
+
+struct symbol_table {
+
+   // a kernel_context's identifiers, in front of the process
+   // wide pool; an identifier interned here before is found
+   // without hashing into or locking the pool. a context is
+   // used by one thread at a time, so the table takes no lock
+   //
+
+   using initial_slots = std::integral_constant<std::size_t, 64UL>;
+
+   std::vector<symbol> symbols;
+   std::vector<std::uint64_t> hashes;
+   std::vector<std::uint32_t> slots;                  // index into symbols + 1
+
+   symbol_table() : symbols(), hashes(), slots(initial_slots::value, 0U) {}
+
+   symbol intern(std::string_view const s) {
+      if(s.empty()) { return symbol{}; }
+
+      const std::uint64_t h = symbol_pool::hash_of(s);
+      const std::size_t mask = slots.size() - 1UL;
+
+      for(std::size_t i = static_cast<std::size_t>(h) & mask;; i = (i + 1UL) & mask) {
+         const std::uint32_t slot = slots[i];
+         if(slot == 0U) { break; }
+         if(hashes[slot - 1U] == h && symbols[slot - 1U].view() == s) { return symbols[slot - 1U]; }
+      }
+
+      symbols.emplace_back(s);
+      hashes.push_back(h);
+
+      if(slots.size() <= symbols.size() * 2UL) {
+         slots.assign(slots.size() * 2UL, 0U);
+         for(std::uint32_t idx = 0; idx < symbols.size(); ++idx) {
+            insert_slot(idx);
+         }
+      }
+      else {
+         insert_slot(static_cast<std::uint32_t>(symbols.size() - 1UL));
+      }
+
+      return symbols.back();
+   }
+
+   std::size_t size() const { return symbols.size(); }
+
+private:
+
+   void insert_slot(std::uint32_t const idx) {
+      const std::size_t mask = slots.size() - 1UL;
+      std::size_t i = static_cast<std::size_t>(hashes[idx]) & mask;
+      while(slots[i] != 0U) {
+         i = (i + 1UL) & mask;
+      }
+      slots[i] = idx + 1U;
+   }
+};
+
+template<typename T>
+struct symbol_map {
+
+   // open addressing map keyed by symbol id; values live in a
+   // deque so references handed out stay valid as it grows
+   //
+
+   using initial_slots = std::integral_constant<std::size_t, 64UL>;
+
+   std::deque< std::pair<symbol, T> > values;
+   std::vector<std::uint32_t> slots;
+
+   symbol_map() : values(), slots(initial_slots::value, 0U) {}
+
+   symbol_map(symbol_map const& other) : values(other.values), slots(other.slots) {}
+
+   symbol_map & operator=(symbol_map const&) = delete;
+
+   // fibonacci hashing spreads the dense ids across the table
+   //
+   static std::size_t hash_of(std::uint32_t const id) {
+      return static_cast<std::size_t>((static_cast<std::uint64_t>(id) * 11400714819323198485ULL) >> 32U);
+   }
+
+   T * find(symbol const& s) {
+      const std::size_t mask = slots.size() - 1UL;
+      for(std::size_t i = hash_of(s.id()) & mask;; i = (i + 1UL) & mask) {
+         const std::uint32_t slot = slots[i];
+         if(slot == 0U) { return nullptr; }
+         if(values[slot - 1U].first.id() == s.id()) { return &values[slot - 1U].second; }
+      }
+   }
+
+   // returns the existing value when s is already present
+   //
+   template<typename... Args>
+   std::pair<T *, bool> try_emplace(symbol const& s, Args &&... args) {
+      T * found = find(s);
+      if(found != nullptr) {
+         return {found, false};
+      }
+
+      values.emplace_back(std::piecewise_construct, std::forward_as_tuple(s), std::forward_as_tuple(std::forward<Args>(args)...));
+
+      if(slots.size() <= values.size() * 2UL) {
+         slots.assign(slots.size() * 2UL, 0U);
+         for(std::uint32_t idx = 0; idx < values.size(); ++idx) {
+            insert_slot(idx);
+         }
+      }
+      else {
+         insert_slot(static_cast<std::uint32_t>(values.size() - 1UL));
+      }
+
+      return {&values.back().second, true};
+   }
+
+   std::size_t size() const { return values.size(); }
+
+   auto begin() { return values.begin(); }
+   auto end() { return values.end(); }
+   auto begin() const { return values.begin(); }
+   auto end() const { return values.end(); }
+
+private:
+
+   void insert_slot(std::uint32_t const idx) {
+      const std::size_t mask = slots.size() - 1UL;
+      std::size_t i = hash_of(values[idx].first.id()) & mask;
+      while(slots[i] != 0U) {
+         i = (i + 1UL) & mask;
+      }
+      slots[i] = idx + 1U;
+   }
+};
+
+} /* namespace dsl */ } // namespace tt
+
+template<>
+struct fmt::formatter<tt::dsl::symbol> : fmt::formatter<fmt::string_view> {
+   template<typename FormatContext>
+   auto format(tt::dsl::symbol const& s, FormatContext & ctx) const {
+      return fmt::formatter<fmt::string_view>::format(fmt::string_view{s.view().data(), s.view().size()}, ctx);
+   }
+};
+
+#endif
@@ -11,6 +11,9 @@
 #define __TT_EDSL_TTMODEL_HPP__
 
 #include "dsl.hpp"
+#include "ir.hpp"
+#include "generate.hpp"
+#include "optimize.hpp"
 
 using namespace tt::dsl;
 
@@ -28,9 +31,34 @@ using namespace tt::api::kernel::compute;
 
 #define host_location() std::string{__FILE__}
 
-#if defined(ENABLE_BERKELEY_DB_SUPPORT)
+// the kernel cache is opt-in; define ENABLE_KERNEL_CACHE for
+// the flat file backend or ENABLE_BERKELEY_DB_SUPPORT for the
+// berkeleydb backend
+//
+#if defined(ENABLE_KERNEL_CACHE) || defined(ENABLE_BERKELEY_DB_SUPPORT)
 
 #include "cache.hpp"
+#include "cache_file.hpp"
+
+#if defined(ENABLE_BERKELEY_DB_SUPPORT)
+
+#include "cache_bdb.hpp"
+
+namespace tt { namespace dsl {
+
+using kernel_cache = basic_kernel_cache<berkeleydb_backend>;
+
+} /* namespace dsl */ } // namespace tt
+
+#else
+
+namespace tt { namespace dsl {
+
+using kernel_cache = basic_kernel_cache<flat_file_backend>;
+
+} /* namespace dsl */ } // namespace tt
+
+#endif
 
 #endif
 